@@ -0,0 +1,179 @@
+# include "../src/fsm_practical.h"
+
+/* The landing gear control system as a machine for the fsm engine: every
+ * state's outputs and messages, and the actions and guards the machine runs.
+ * Its states, waits and transitions are described in craft.fsm, which the
+ * build compiles into craft_machine.c (see fsm_gen/fsm_gen.c), so the
+ * behaviour of the aircraft is all data and the engine is the only code
+ * that runs it.
+ *
+ * GROUND: when the aircraft is grounded (wheels are on tarmac) the hydraulic
+ * system of the craft monitors the pressure exerted on landing gear clusters
+ * of the aircraft and appropriately counterbalances it by applying pressure in
+ * the opposite direction. Once the aircraft is prepped for takeoff there is
+ * also a fail-safe system in case of pilot lever failure: gas-pressurised
+ * springs are primed to deploy the landing gear if the pilot's lever is
+ * inoperative. The state waits for as long as it takes for the pilot to
+ * confirm the start of the simulation; any other answer ends it.
+ *
+ * TAKEOFF: 2 scenarios can occur: either the pilots really do intend to take
+ * off or the aircraft has bumped over something on the tarmac during
+ * relatively slow-speed movement. This is achieved by the hydraulic system
+ * monitoring the rising or falling edge of the pilot's lever as well as input
+ * from the landing gear's squat switch. To ensure that one situation prevails
+ * over the other, the squat switch and pilot's lever are monitored for 5
+ * seconds to ensure that takeoff is assured before committing to retracting
+ * the landing gear (practically, signals may also be received and combined
+ * from the craft's speedometer and altimeter.) If there is input within the 5
+ * seconds, the pilot's lever or squat switch have been triggered again and the
+ * takeoff is aborted without retracting the landing gear. For simulation
+ * purposes, stdin input is the trigger detector for the squat switch.
+ *
+ * ASCEND: after the wheels are off the ground and during the ascension phase
+ * of flight, the pilots can engage an emergency landing sequence, in which
+ * case the landing gear has to be redeployed for a descent. If this is not the
+ * case, the landing gear can be fully retracted before the aircraft enters
+ * cruise.
+ *
+ * CRUISE: by this point the landing gear is fully retracted, cockpit landing
+ * lights are off and the controls for the landing gear cluster are disabled to
+ * save power. The next state is the descent phase, which the state waits for
+ * pilot input to begin for as long as it takes (it has no timeout.)
+ *
+ * DESCEND: the controls for the landing gear are enabled and the pilots intend
+ * to land the aircraft. Descent doesn't listen to input: it simply lasts
+ * SNOOZE seconds, timed by the event loop rather than by sleep().
+ *
+ * LANDING: the pilots can either commit to the landing or decide to abort and
+ * ascend again. If the pilot's lever is lifted again during the landing check,
+ * the aircraft switches to the takeoff state to ensure that it is safe to
+ * begin retracting landing gear again (given the state of the squat switch and
+ * pilot's lever.) If there was no interruption, the mechanical systems extend
+ * the landing gear and prepare for touchdown.
+ */
+
+_Static_assert(sizeof(aircraft) == 1, "the aircraft bitfield must fit a byte");
+
+/* The controls every state drives when it is entered, and what it drives them
+ * to. A control a state doesn't drive keeps whatever the states before it left
+ * it at, so both are kept as whole aircraft and applied as a single masked
+ * byte rather than one field at a time (see craft_drive()): every field of a
+ * craft_drives row is either 0, or its DRIVE_ mask with all of the field's
+ * bits set, and the fields craft_outputs sets are the ones it drives. A fleet
+ * applies them column-wise.
+ */
+const aircraft craft_drives[STATE_COUNT] =
+{
+	[STATE_GROUND]	= {DRIVE_LEVER, DRIVE_LIMIT, DRIVE_SQUAT, DRIVE_GEAR, DRIVE_LIGHTS, DRIVE_VALVE},
+	[STATE_TAKEOFF]	= {.pilot_lever = DRIVE_LEVER, .squat_switch = DRIVE_SQUAT, .cockpit_lights = DRIVE_LIGHTS},
+	[STATE_ASCEND]	= {.pilot_lever = DRIVE_LEVER, .direction_valve = DRIVE_VALVE},
+	[STATE_CRUISE]	= {.limit_switch = DRIVE_LIMIT, .landing_gear = DRIVE_GEAR, .cockpit_lights = DRIVE_LIGHTS},
+	[STATE_DESCEND]	= {.pilot_lever = DRIVE_LEVER, .cockpit_lights = DRIVE_LIGHTS},
+	[STATE_LANDING]	= {.pilot_lever = DRIVE_LEVER, .direction_valve = DRIVE_VALVE}
+};
+
+const aircraft craft_outputs[STATE_COUNT] =
+{
+	[STATE_GROUND]	= {LEV_DOWN, SW_OPEN, SW_CLOSE, GEAR_DOWN, LIT_GREEN, DVAL_DOWN},
+	[STATE_TAKEOFF]	= {.pilot_lever = LEV_RISE, .squat_switch = SW_OPEN, .cockpit_lights = LIT_RED},
+	[STATE_ASCEND]	= {.pilot_lever = LEV_UP, .direction_valve = DVAL_UP},
+	[STATE_CRUISE]	= {.limit_switch = SW_CLOSE, .landing_gear = GEAR_UP, .cockpit_lights = LIT_OFF},
+	[STATE_DESCEND]	= {.pilot_lever = LEV_FALL, .cockpit_lights = LIT_RED},
+	[STATE_LANDING]	= {.pilot_lever = LEV_DOWN, .direction_valve = DVAL_DOWN}
+};
+
+static const char *const craft_banners[STATE_COUNT] =
+{
+	[STATE_GROUND]	= "Craft grounded.\nHydraulic counter-pressure system engaged.\n",
+	[STATE_TAKEOFF]	= "Detected wheels off the ground...\n",
+	[STATE_ASCEND]	= "Craft ascending (gaining altitude)\n",
+	[STATE_CRUISE]	= "Craft cruising.\n",
+	[STATE_DESCEND]	= "Craft descending (dropping altitude)\n",
+	[STATE_LANDING]	= "Craft landing.\n"
+};
+
+static const char *const craft_prompts[STATE_COUNT] =
+{
+	[STATE_GROUND]	= "Commence simulation? [y/n] ",
+	[STATE_TAKEOFF]	= "Monitoring squat switch and pilot's lever.\n"
+					  "[5 seconds to abort takeoff (\"Enter\" aborts.)]\n",
+	[STATE_ASCEND]	= "Monitoring for emergency input.\n"
+					  "[5 seconds before cruise altitude (\"Enter\" for emergency.)]\n",
+	[STATE_CRUISE]	= "Standby for input to commence landing.\n"
+					  "[(\"Enter\" to begin landing.)]\n",
+	[STATE_DESCEND]	= "",
+	[STATE_LANDING]	= "Monitoring pilot's lever.\n"
+					  "[5 seconds to abort landing (\"Enter\" aborts.)]\n"
+};
+
+static const char *const craft_messages[STATE_COUNT][EVENT_COUNT] =
+{
+	[STATE_GROUND]	= {[EVENT_CONFIRM] = "Landing gear emergency pressure springs engaged."},
+	[STATE_TAKEOFF]	= {"Input received, aborting takeoff...", "\nTakeoff committed.",
+					   "Input received, aborting takeoff..."},
+	[STATE_ASCEND]	= {"Input received, emergency landing sequence engaged.",
+					   "\nLanding control disabled, craft entering cruise...",
+					   "Input received, emergency landing sequence engaged."},
+	[STATE_CRUISE]	= {"Landing control enabled, craft entering descent...", NULL,
+					   "Landing control enabled, craft entering descent..."},
+	[STATE_DESCEND]	= {[EVENT_TIMEOUT] = ""},
+	[STATE_LANDING]	= {"Input received, aborting landing...", "\nLanding committed, touchdown imminent.",
+					   "Input received, aborting landing..."}
+};
+
+void craft_drive(void *ctx, uint8_t state, uint8_t event)
+{
+	/* Entry action of every state in a fleet: the aircraft's controls are
+	 * driven to the state's outputs, and nothing is shown. The aircraft is
+	 * handled as the byte it is: the bits of the state's craft_drives row are
+	 * cleared and its craft_outputs row is OR-ed in, which holds as long as
+	 * every driven field's DRIVE_ mask covers all of its bits and no output
+	 * sets a bit outside them.
+	 */
+	(void)event;
+	uint8_t controls, drives, outputs;
+	memcpy(&controls, ctx, sizeof(aircraft));
+	memcpy(&drives, &craft_drives[state], sizeof(aircraft));
+	memcpy(&outputs, &craft_outputs[state], sizeof(aircraft));
+	controls = (uint8_t)((controls & ~drives) | outputs);
+	memcpy(ctx, &controls, sizeof(aircraft));
+} //end void craft_drive()
+
+void craft_enter(void *ctx, uint8_t state, uint8_t event)
+{
+	/* Entry action of every state: the aircraft's controls are driven to the
+	 * state's outputs, then its banner, the aircraft and its prompt are shown.
+	 */
+	craft_drive(ctx, state, event);
+	fputs(craft_banners[state], stdout);
+	print_state((aircraft *)ctx);
+	fputs(craft_prompts[state], stdout);
+	fflush(stdout);
+} //end void craft_enter()
+
+void craft_announce(void *ctx, uint8_t state, uint8_t event)
+{
+	/* Action of every transition: its message, ending the line the next
+	 * state's banner follows.
+	 */
+	(void)ctx;
+	puts(craft_messages[state][event]);
+} //end void craft_announce()
+
+void craft_silent(void *ctx, uint8_t state, uint8_t event)
+{
+	(void)ctx;
+	(void)state;
+	(void)event;
+} //end void craft_silent()
+
+uint8_t craft_on_ground(const void *ctx, uint8_t state, uint8_t event)
+{
+	/* The pressure springs are only primed, and the takeoff begun, with the
+	 * craft's weight on its wheels and its gear down.
+	 */
+	(void)state;
+	(void)event;
+	const aircraft *craft = ctx;
+	return (craft->squat_switch == SW_CLOSE) && (craft->landing_gear == GEAR_DOWN);
+} //end uint8_t craft_on_ground()
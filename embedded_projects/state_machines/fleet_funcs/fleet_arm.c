@@ -0,0 +1,13 @@
+# include "../src/fsm_practical.h"
+
+void fleet_arm(fleet *fl, uint32_t craft)
+{
+	/* This function arms the timeout of the state an aircraft just entered,
+	 * if it has one, as the aircraft's timer on the fleet's timing wheel.
+	 */
+	int32_t timeout = fl->machine->states[fl->states[craft]].timeout;
+	if (timeout != FOREVER)
+	{
+		wheel_insert(&fl->wheel, craft, fl->now + timeout);
+	}
+} //end void fleet_arm()
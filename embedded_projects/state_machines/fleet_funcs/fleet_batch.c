@@ -0,0 +1,59 @@
+# include "../src/fsm_practical.h"
+
+static void batch_pass(uint32_t count, uint8_t *restrict states, uint8_t *restrict due,
+	uint8_t *restrict lever, uint8_t *restrict limit, uint8_t *restrict squat,
+	uint8_t *restrict gear, uint8_t *restrict lights, uint8_t *restrict valve,
+	uint8_t from, uint8_t to, const uint8_t *drives, const uint8_t *levels)
+{
+	/* One pass over the whole fleet moving every due aircraft in state from
+	 * to state to. There are no branches: hit is 0xFF for the aircraft that
+	 * move and 0 for the others, and every byte is blended with it, so the
+	 * compiler turns the loop into vector instructions over 16 or 32
+	 * aircraft at a time. An aircraft that moved is no longer due, so the
+	 * pass for its new state leaves it alone. Every column is its own
+	 * restrict parameter, as that is what tells the compiler they never
+	 * overlap.
+	 */
+	const uint8_t lever_drive = drives[CTRL_LEVER], lever_level = levels[CTRL_LEVER] & lever_drive;
+	const uint8_t limit_drive = drives[CTRL_LIMIT], limit_level = levels[CTRL_LIMIT] & limit_drive;
+	const uint8_t squat_drive = drives[CTRL_SQUAT], squat_level = levels[CTRL_SQUAT] & squat_drive;
+	const uint8_t gear_drive = drives[CTRL_GEAR], gear_level = levels[CTRL_GEAR] & gear_drive;
+	const uint8_t lights_drive = drives[CTRL_LIGHTS], lights_level = levels[CTRL_LIGHTS] & lights_drive;
+	const uint8_t valve_drive = drives[CTRL_VALVE], valve_level = levels[CTRL_VALVE] & valve_drive;
+	for (uint32_t craft = 0; craft < count; craft++)
+	{
+		uint8_t hit = due[craft] & (uint8_t)-(states[craft] == from);
+		states[craft] = (uint8_t)((states[craft] & ~hit) | (to & hit));
+		due[craft] = (uint8_t)(due[craft] & ~hit);
+		lever[craft] = (uint8_t)((lever[craft] & ~(hit & lever_drive)) | (hit & lever_level));
+		limit[craft] = (uint8_t)((limit[craft] & ~(hit & limit_drive)) | (hit & limit_level));
+		squat[craft] = (uint8_t)((squat[craft] & ~(hit & squat_drive)) | (hit & squat_level));
+		gear[craft] = (uint8_t)((gear[craft] & ~(hit & gear_drive)) | (hit & gear_level));
+		lights[craft] = (uint8_t)((lights[craft] & ~(hit & lights_drive)) | (hit & lights_level));
+		valve[craft] = (uint8_t)((valve[craft] & ~(hit & valve_drive)) | (hit & valve_level));
+	}
+} //end void batch_pass()
+
+void fleet_batch(fleet *fl)
+{
+	/* This function applies the timeouts of every aircraft marked due, one
+	 * pass per state that has a batchable timeout: each pass moves the due
+	 * aircraft of its state to the next state and drives their controls to
+	 * its outputs, exactly what dispatching the timeouts one by one to the
+	 * fleet's machine would have done. What is left to the caller is the
+	 * bookkeeping per aircraft, counting the transitions and arming the new
+	 * states' timers. A pass streams through every column once, so with
+	 * enough aircraft due the cost is bounded by memory bandwidth rather
+	 * than by the number of transitions.
+	 */
+	for (uint8_t state = 0; state < fl->machine->n_states; state++)
+	{
+		uint8_t next = fl->batch_next[state];
+		if ((next != FSM_STAY) && (fl->machine->states[state].timeout != FOREVER))
+		{
+			batch_pass(fl->count, fl->states, fl->due, fl->controls[CTRL_LEVER], fl->controls[CTRL_LIMIT],
+				fl->controls[CTRL_SQUAT], fl->controls[CTRL_GEAR], fl->controls[CTRL_LIGHTS],
+				fl->controls[CTRL_VALVE], state, next, fl->drives[next], fl->levels[next]);
+		}
+	}
+} //end void fleet_batch()
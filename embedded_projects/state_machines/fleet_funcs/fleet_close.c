@@ -0,0 +1,14 @@
+# include "../src/fsm_practical.h"
+
+void fleet_close(fleet *fl)
+{
+	/* This function releases everything a fleet holds. It's safe on a fleet
+	 * that fleet_open() only partly set up.
+	 */
+	wheel_close(&fl->wheel);
+	free(fl->due_list);
+	free(fl->due);
+	free(fl->states);
+	free(fl->columns);
+	*fl = (fleet){0};
+} //end void fleet_close()
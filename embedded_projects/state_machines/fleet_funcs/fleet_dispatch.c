@@ -0,0 +1,39 @@
+# include "../src/fsm_practical.h"
+
+void fleet_dispatch(fleet *fl, uint32_t craft, uint8_t event)
+{
+	/* This function feeds an event to one aircraft of a fleet, gathered from
+	 * the fleet's columns for the machine to run on. Whenever the aircraft
+	 * moves, the timer of the state it left is cancelled and the timer of the
+	 * state it entered is armed. A halted aircraft ignores everything from
+	 * then on. The event is recorded if the fleet is being traced, along
+	 * with the state it left the aircraft in, moved or not.
+	 */
+	uint8_t state = fl->states[craft];
+	if (state == FSM_HALT)
+	{
+		return;
+	}
+	aircraft instance;
+	craft_pack(&instance, fl->controls, craft);
+	uint8_t moved = fsm_dispatch(fl->machine, &fl->states[craft], event, &instance);
+	if (moved != REF_ACTIVATE)
+	{
+		craft_unpack(&instance, fl->controls, craft);
+		fl->transitions++;
+		wheel_cancel(&fl->wheel, craft);
+		if (moved == REF_INACTIVE)
+		{
+			fl->states[craft] = FSM_HALT;
+			fl->active--;
+		}
+		else
+		{
+			fleet_arm(fl, craft);
+		}
+	}
+	if (fl->trace != NULL)
+	{
+		trace_record(fl->trace, fl->now, craft, event, state, fl->states[craft]);
+	}
+} //end void fleet_dispatch()
@@ -0,0 +1,52 @@
+# include "../src/fsm_practical.h"
+
+int fleet_expire(fleet *fl)
+{
+	/* This function fires every timer that is due by the fleet's clock, and
+	 * returns how long the event loop can wait before the next one is (see
+	 * wheel_next()): FOREVER if no timer is armed.
+	 * The aircraft that are due are collected first, by turning the timing
+	 * wheel. A few of them are dispatched one at a time, but many at once (a
+	 * whole wave of takeoffs timing out together, say) have their timeouts
+	 * applied by fleet_batch() instead, in a handful of passes over the
+	 * columns that cost less than the dispatches would. Timeouts are batched
+	 * once at least FLEET_BATCH aircraft, and at least 1 in FLEET_BATCH of
+	 * the fleet, are due. Only aircraft in states whose timeout can't be
+	 * batched are still dispatched then. A batched timeout is recorded to
+	 * the fleet's trace just like a dispatched one, as its effect is known
+	 * beforehand.
+	 */
+	uint32_t n_due = wheel_advance(&fl->wheel, fl->now, fl->due_list);
+	uint8_t batch = (n_due >= FLEET_BATCH) && (n_due >= fl->count / FLEET_BATCH);
+	uint32_t n_batched = 0;
+	for (uint32_t index = 0; index < n_due; index++)
+	{
+		uint32_t craft = fl->due_list[index];
+		if (batch && (fl->batch_next[fl->states[craft]] != FSM_STAY))
+		{
+			fl->due[craft] = 0xFF;
+			fl->due_list[n_batched++] = craft;
+			if (fl->trace != NULL)
+			{
+				trace_record(fl->trace, fl->now, craft, EVENT_TIMEOUT, fl->states[craft], fl->batch_next[fl->states[craft]]);
+			}
+# ifdef FSM_STATS
+			stats_batched(fl->states[craft], EVENT_TIMEOUT, fl->batch_next[fl->states[craft]]);
+# endif
+		}
+		else
+		{
+			fleet_dispatch(fl, craft, EVENT_TIMEOUT);
+		}
+	}
+	if (n_batched > 0)
+	{
+		fleet_batch(fl);
+		fl->transitions += n_batched;
+		for (uint32_t index = 0; index < n_batched; index++)
+		{
+			fleet_arm(fl, fl->due_list[index]);
+		}
+	}
+	return wheel_next(&fl->wheel, fl->now);
+} //end int fleet_expire()
@@ -0,0 +1,20 @@
+# include "../src/fsm_practical.h"
+
+void fleet_input(fleet *fl, const char *line)
+{
+	/* This function hands a line of pilot input to the fleet (see
+	 * parse_input()), dispatching it to every aircraft it is for. Lines
+	 * naming no aircraft of the fleet are ignored.
+	 */
+	uint32_t first;
+	uint32_t last;
+	uint8_t event = parse_input(line, fl->count, &first, &last);
+	if (event == FSM_STAY)
+	{
+		return;
+	}
+	for (uint32_t craft = first; craft < last; craft++)
+	{
+		fleet_dispatch(fl, craft, event);
+	}
+} //end void fleet_input()
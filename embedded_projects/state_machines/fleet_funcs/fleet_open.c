@@ -0,0 +1,59 @@
+# include "../src/fsm_practical.h"
+
+uint8_t fleet_open(fleet *fl, const fsm_machine *machine, uint32_t count, uint8_t initial, int64_t now)
+{
+	/* This function sets up a fleet of count aircraft run by machine, every
+	 * one of them started in the initial state at time now (in milliseconds),
+	 * with one timer each on the fleet's timing wheel. A state's
+	 * timeout transition can be applied in batch if it is unguarded and
+	 * leads to a state: its effect is then entirely the next state's outputs,
+	 * unpacked here into one byte per column. Returns REF_INACTIVE, with
+	 * nothing left allocated, if the fleet doesn't fit into memory.
+	 */
+	*fl = (fleet){0};
+	fl->machine = machine;
+	fl->count = count;
+	fl->active = count;
+	fl->columns = calloc(count, CONTROL_COUNT);
+	fl->states = calloc(count, sizeof(uint8_t));
+	fl->due = calloc(count, sizeof(uint8_t));
+	fl->due_list = calloc(count, sizeof(uint32_t));
+	fl->now = now;
+	if (!fl->columns || !fl->states || !fl->due || !fl->due_list || !wheel_open(&fl->wheel, count, fl->now))
+	{
+		fprintf(stderr, "fleet_open(): out of memory.\n");
+		fleet_close(fl);
+		return REF_INACTIVE;
+	}
+	for (uint8_t control = 0; control < CONTROL_COUNT; control++)
+	{
+		fl->controls[control] = fl->columns + ((size_t)control * count);
+	}
+	for (uint8_t state = 0; state < machine->n_states; state++)
+	{
+		const fsm_transition *transition = &machine->table[(state * machine->n_events) + EVENT_TIMEOUT];
+		uint8_t batchable = (transition->guard == REF_INACTIVE) && (transition->next < machine->n_states);
+		fl->batch_next[state] = (batchable)? transition->next : FSM_STAY;
+		uint8_t *const drives[CONTROL_COUNT] = {&fl->drives[state][CTRL_LEVER], &fl->drives[state][CTRL_LIMIT],
+			&fl->drives[state][CTRL_SQUAT], &fl->drives[state][CTRL_GEAR], &fl->drives[state][CTRL_LIGHTS],
+			&fl->drives[state][CTRL_VALVE]};
+		uint8_t *const levels[CONTROL_COUNT] = {&fl->levels[state][CTRL_LEVER], &fl->levels[state][CTRL_LIMIT],
+			&fl->levels[state][CTRL_SQUAT], &fl->levels[state][CTRL_GEAR], &fl->levels[state][CTRL_LIGHTS],
+			&fl->levels[state][CTRL_VALVE]};
+		craft_unpack(&craft_drives[state], drives, 0);
+		craft_unpack(&craft_outputs[state], levels, 0);
+		for (uint8_t control = 0; control < CONTROL_COUNT; control++)
+		{
+			fl->drives[state][control] = (fl->drives[state][control] != 0)? 0xFF : 0;
+		}
+	}
+
+	for (uint32_t craft = 0; craft < count; craft++)
+	{
+		aircraft instance = {0};
+		fsm_start(machine, &fl->states[craft], initial, &instance);
+		craft_unpack(&instance, fl->controls, craft);
+		fleet_arm(fl, craft);
+	}
+	return REF_ACTIVATE;
+} //end uint8_t fleet_open()
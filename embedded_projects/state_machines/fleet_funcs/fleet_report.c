@@ -0,0 +1,11 @@
+# include "../src/fsm_practical.h"
+
+void fleet_report(const fleet *fl)
+{
+	/* This function reports what a fleet run did: how many aircraft are still
+	 * active, the transitions they made and what one cost on average.
+	 */
+	printf("fleet: %u aircraft, %u active, %llu transitions, %.1f ns per transition.\n",
+		fl->count, fl->active, (unsigned long long)fl->transitions,
+		(fl->transitions > 0)? (double)fl->busy_ns / (double)fl->transitions : 0.0);
+} //end void fleet_report()
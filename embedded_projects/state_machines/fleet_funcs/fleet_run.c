@@ -0,0 +1,32 @@
+# include "../src/fsm_practical.h"
+
+void fleet_run(fleet *fl)
+{
+	/* This function drives a whole fleet from the one event loop. Every
+	 * wakeup reads the clock once, hands a line of input to the fleet (see
+	 * fleet_input()) and fires whatever timers are due, and the loop then
+	 * sleeps until the next input or the earliest pending timer. Nothing is
+	 * printed per transition: the run ends once every aircraft has halted, or
+	 * once stdin is closed and no timer is left to fire. busy_ns is then the
+	 * time spent handling wakeups, waiting excluded (see fleet_report().)
+	 */
+	uint8_t listening = REF_ACTIVATE;
+	int timeout = FOREVER;
+	while ((fl->active > 0) && (listening || (timeout != FOREVER)))
+	{
+		loop_register(listening, timeout);
+		uint8_t event = loop_wait();
+		int64_t start = clock_ns();
+		fl->now = start / NS_PER_MS;
+		if (event == EVENT_CLOSE)
+		{
+			listening = REF_INACTIVE;
+		}
+		else if (event != EVENT_TIMEOUT)
+		{
+			fleet_input(fl, fsm_loop.input);
+		}
+		timeout = fleet_expire(fl);
+		fl->busy_ns += clock_ns() - start;
+	}
+} //end void fleet_run()
@@ -0,0 +1,61 @@
+# include "../src/fsm_practical.h"
+
+uint8_t fleet_simulate(fleet *fl, FILE *scenario)
+{
+	/* This function runs a fleet in virtual time, as a discrete-event
+	 * simulation: the fleet's clock isn't read from the system but jumps
+	 * straight from one event to the next, so nothing ever waits and the
+	 * same scenario always plays out the same way. The pilots' input comes
+	 * from the scenario rather than stdin, one line per input:
+	 * "<delay> <input>", where the input (see fleet_input()) comes delay
+	 * milliseconds after the one before it. Blank lines and lines starting
+	 * with '#' are skipped. The next event is whichever is earlier, the next
+	 * line or the next timer (see wheel_next()); a line and the timers due
+	 * at the same time are handled in the same order as by fleet_run(), the
+	 * input first. The run ends once every aircraft has halted, or once the
+	 * scenario is over and no timer is left to fire; the fleet's busy_ns is
+	 * then the wall-clock time the whole run took. Returns REF_INACTIVE for a
+	 * malformed scenario.
+	 */
+	char line[SCENARIO_LINE];
+	const char *input = NULL;
+	int64_t next_input = fl->now;
+	uint32_t line_number = 0;
+	int64_t start = clock_ns();
+	int timeout = wheel_next(&fl->wheel, fl->now);
+	while (fl->active > 0)
+	{
+		while ((input == NULL) && fgets(line, SCENARIO_LINE, scenario))
+		{
+			line_number++;
+			line[strcspn(line, "\n")] = 0;
+			if ((line[0] == '\0') || (line[0] == '#')) continue;
+			char *end;
+			long long delay = strtoll(line, &end, 10);
+			if ((end == line) || (delay < 0) || ((*end != ' ') && (*end != '\0')))
+			{
+				fprintf(stderr, "fleet_simulate(): malformed scenario line %u.\n", line_number);
+				return REF_INACTIVE;
+			}
+			input = (*end == ' ')? end + 1 : end;
+			next_input += delay;
+		}
+		if ((input == NULL) && (timeout == FOREVER))
+		{
+			break;
+		}
+		if ((input != NULL) && ((timeout == FOREVER) || (next_input <= fl->now + timeout)))
+		{
+			fl->now = next_input;
+			fleet_input(fl, input);
+			input = NULL;
+		}
+		else
+		{
+			fl->now += timeout;
+		}
+		timeout = fleet_expire(fl);
+	}
+	fl->busy_ns = clock_ns() - start;
+	return REF_ACTIVATE;
+} //end uint8_t fleet_simulate()
@@ -0,0 +1,62 @@
+# include "../src/fsm_practical.h"
+
+static uint8_t fsm_step(const fsm_machine *machine, uint8_t *state, uint8_t event, void *ctx)
+{
+	if (machine->dispatch != NULL)
+	{
+		return machine->dispatch(state, event, ctx);
+	}
+	const fsm_transition *transition = &machine->table[(*state * machine->n_events) + event];
+	if (transition->next == FSM_STAY)
+	{
+		return REF_ACTIVATE;
+	}
+	if ((transition->guard != REF_INACTIVE) && !machine->guards[transition->guard](ctx, *state, event))
+	{
+		return REF_ACTIVATE;
+	}
+	if (transition->action != REF_INACTIVE)
+	{
+		machine->actions[transition->action](ctx, *state, event);
+	}
+	if (transition->next == FSM_HALT)
+	{
+		return REF_INACTIVE;
+	}
+	*state = transition->next;
+	uint8_t entry = machine->states[*state].entry;
+	if (entry != REF_INACTIVE)
+	{
+		machine->actions[entry](ctx, *state, event);
+	}
+	return FSM_MOVED;
+}
+
+uint8_t fsm_dispatch(const fsm_machine *machine, uint8_t *state, uint8_t event, void *ctx)
+{
+	/* This function is the whole of the engine: it feeds one event to a
+	 * machine in the given state. What happens is looked up with a single
+	 * indexed load from the flat transition table, so a dispatch costs the
+	 * same whatever the machine and however many states it has. An event
+	 * the state ignores (FSM_STAY), or whose guard vetoes it, leaves the
+	 * machine where it is. Otherwise the transition's action runs and the
+	 * machine moves to its next state, whose entry action runs last (a state
+	 * transitioning to itself is entered again.) REF_INACTIVE is returned
+	 * once the machine halted, FSM_MOVED when it entered a state and
+	 * REF_ACTIVATE when it stayed where it was, so that a driver knows when
+	 * the state's waits have to be registered anew. A machine that has a
+	 * dispatcher of its own is handed to it instead, which does the same
+	 * without the lookup. Built with "make STATS=1", every dispatch is
+	 * timed and recorded by stats_record(); otherwise nothing of it is
+	 * compiled in.
+	 */
+# ifdef FSM_STATS
+	uint8_t from = *state;
+	int64_t start = clock_ns();
+	uint8_t result = fsm_step(machine, state, event, ctx);
+	stats_record(from, event, *state, result, clock_ns() - start);
+	return result;
+# else
+	return fsm_step(machine, state, event, ctx);
+# endif
+} //end uint8_t fsm_dispatch()
@@ -0,0 +1,16 @@
+# include "../src/fsm_practical.h"
+
+void fsm_start(const fsm_machine *machine, uint8_t *state, uint8_t initial, void *ctx)
+{
+	/* This function puts a machine in its initial state and runs that state's
+	 * entry action, just as if the machine had transitioned into it. The
+	 * state lives with the caller rather than the engine, so one machine
+	 * description can run any number of instances side by side.
+	 */
+	*state = initial;
+	uint8_t entry = machine->states[initial].entry;
+	if (entry != REF_INACTIVE)
+	{
+		machine->actions[entry](ctx, initial, EVENT_INPUT);
+	}
+} //end void fsm_start()
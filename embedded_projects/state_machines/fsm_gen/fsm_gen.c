@@ -0,0 +1,578 @@
+/* fsm_gen compiles a machine description into the C the fsm engine runs, as
+ * a step of the build: "fsm_gen <description> <output>". The description is
+ * a text file of one declaration per line ('#' starts a comment):
+ *
+ *	event <name> [input|timer]
+ *		an event, in the order of the EVENT_ numbers, and whether it comes
+ *		from pilot input or from a state's timer (or neither)
+ *	action <name>
+ *	guard <name>
+ *		what the machines can do on a transition or on entering a state,
+ *		and what can veto a transition
+ *	machine <name> <action or guard>=<function> ...
+ *		a machine, with the C function it does every action and guard with
+ *	state <name> <entry action or -> <listen|deaf> <timeout|forever>
+ *		a state, in the order of the STATE_ numbers (the first is the
+ *		initial one), with what it does on entry, whether input events move
+ *		it on and how many milliseconds it waits before it times out (a
+ *		number or a constant expression without spaces)
+ *	<state|*> <event> -> <state|halt|stay> [if <guard>] [do <action>]
+ *		a transition ('*' for every state that has none for the event)
+ *
+ * Every mistake the engine couldn't catch until it ran is caught here, and
+ * fails the build: unknown or duplicate names, two transitions for one state
+ * and event, machines missing a function, a state listening to nothing but
+ * input it never gets, a timer event for a state that never times out or a
+ * state that times out into nothing, and states the initial one can never
+ * reach. What the generated C still has to agree with, the EVENT_ and
+ * STATE_ numbers of fsm_practical.h, is checked by _Static_assert()s when
+ * it is compiled.
+ * For every machine, the output holds an fsm_machine (the transition table
+ * and the state descriptions shared by all of them) and a dispatcher
+ * specialised for it: one switch over every state and event pair, which the
+ * compiler turns into a single jump table, each case calling its guard and
+ * actions directly. fsm_dispatch() defers to it, so a dispatch is one
+ * indirect jump rather than a table lookup and calls through pointers. A
+ * switch rather than computed gotos keeps the output standard C. The names
+ * of the states and events come along, as fsm_state_names and
+ * fsm_event_names, for whatever reports on the machine.
+ */
+
+# include <ctype.h>
+# include <stdarg.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+
+# define GEN_NAMES		32 //the most states, events, actions and guards a description can have
+# define GEN_MACHINES	8 //the most machines a description can have
+# define GEN_NAME		32 //used to set the size of a name's buffer
+# define GEN_LINE		256 //used to set the size of the line buffer
+# define GEN_TOKENS		16 //the most tokens a line can have
+# define GEN_NONE		0xFF //index of a name that wasn't found
+# define GEN_STAY		0xFF //target of an event a state ignores
+# define GEN_HALT		0xFE //target that stops the machine
+# define GEN_INPUT		1 //source of an event that comes from pilot input
+# define GEN_TIMER		2 //source of an event that comes from a state's timer
+
+typedef struct
+{
+	uint8_t next;	//a state index, GEN_STAY or GEN_HALT
+	uint8_t guard;	//a guard index + 1, 0 for none
+	uint8_t action;	//an action index + 1, 0 for none
+	uint32_t line;	//where it was declared, 0 if it wasn't
+} gen_transition;
+
+typedef struct
+{
+	char name[GEN_NAME];
+	char entry_name[GEN_NAME];	//an action, or "-" for none
+	uint8_t entry;	//an action index + 1, 0 for none
+	uint8_t listen;
+	char timeout[GEN_NAME];
+} gen_state;
+
+typedef struct
+{
+	char name[GEN_NAME];
+	char actions[GEN_NAMES][GEN_NAME];	//the function of every action
+	char guards[GEN_NAMES][GEN_NAME];	//the function of every guard
+	uint32_t line;
+} gen_machine;
+
+typedef struct
+{
+	const char *path;
+	uint32_t line;
+	uint32_t errors;
+	char events[GEN_NAMES][GEN_NAME];
+	uint8_t sources[GEN_NAMES];
+	char actions[GEN_NAMES][GEN_NAME];
+	char guards[GEN_NAMES][GEN_NAME];
+	gen_state states[GEN_NAMES];
+	gen_machine machines[GEN_MACHINES];
+	gen_transition table[GEN_NAMES][GEN_NAMES];
+	gen_transition every[GEN_NAMES];	//the '*' transitions, per event
+	uint8_t n_events, n_actions, n_guards, n_states, n_machines;
+} gen_description;
+
+__attribute__((format(printf, 2, 3)))
+static void fail(gen_description *dsc, const char *message, ...)
+{
+	/* Reports a mistake in the description, at the line being read (if
+	 * any), and counts it.
+	 */
+	va_list args;
+	va_start(args, message);
+	if (dsc->line > 0) fprintf(stderr, "%s:%u: ", dsc->path, dsc->line);
+	else fprintf(stderr, "%s: ", dsc->path);
+	vfprintf(stderr, message, args);
+	fputc('\n', stderr);
+	va_end(args);
+	dsc->errors++;
+}
+
+static uint8_t find(char names[][GEN_NAME], uint8_t count, const char *name)
+{
+	for (uint8_t index = 0; index < count; index++)
+	{
+		if (!strcmp(names[index], name)) return index;
+	}
+	return GEN_NONE;
+}
+
+static uint8_t find_state(const gen_description *dsc, const char *name)
+{
+	for (uint8_t index = 0; index < dsc->n_states; index++)
+	{
+		if (!strcmp(dsc->states[index].name, name)) return index;
+	}
+	return GEN_NONE;
+}
+
+static uint8_t declare(gen_description *dsc, const char *name, uint8_t count)
+{
+	/* Whether a name can be added to a list of count names: it has to be a C
+	 * identifier, as it ends up in the output, unique and not reserved, and
+	 * the list mustn't be full.
+	 */
+	uint8_t valid = (strlen(name) < GEN_NAME) && (isalpha((unsigned char)name[0]) || (name[0] == '_'));
+	for (const char *c = name; *c; c++) valid = valid && (isalnum((unsigned char)*c) || (*c == '_'));
+	if (!valid) fail(dsc, "\"%s\" is not a valid name.", name);
+	else if (!strcmp(name, "halt") || !strcmp(name, "stay")) fail(dsc, "\"%s\" is reserved.", name);
+	else if ((find(dsc->events, dsc->n_events, name) != GEN_NONE) || (find(dsc->actions, dsc->n_actions, name) != GEN_NONE)
+		|| (find(dsc->guards, dsc->n_guards, name) != GEN_NONE) || (find_state(dsc, name) != GEN_NONE))
+	{
+		fail(dsc, "\"%s\" is declared twice.", name);
+	}
+	else if (count == GEN_NAMES) fail(dsc, "too many names, \"%s\" is one too many.", name);
+	else return 1;
+	return 0;
+}
+
+static uint8_t split(char *line, char *tokens[GEN_TOKENS])
+{
+	/* Cuts a line into its whitespace-separated tokens, comment excluded.
+	 */
+	line[strcspn(line, "#\n")] = '\0';
+	uint8_t count = 0;
+	for (char *token = strtok(line, " \t\r"); token && (count < GEN_TOKENS); token = strtok(NULL, " \t\r"))
+	{
+		tokens[count++] = token;
+	}
+	return count;
+}
+
+static void read_declaration(gen_description *dsc, char *tokens[GEN_TOKENS], uint8_t count)
+{
+	/* The first pass: events, actions, guards, states and machines, so that
+	 * transitions and bindings can refer to names declared after them.
+	 */
+	if (!strcmp(tokens[0], "event") && ((count == 2) || (count == 3)))
+	{
+		if (!declare(dsc, tokens[1], dsc->n_events))
+		{
+			return;
+		}
+		uint8_t event = dsc->n_events++;
+		strcpy(dsc->events[event], tokens[1]);
+		if (count == 2) dsc->sources[event] = 0;
+		else if (!strcmp(tokens[2], "input")) dsc->sources[event] = GEN_INPUT;
+		else if (!strcmp(tokens[2], "timer")) dsc->sources[event] = GEN_TIMER;
+		else fail(dsc, "an event comes from input or timer, not \"%s\".", tokens[2]);
+	}
+	else if (!strcmp(tokens[0], "action") && (count == 2))
+	{
+		if (declare(dsc, tokens[1], dsc->n_actions)) strcpy(dsc->actions[dsc->n_actions++], tokens[1]);
+	}
+	else if (!strcmp(tokens[0], "guard") && (count == 2))
+	{
+		if (declare(dsc, tokens[1], dsc->n_guards)) strcpy(dsc->guards[dsc->n_guards++], tokens[1]);
+	}
+	else if (!strcmp(tokens[0], "machine") && (count >= 2))
+	{
+		if (dsc->n_machines == GEN_MACHINES) fail(dsc, "too many machines, \"%s\" is one too many.", tokens[1]);
+		else if (strlen(tokens[1]) >= GEN_NAME) fail(dsc, "\"%s\" is not a valid name.", tokens[1]);
+		else
+		{
+			gen_machine *machine = &dsc->machines[dsc->n_machines++];
+			strcpy(machine->name, tokens[1]);
+			machine->line = dsc->line;
+		}
+	}
+	else if (!strcmp(tokens[0], "state") && (count == 5))
+	{
+		if (!declare(dsc, tokens[1], dsc->n_states))
+		{
+			return;
+		}
+		gen_state *state = &dsc->states[dsc->n_states++];
+		strcpy(state->name, tokens[1]);
+		state->listen = !strcmp(tokens[3], "listen");
+		if (!state->listen && strcmp(tokens[3], "deaf")) fail(dsc, "a state is listen or deaf, not \"%s\".", tokens[3]);
+		if ((strlen(tokens[2]) >= GEN_NAME) || (strlen(tokens[4]) >= GEN_NAME)) fail(dsc, "state \"%s\" is malformed.", tokens[1]);
+		else
+		{
+			strcpy(state->entry_name, tokens[2]);
+			strcpy(state->timeout, (!strcmp(tokens[4], "forever"))? "FOREVER" : tokens[4]);
+		}
+	}
+	else if ((count < 4) || strcmp(tokens[2], "->"))
+	{
+		fail(dsc, "\"%s\" doesn't start a declaration or a transition.", tokens[0]);
+	}
+}
+
+static void read_transition(gen_description *dsc, char *tokens[GEN_TOKENS], uint8_t count)
+{
+	/* The second pass: transitions and the machines' functions, now that
+	 * every name is known.
+	 */
+	if (!strcmp(tokens[0], "machine"))
+	{
+		gen_machine *machine = NULL;
+		for (uint8_t index = 0; index < dsc->n_machines; index++)
+		{
+			if (dsc->machines[index].line == dsc->line) machine = &dsc->machines[index];
+		}
+		for (uint8_t token = 2; machine && (token < count); token++)
+		{
+			char *function = strchr(tokens[token], '=');
+			if ((function == NULL) || (strlen(function + 1) == 0) || (strlen(function + 1) >= GEN_NAME))
+			{
+				fail(dsc, "\"%s\" doesn't bind a function.", tokens[token]);
+				continue;
+			}
+			*function++ = '\0';
+			uint8_t action = find(dsc->actions, dsc->n_actions, tokens[token]);
+			uint8_t guard = find(dsc->guards, dsc->n_guards, tokens[token]);
+			char *bound = (action != GEN_NONE)? machine->actions[action] : (guard != GEN_NONE)? machine->guards[guard] : NULL;
+			if (bound == NULL) fail(dsc, "there's no action or guard \"%s\".", tokens[token]);
+			else if (bound[0] != '\0') fail(dsc, "\"%s\" is bound twice.", tokens[token]);
+			else strcpy(bound, function);
+		}
+		return;
+	}
+	if ((count < 4) || strcmp(tokens[2], "->"))
+	{
+		return;	//a declaration, read by the first pass
+	}
+	uint8_t state = find_state(dsc, tokens[0]);
+	uint8_t event = find(dsc->events, dsc->n_events, tokens[1]);
+	gen_transition transition = {find_state(dsc, tokens[3]), 0, 0, dsc->line};
+	if ((state == GEN_NONE) && strcmp(tokens[0], "*")) fail(dsc, "there's no state \"%s\".", tokens[0]);
+	if (event == GEN_NONE) fail(dsc, "there's no event \"%s\".", tokens[1]);
+	if (!strcmp(tokens[3], "halt")) transition.next = GEN_HALT;
+	else if (!strcmp(tokens[3], "stay")) transition.next = GEN_STAY;
+	else if (transition.next == GEN_NONE) fail(dsc, "there's no state \"%s\".", tokens[3]);
+	for (uint8_t token = 4; token < count; token += 2)
+	{
+		uint8_t *field = (!strcmp(tokens[token], "if"))? &transition.guard : (!strcmp(tokens[token], "do"))? &transition.action : NULL;
+		uint8_t index = GEN_NONE;
+		if ((field == NULL) || (token + 1 == count) || (*field != 0))
+		{
+			fail(dsc, "\"%s\" is out of place, a transition ends with [if <guard>] [do <action>].", tokens[token]);
+			break;
+		}
+		index = (field == &transition.guard)? find(dsc->guards, dsc->n_guards, tokens[token + 1])
+			: find(dsc->actions, dsc->n_actions, tokens[token + 1]);
+		if (index == GEN_NONE) fail(dsc, (field == &transition.guard)? "there's no guard \"%s\"." : "there's no action \"%s\".", tokens[token + 1]);
+		*field = (uint8_t)(index + 1);
+	}
+	if (event == GEN_NONE)
+	{
+		return;
+	}
+	gen_transition *slot = (state != GEN_NONE)? &dsc->table[state][event] : &dsc->every[event];
+	if (slot->line != 0) fail(dsc, "a transition for \"%s\" was given already.", tokens[1]);
+	else *slot = transition;
+}
+
+static void validate(gen_description *dsc)
+{
+	/* The checks that need the whole description: '*' transitions are
+	 * spread over the states, every state's entry and every machine's
+	 * functions are known, what a state waits for matches what it
+	 * handles, and every state can be reached from the initial one.
+	 */
+	dsc->line = 0;
+	if ((dsc->n_states == 0) || (dsc->n_events == 0)) fail(dsc, "a machine needs states and events.");
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		const gen_state *desc = &dsc->states[state];
+		uint8_t times_out = strcmp(desc->timeout, "FOREVER");
+		uint8_t handles_timer = 0;
+		uint8_t entry = find(dsc->actions, dsc->n_actions, desc->entry_name);
+		dsc->states[state].entry = (entry != GEN_NONE)? (uint8_t)(entry + 1) : 0;
+		if ((entry == GEN_NONE) && strcmp(desc->entry_name, "-"))
+		{
+			fail(dsc, "the entry action of state \"%s\" isn't an action.", desc->name);
+		}
+		for (uint8_t event = 0; event < dsc->n_events; event++)
+		{
+			gen_transition *transition = &dsc->table[state][event];
+			if (transition->line == 0) *transition = dsc->every[event];
+			if (transition->line == 0) transition->next = GEN_STAY;
+			if (transition->next == GEN_STAY)
+			{
+				continue;
+			}
+			handles_timer |= (dsc->sources[event] == GEN_TIMER);
+			if (transition->line == dsc->every[event].line)
+			{
+				continue;	//every state's, which is checked for none in particular
+			}
+			dsc->line = transition->line;
+			if (!desc->listen && (dsc->sources[event] == GEN_INPUT)) fail(dsc, "state \"%s\" is deaf to input.", desc->name);
+			if (!times_out && (dsc->sources[event] == GEN_TIMER)) fail(dsc, "state \"%s\" never times out.", desc->name);
+			dsc->line = 0;
+		}
+		if (times_out && !handles_timer) fail(dsc, "state \"%s\" times out, but has no transition for it.", desc->name);
+	}
+	for (uint8_t index = 0; index < dsc->n_machines; index++)
+	{
+		const gen_machine *machine = &dsc->machines[index];
+		dsc->line = machine->line;
+		for (uint8_t action = 0; action < dsc->n_actions; action++)
+		{
+			if (machine->actions[action][0] == '\0') fail(dsc, "no function does action \"%s\".", dsc->actions[action]);
+		}
+		for (uint8_t guard = 0; guard < dsc->n_guards; guard++)
+		{
+			if (machine->guards[guard][0] == '\0') fail(dsc, "no function does guard \"%s\".", dsc->guards[guard]);
+		}
+	}
+	dsc->line = 0;
+	if (dsc->n_machines == 0) fail(dsc, "there's no machine to generate.");
+
+	uint8_t reached[GEN_NAMES] = {0};
+	uint8_t stack[GEN_NAMES];
+	uint8_t depth = 0;
+	if (dsc->n_states > 0)
+	{
+		reached[0] = 1;
+		stack[depth++] = 0;
+	}
+	while (depth > 0)
+	{
+		uint8_t state = stack[--depth];
+		for (uint8_t event = 0; event < dsc->n_events; event++)
+		{
+			uint8_t next = dsc->table[state][event].next;
+			if ((next < dsc->n_states) && !reached[next])
+			{
+				reached[next] = 1;
+				stack[depth++] = next;
+			}
+		}
+	}
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		if (!reached[state]) fail(dsc, "state \"%s\" can never be reached.", dsc->states[state].name);
+	}
+}
+
+static void upper(char *dest, const char *prefix, const char *name)
+{
+	/* The fsm_practical.h name of a state or event: ground is STATE_GROUND.
+	 */
+	size_t length = strlen(prefix);
+	strcpy(dest, prefix);
+	for (; *name; name++) dest[length++] = (char)toupper((unsigned char)*name);
+	dest[length] = '\0';
+}
+
+static void emit_target(FILE *out, const gen_description *dsc, uint8_t next)
+{
+	char name[GEN_NAME + 8];
+	upper(name, "STATE_", (next < dsc->n_states)? dsc->states[next].name : "");
+	fputs((next == GEN_HALT)? "FSM_HALT" : (next == GEN_STAY)? "FSM_STAY" : name, out);
+}
+
+static void emit_dispatcher(FILE *out, const gen_description *dsc, const gen_machine *machine)
+{
+	/* The dispatcher specialised for a machine: what fsm_dispatch() does
+	 * with the machine's table, spelt out case by case.
+	 */
+	char state_name[GEN_NAME + 8];
+	char event_name[GEN_NAME + 8];
+	fprintf(out, "static uint8_t %s_dispatch(uint8_t *state, uint8_t event, void *ctx)\n{\n", machine->name);
+	fprintf(out, "\tswitch ((*state * EVENT_COUNT) + event)\n\t{\n");
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		upper(state_name, "STATE_", dsc->states[state].name);
+		for (uint8_t event = 0; event < dsc->n_events; event++)
+		{
+			const gen_transition *transition = &dsc->table[state][event];
+			if (transition->next == GEN_STAY)
+			{
+				continue;
+			}
+			upper(event_name, "EVENT_", dsc->events[event]);
+			fprintf(out, "\t\tcase (%s * EVENT_COUNT) + %s:\n", state_name, event_name);
+			if (transition->guard != 0)
+			{
+				fprintf(out, "\t\t\tif (!%s(ctx, %s, %s)) return REF_ACTIVATE;\n",
+					machine->guards[transition->guard - 1], state_name, event_name);
+			}
+			if (transition->action != 0)
+			{
+				fprintf(out, "\t\t\t%s(ctx, %s, %s);\n", machine->actions[transition->action - 1], state_name, event_name);
+			}
+			if (transition->next == GEN_HALT)
+			{
+				fprintf(out, "\t\t\treturn REF_INACTIVE;\n");
+				continue;
+			}
+			fputs("\t\t\t*state = ", out);
+			emit_target(out, dsc, transition->next);
+			fputs(";\n", out);
+			uint8_t entry = dsc->states[transition->next].entry;
+			if (entry != 0)
+			{
+				fprintf(out, "\t\t\t%s(ctx, ", machine->actions[entry - 1]);
+				emit_target(out, dsc, transition->next);
+				fprintf(out, ", %s);\n", event_name);
+			}
+			fprintf(out, "\t\t\treturn FSM_MOVED;\n");
+		}
+	}
+	fprintf(out, "\t\tdefault:\n\t\t\treturn REF_ACTIVATE;\n\t}\n} //end uint8_t %s_dispatch()\n\n", machine->name);
+}
+
+static void emit(FILE *out, const gen_description *dsc)
+{
+	/* Writes the whole output: the checks against fsm_practical.h, the
+	 * shared table and states, then every machine's functions, dispatcher
+	 * and fsm_machine.
+	 */
+	char name[GEN_NAME + 8];
+	fprintf(out, "/* Generated by fsm_gen from %s: edit the description, not this file. */\n\n", dsc->path);
+	fprintf(out, "# include \"../src/fsm_practical.h\"\n\n");
+	fprintf(out, "_Static_assert((STATE_COUNT == %u) && (EVENT_COUNT == %u), \"%s doesn't match fsm_practical.h\");\n",
+		dsc->n_states, dsc->n_events, dsc->path);
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		upper(name, "STATE_", dsc->states[state].name);
+		fprintf(out, "_Static_assert(%s == %u, \"%s doesn't match fsm_practical.h\");\n", name, state, dsc->path);
+	}
+	for (uint8_t event = 0; event < dsc->n_events; event++)
+	{
+		upper(name, "EVENT_", dsc->events[event]);
+		fprintf(out, "_Static_assert(%s == %u, \"%s doesn't match fsm_practical.h\");\n", name, event, dsc->path);
+	}
+
+	fprintf(out, "\nconst char *const fsm_state_names[STATE_COUNT] = {");
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		fprintf(out, "%s\"%s\"", (state > 0)? ", " : "", dsc->states[state].name);
+	}
+	fprintf(out, "};\nconst char *const fsm_event_names[EVENT_COUNT] = {");
+	for (uint8_t event = 0; event < dsc->n_events; event++)
+	{
+		fprintf(out, "%s\"%s\"", (event > 0)? ", " : "", dsc->events[event]);
+	}
+	fprintf(out, "};\n");
+	fprintf(out, "\nstatic const fsm_state fsm_states[STATE_COUNT] =\n{\n");
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		const gen_state *desc = &dsc->states[state];
+		upper(name, "STATE_", desc->name);
+		fprintf(out, "\t[%s]\t= {%u, %s, %s}%s\n", name, desc->entry, (desc->listen)? "REF_ACTIVATE" : "REF_INACTIVE",
+			desc->timeout, (state + 1 < dsc->n_states)? "," : "");
+	}
+	fprintf(out, "};\n\nstatic const fsm_transition fsm_table[STATE_COUNT][EVENT_COUNT] =\n{\n");
+	for (uint8_t state = 0; state < dsc->n_states; state++)
+	{
+		upper(name, "STATE_", dsc->states[state].name);
+		fprintf(out, "\t[%s] =\n\t{\n", name);
+		for (uint8_t event = 0; event < dsc->n_events; event++)
+		{
+			const gen_transition *transition = &dsc->table[state][event];
+			upper(name, "EVENT_", dsc->events[event]);
+			fprintf(out, "\t\t[%s]\t= {", name);
+			emit_target(out, dsc, transition->next);
+			fprintf(out, ", %u, %u}%s\n", transition->guard, transition->action, (event + 1 < dsc->n_events)? "," : "");
+		}
+		fprintf(out, "\t}%s\n", (state + 1 < dsc->n_states)? "," : "");
+	}
+	fprintf(out, "};\n\n");
+
+	for (uint8_t index = 0; index < dsc->n_machines; index++)
+	{
+		const gen_machine *machine = &dsc->machines[index];
+		fprintf(out, "static const fsm_action %s_actions[] = {NULL", machine->name);
+		for (uint8_t action = 0; action < dsc->n_actions; action++) fprintf(out, ", %s", machine->actions[action]);
+		fprintf(out, "};\nstatic const fsm_guard %s_guards[] = {NULL", machine->name);
+		for (uint8_t guard = 0; guard < dsc->n_guards; guard++) fprintf(out, ", %s", machine->guards[guard]);
+		fprintf(out, "};\n\n");
+		emit_dispatcher(out, dsc, machine);
+		fprintf(out, "const fsm_machine %s =\n{\n\t&fsm_table[0][0],\n\tfsm_states,\n\t%s_actions,\n\t%s_guards,\n"
+			"\tSTATE_COUNT,\n\tEVENT_COUNT,\n\t%s_dispatch\n};\n%s", machine->name, machine->name, machine->name,
+			machine->name, (index + 1 < dsc->n_machines)? "\n" : "");
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	/* Reads the description in two passes, validates it and only then
+	 * writes the output, so a failed build never leaves a half-written or
+	 * stale file behind for the next one to compile.
+	 */
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s <description> <output>\n", argv[0]);
+		return 1;
+	}
+	gen_description *dsc = calloc(1, sizeof(gen_description));
+	FILE *in = fopen(argv[1], "r");
+	if ((dsc == NULL) || (in == NULL))
+	{
+		perror(argv[1]);
+		free(dsc);
+		return 1;
+	}
+	dsc->path = argv[1];
+	char line[GEN_LINE];
+	char *tokens[GEN_TOKENS];
+	for (uint8_t pass = 0; pass < 2; pass++)
+	{
+		rewind(in);
+		dsc->line = 0;
+		while (fgets(line, GEN_LINE, in))
+		{
+			dsc->line++;
+			uint8_t count = split(line, tokens);
+			if (count == 0) continue;
+			if (pass == 0) read_declaration(dsc, tokens, count);
+			else read_transition(dsc, tokens, count);
+		}
+	}
+	fclose(in);
+	validate(dsc);
+	if (dsc->errors > 0)
+	{
+		fprintf(stderr, "%s: %u error%s, nothing generated.\n", argv[1], dsc->errors, (dsc->errors > 1)? "s" : "");
+		remove(argv[2]);
+		free(dsc);
+		return 1;
+	}
+
+	FILE *out = fopen(argv[2], "w");
+	if (out == NULL)
+	{
+		perror(argv[2]);
+		free(dsc);
+		return 1;
+	}
+	emit(out, dsc);
+	uint8_t failed = ferror(out) | (fclose(out) != 0);
+	if (failed)
+	{
+		perror(argv[2]);
+		remove(argv[2]);
+	}
+	free(dsc);
+	return failed;
+} //end main()
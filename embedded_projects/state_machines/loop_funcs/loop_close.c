@@ -0,0 +1,10 @@
+# include "../src/fsm_practical.h"
+
+void loop_close(void)
+{
+	/* This function releases the event loop's epoll instance once the
+	 * simulation is over.
+	 */
+	close(fsm_loop.epoll_fd);
+	fsm_loop.epoll_fd = -1;
+} //end void loop_close()
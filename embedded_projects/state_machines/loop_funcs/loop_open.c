@@ -0,0 +1,32 @@
+# include "../src/fsm_practical.h"
+
+uint8_t loop_open(void)
+{
+	/* This function sets up the event loop once, before the simulation
+	 * starts: an epoll instance in kernelspace (which keeps its watched file
+	 * descriptors in a set data structure) and stdin registered on it for
+	 * input activity. From then on every state is driven by loop_wait()
+	 * alone, so entering a state costs no epoll_create(), epoll_ctl() or
+	 * close() calls and no file descriptor. Returns REF_INACTIVE if epoll
+	 * couldn't be set up.
+	 */
+	fsm_loop.epoll_fd = epoll_create1(0);
+	if (fsm_loop.epoll_fd == -1)
+	{
+		fprintf(stderr, "epoll_create1() failure.\n");
+		return REF_INACTIVE;
+	}
+	struct epoll_event ep_event;
+	ep_event.events = EPOLLIN; //we're watching for input activity
+	ep_event.data.fd = STDIN_FD;
+	if (epoll_ctl(fsm_loop.epoll_fd, EPOLL_CTL_ADD, STDIN_FD, &ep_event))
+	{
+		fprintf(stderr, "epoll_ctl() failure.\n");
+		close(fsm_loop.epoll_fd);
+		return REF_INACTIVE;
+	}
+	fsm_loop.watching = REF_ACTIVATE;
+	fsm_loop.watch_input = REF_ACTIVATE;
+	fsm_loop.timeout = FOREVER;
+	return REF_ACTIVATE;
+} //end uint8_t loop_open()
@@ -0,0 +1,13 @@
+# include "../src/fsm_practical.h"
+
+void loop_register(uint8_t watch_input, int timeout)
+{
+	/* This function is how a state tells the event loop what it waits for
+	 * when it is entered: whether pilot input moves it on (watch_input) and
+	 * how many milliseconds it waits before its timeout does (FOREVER for
+	 * no timeout.) Nothing is asked of the kernel here, the next call to
+	 * loop_wait() takes care of it.
+	 */
+	fsm_loop.watch_input = watch_input;
+	fsm_loop.timeout = timeout;
+} //end void loop_register()
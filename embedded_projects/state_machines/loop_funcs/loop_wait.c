@@ -0,0 +1,64 @@
+# include "../src/fsm_practical.h"
+
+uint8_t loop_wait(void)
+{
+	/* This function waits for whatever the current state registered for and
+	 * returns the event that happened: EVENT_INPUT if the pilot entered a
+	 * line (which is then in fsm_loop.input), or EVENT_CONFIRM if that line
+	 * was a "y", EVENT_TIMEOUT if the state's
+	 * wait ran out first, or EVENT_CLOSE if stdin was closed or epoll failed.
+	 * epoll_wait() returns the number of file descriptors that are ready for
+	 * I/O, so anything above 0 means stdin has input and 0 means the timeout
+	 * expired. That one epoll_wait() is normally the only system call a
+	 * transition makes: stdin's registration is only modified when a state
+	 * stops listening to input or the next one resumes it (a state that
+	 * doesn't listen leaves any input waiting for the states after it.) stdin
+	 * is taken off the epoll instance altogether rather than registered for
+	 * no events, as a hung up pipe is reported whatever it is registered for.
+	 * A wait a signal interrupts (such as the SIGUSR1 that dumps statistics)
+	 * is resumed for whatever was left of it.
+	 */
+	struct epoll_event ep_event;
+	if (fsm_loop.watch_input != fsm_loop.watching)
+	{
+		ep_event.events = EPOLLIN;
+		ep_event.data.fd = STDIN_FD;
+		int operation = (fsm_loop.watch_input)? EPOLL_CTL_ADD : EPOLL_CTL_DEL;
+		if (epoll_ctl(fsm_loop.epoll_fd, operation, STDIN_FD, &ep_event))
+		{
+			fprintf(stderr, "epoll_ctl() failure.\n");
+			return EVENT_CLOSE;
+		}
+		fsm_loop.watching = fsm_loop.watch_input;
+	}
+	int64_t deadline = clock_ns() + ((int64_t)fsm_loop.timeout * NS_PER_MS);
+	int timeout = fsm_loop.timeout;
+	int epwait_monitor = epoll_wait(fsm_loop.epoll_fd, &ep_event, 1, timeout);
+	while ((epwait_monitor < 0) && (errno == EINTR))
+	{
+		if (timeout != FOREVER)
+		{
+			int64_t left = deadline - clock_ns();
+			timeout = (left > 0)? (int)((left + NS_PER_MS - 1) / NS_PER_MS) : 0;
+		}
+		epwait_monitor = epoll_wait(fsm_loop.epoll_fd, &ep_event, 1, timeout);
+	}
+	if (epwait_monitor > 0)
+	{
+		if (get_input(fsm_loop.input, INPUT_SIZE) == NULL)
+		{
+			return EVENT_CLOSE;
+		}
+		return (!strncmp(fsm_loop.input, "y", strlen("y")))? EVENT_CONFIRM : EVENT_INPUT;
+	}
+	else if (epwait_monitor == 0)
+	{
+		return EVENT_TIMEOUT;
+	}
+	//However, if in some case -1 was returned, we need to handle that as well.
+	else
+	{
+		fprintf(stderr, "epoll_wait() error.\n");
+		return EVENT_CLOSE;
+	}
+} //end uint8_t loop_wait()
@@ -0,0 +1,12 @@
+# include "../src/fsm_practical.h"
+
+int64_t clock_ns(void)
+{
+	/* This function reads the monotonic clock in nanoseconds. It's what the
+	 * fleet's timers and its timing are measured against: unlike the wall
+	 * clock, it never jumps.
+	 */
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((int64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+} //end int64_t clock_ns()
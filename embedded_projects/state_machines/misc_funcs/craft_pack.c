@@ -0,0 +1,14 @@
+# include "../src/fsm_practical.h"
+
+void craft_pack(aircraft *craft, uint8_t *const controls[CONTROL_COUNT], uint32_t index)
+{
+	/* This function gathers entry index of a fleet's columns back into an
+	 * aircraft, so that the machine's actions and guards can be run on it.
+	 */
+	craft->pilot_lever		= controls[CTRL_LEVER][index] & 3;
+	craft->limit_switch		= controls[CTRL_LIMIT][index] & 1;
+	craft->squat_switch		= controls[CTRL_SQUAT][index] & 1;
+	craft->landing_gear		= controls[CTRL_GEAR][index] & 1;
+	craft->cockpit_lights	= controls[CTRL_LIGHTS][index] & 3;
+	craft->direction_valve	= controls[CTRL_VALVE][index] & 1;
+} //end void craft_pack()
@@ -0,0 +1,14 @@
+# include "../src/fsm_practical.h"
+
+void craft_unpack(const aircraft *craft, uint8_t *const controls[CONTROL_COUNT], uint32_t index)
+{
+	/* This function stores an aircraft's controls as entry index of a fleet's
+	 * columns, one byte per control.
+	 */
+	controls[CTRL_LEVER][index]		= craft->pilot_lever;
+	controls[CTRL_LIMIT][index]		= craft->limit_switch;
+	controls[CTRL_SQUAT][index]		= craft->squat_switch;
+	controls[CTRL_GEAR][index]		= craft->landing_gear;
+	controls[CTRL_LIGHTS][index]	= craft->cockpit_lights;
+	controls[CTRL_VALVE][index]		= craft->direction_valve;
+} //end void craft_unpack()
@@ -0,0 +1,37 @@
+# include "../src/fsm_practical.h"
+
+uint8_t parse_input(const char *line, uint32_t count, uint32_t *first, uint32_t *last)
+{
+	/* This function reads a line of pilot input to a fleet of count
+	 * aircraft: "<id>" is input for aircraft id and "<id> y" a confirmation,
+	 * while "all" and "all y" go to every aircraft at once (so "all y" sets
+	 * the whole fleet off.) A fleet of one aircraft takes its pilot's input
+	 * as it is, just like the plain simulation does. The aircraft the input
+	 * is for are first to last - 1, and the event it is is returned:
+	 * EVENT_INPUT or EVENT_CONFIRM, or FSM_STAY, having said so, for a line
+	 * naming no aircraft of the fleet. "all" or the id has to be followed by
+	 * a space or the end of the line, so that "ally" or "3y" name nothing.
+	 */
+	*first = 0;
+	*last = count;
+	const char *rest = line + strlen("all");
+	if (count == 1)
+	{
+		rest = line;
+	}
+	else if (strncmp(line, "all", strlen("all")) || ((*rest != ' ') && (*rest != '\0')))
+	{
+		char *end;
+		unsigned long id = strtoul(line, &end, 10);
+		if ((end == line) || (id >= count) || ((*end != ' ') && (*end != '\0')))
+		{
+			fprintf(stderr, "fleet: no aircraft \"%s\".\n", line);
+			return FSM_STAY;
+		}
+		*first = (uint32_t)id;
+		*last = *first + 1;
+		rest = end;
+	}
+	while (*rest == ' ') rest++;
+	return (*rest == 'y')? EVENT_CONFIRM : EVENT_INPUT;
+} //end uint8_t parse_input()
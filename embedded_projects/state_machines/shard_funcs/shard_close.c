@@ -0,0 +1,21 @@
+# include "../src/fsm_practical.h"
+
+void shard_close(shard_pool *pool)
+{
+	/* This function releases everything a sharded fleet holds, once its
+	 * workers are done. It's safe on a pool that shard_open() only partly set
+	 * up.
+	 */
+	for (uint32_t index = 0; index < pool->n_shards; index++)
+	{
+		shard *sh = &pool->shards[index];
+		fleet_close(&sh->fl);
+		free(sh->ring);
+		if (sh->epoll_fd != -1) close(sh->epoll_fd);
+		if (sh->wake_fd != -1) close(sh->wake_fd);
+	}
+	if (pool->epoll_fd != -1) close(pool->epoll_fd);
+	if (pool->done_fd != -1) close(pool->done_fd);
+	free(pool->shards);
+	*pool = (shard_pool){NULL, 0, 0, 0, -1, -1};
+} //end void shard_close()
@@ -0,0 +1,66 @@
+# include "../src/fsm_practical.h"
+
+uint8_t shard_open(shard_pool *pool, const fsm_machine *machine, uint32_t count, uint32_t n_shards, int64_t now)
+{
+	/* This function sets up a fleet of count aircraft run by machine, split
+	 * into n_shards shards (fewer if there aren't enough aircraft), every
+	 * aircraft started on the ground at time now (in milliseconds.) Each
+	 * shard is a whole fleet of its own, with its ring, its epoll instance
+	 * and the eventfd that wakes it up, and the main thread gets an epoll
+	 * instance of its own for stdin and the workers' done_fd. No thread is
+	 * started yet (see shard_run().) Returns REF_INACTIVE, with nothing left
+	 * allocated, if any of that fails.
+	 */
+	uint32_t per_shard = (count + n_shards - 1) / n_shards;
+	*pool = (shard_pool){NULL, 0, count, per_shard, -1, -1};
+	n_shards = (count + per_shard - 1) / per_shard;
+	pool->shards = aligned_alloc(_Alignof(shard), n_shards * sizeof(shard));
+	pool->epoll_fd = epoll_create1(0);
+	pool->done_fd = eventfd(0, 0);
+	struct epoll_event ep_event;
+	ep_event.events = EPOLLIN;
+	ep_event.data.fd = STDIN_FD;
+	uint8_t status = (pool->shards != NULL) && (pool->epoll_fd != -1) && (pool->done_fd != -1)
+		&& !epoll_ctl(pool->epoll_fd, EPOLL_CTL_ADD, STDIN_FD, &ep_event);
+	ep_event.data.fd = pool->done_fd;
+	status = status && !epoll_ctl(pool->epoll_fd, EPOLL_CTL_ADD, pool->done_fd, &ep_event);
+
+	for (uint32_t index = 0; status && (index < n_shards); index++)
+	{
+		shard *sh = &pool->shards[index];
+		memset(sh, 0, sizeof(shard));
+		pool->n_shards++;
+		sh->first = index * per_shard;
+		sh->ring = malloc(SHARD_RING * sizeof(shard_message));
+		sh->epoll_fd = epoll_create1(0);
+		sh->wake_fd = eventfd(0, 0);
+		sh->done_fd = pool->done_fd;
+		ep_event.data.fd = sh->wake_fd;
+		status = (sh->ring != NULL) && (sh->epoll_fd != -1) && (sh->wake_fd != -1)
+			&& !epoll_ctl(sh->epoll_fd, EPOLL_CTL_ADD, sh->wake_fd, &ep_event);
+		if (!status)
+		{
+			break;
+		}
+		uint32_t size = (count - sh->first < per_shard)? count - sh->first : per_shard;
+		if (!fleet_open(&sh->fl, machine, size, STATE_GROUND, now))
+		{
+			shard_close(pool);
+			return REF_INACTIVE;
+		}
+		for (uint32_t slot = 0; slot < SHARD_RING; slot++)
+		{
+			atomic_init(&sh->ring[slot].sequence, slot);
+		}
+		atomic_init(&sh->head, 0);
+		atomic_init(&sh->signalled, REF_INACTIVE);
+		atomic_init(&sh->finished, REF_INACTIVE);
+	}
+	if (!status)
+	{
+		fprintf(stderr, "shard_open(): couldn't set up the shards.\n");
+		shard_close(pool);
+		return REF_INACTIVE;
+	}
+	return REF_ACTIVATE;
+} //end uint8_t shard_open()
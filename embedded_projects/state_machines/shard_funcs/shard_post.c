@@ -0,0 +1,56 @@
+# include "../src/fsm_practical.h"
+
+void shard_post(shard *sh, uint32_t craft, uint8_t event)
+{
+	/* This function posts event to aircraft craft of a shard (or to every
+	 * one of them, for SHARD_ALL), from any thread, without a lock. Every
+	 * slot of the ring carries a sequence number: a slot is free for the
+	 * poster that claims position head while its sequence is head, and is
+	 * handed to the worker by setting it to head + 1; the worker frees it
+	 * again for the next lap round the ring. Posters claim a position by
+	 * moving head on with a compare-and-swap, so two of them never write the
+	 * same slot, and a poster that finds the ring full yields until the
+	 * worker makes room (or has finished, and the event is dropped.) The
+	 * worker is woken up by its eventfd, but only by the first poster since
+	 * it last looked at the ring, so a burst of events costs one write().
+	 */
+	uint64_t head = atomic_load_explicit(&sh->head, memory_order_relaxed);
+	shard_message *slot;
+	for (;;)
+	{
+		slot = &sh->ring[head & (SHARD_RING - 1)];
+		int64_t lap = (int64_t)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - head);
+		if (lap == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&sh->head, &head, head + 1, memory_order_relaxed, memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (lap < 0)
+		{
+			if (atomic_load_explicit(&sh->finished, memory_order_acquire))
+			{
+				return;
+			}
+			sched_yield();
+			head = atomic_load_explicit(&sh->head, memory_order_relaxed);
+		}
+		else
+		{
+			head = atomic_load_explicit(&sh->head, memory_order_relaxed);
+		}
+	} //end for (;;)
+	slot->craft = craft;
+	slot->event = event;
+	atomic_store_explicit(&slot->sequence, head + 1, memory_order_release);
+
+	if (!atomic_exchange_explicit(&sh->signalled, REF_ACTIVATE, memory_order_acq_rel))
+	{
+		uint64_t wakeup = 1;
+		if (write(sh->wake_fd, &wakeup, sizeof(wakeup)) != sizeof(wakeup))
+		{
+			fprintf(stderr, "shard_post(): couldn't wake the shard up.\n");
+		}
+	}
+} //end void shard_post()
@@ -0,0 +1,24 @@
+# include "../src/fsm_practical.h"
+
+void shard_report(const shard_pool *pool)
+{
+	/* This function reports what a sharded fleet run did, as fleet_report()
+	 * does for the whole fleet, the time of every shard added up. What the
+	 * shards achieved together is then the transitions made over the time
+	 * the busiest of them was busy.
+	 */
+	fleet total = {0};
+	int64_t busiest = 0;
+	total.count = pool->count;
+	for (uint32_t index = 0; index < pool->n_shards; index++)
+	{
+		const fleet *fl = &pool->shards[index].fl;
+		total.active += fl->active;
+		total.transitions += fl->transitions;
+		total.busy_ns += fl->busy_ns;
+		busiest = (fl->busy_ns > busiest)? fl->busy_ns : busiest;
+	}
+	fleet_report(&total);
+	printf("shards: %u shards, %.1f million transitions per second at the busiest one's pace.\n", pool->n_shards,
+		(busiest > 0)? (double)total.transitions * 1e3 / (double)busiest : 0.0);
+} //end void shard_report()
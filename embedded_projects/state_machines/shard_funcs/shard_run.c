@@ -0,0 +1,161 @@
+# include "../src/fsm_practical.h"
+
+static uint8_t shard_take(shard *sh, uint32_t *craft, uint8_t *event)
+{
+	/* Takes the oldest message off a shard's ring, if the poster that
+	 * claimed its slot has finished writing it, and frees the slot for the
+	 * next lap. Only the shard's worker ever calls this, so tail is its own.
+	 */
+	shard_message *slot = &sh->ring[sh->tail & (SHARD_RING - 1)];
+	if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != sh->tail + 1)
+	{
+		return REF_INACTIVE;
+	}
+	*craft = slot->craft;
+	*event = slot->event;
+	atomic_store_explicit(&slot->sequence, sh->tail + SHARD_RING, memory_order_release);
+	sh->tail++;
+	return REF_ACTIVATE;
+}
+
+static void *shard_worker(void *arg)
+{
+	/* The worker of a shard, which is fleet_run() for the shard's fleet
+	 * with the ring in place of stdin: every wakeup reads the clock once,
+	 * takes every message off the ring and fires whatever timers are due.
+	 * Nothing is shared with the other workers, so the transitions
+	 * themselves take no lock and touch no other shard's memory. The worker
+	 * tells the main thread through done_fd once it is done.
+	 */
+	shard *sh = arg;
+	fleet *fl = &sh->fl;
+	uint8_t listening = REF_ACTIVATE;
+	int timeout = FOREVER;
+	while ((fl->active > 0) && (listening || (timeout != FOREVER)))
+	{
+		struct epoll_event ep_event;
+		int ready = epoll_wait(sh->epoll_fd, &ep_event, 1, timeout);
+		int64_t start = clock_ns();
+		fl->now = start / NS_PER_MS;
+		if (ready > 0)
+		{
+			uint64_t wakeups;
+			if (read(sh->wake_fd, &wakeups, sizeof(wakeups)) != sizeof(wakeups))
+			{
+				fprintf(stderr, "shard_run(): couldn't read a wakeup.\n");
+			}
+			atomic_exchange_explicit(&sh->signalled, REF_INACTIVE, memory_order_acq_rel);
+		}
+		else if ((ready < 0) && (errno != EINTR))
+		{
+			fprintf(stderr, "epoll_wait() error.\n");
+			break;
+		}
+		uint32_t craft;
+		uint8_t event;
+		while (shard_take(sh, &craft, &event))
+		{
+			if (craft == SHARD_CLOSE)
+			{
+				listening = REF_INACTIVE;
+			}
+			else if (craft == SHARD_ALL)
+			{
+				for (craft = 0; craft < fl->count; craft++)
+				{
+					fleet_dispatch(fl, craft, event);
+				}
+			}
+			else
+			{
+				fleet_dispatch(fl, craft, event);
+			}
+		} //end while (shard_take())
+		timeout = fleet_expire(fl);
+		fl->busy_ns += clock_ns() - start;
+	}
+	atomic_store_explicit(&sh->finished, REF_ACTIVATE, memory_order_release);
+	uint64_t done = 1;
+	if (write(sh->done_fd, &done, sizeof(done)) != sizeof(done))
+	{
+		fprintf(stderr, "shard_run(): couldn't report a shard done.\n");
+	}
+	return NULL;
+} //end void *shard_worker()
+
+uint8_t shard_run(shard_pool *pool)
+{
+	/* This function drives a sharded fleet: every shard is run by a worker
+	 * thread of its own (see shard_worker()), with its own event loop and
+	 * timing wheel, so a fleet too big for one core spreads over as many as
+	 * there are shards. The main thread only reads pilot input and routes it
+	 * (see parse_input()): input for one aircraft is posted to the shard
+	 * that owns it, and input for all of them is posted once to every
+	 * shard. The run ends as fleet_run() does, once every aircraft has
+	 * halted, or once stdin is closed (which every shard is told) and no
+	 * timer is left to fire. Returns REF_INACTIVE if the workers couldn't
+	 * all be started, in which case those that were are stopped at once.
+	 */
+	uint32_t started = 0;
+	while ((started < pool->n_shards) && !pthread_create(&pool->shards[started].worker, NULL, shard_worker, &pool->shards[started]))
+	{
+		started++;
+	}
+	uint8_t listening = (started == pool->n_shards);
+	if (!listening)
+	{
+		fprintf(stderr, "shard_run(): couldn't start the workers.\n");
+	}
+	uint32_t finished = 0;
+	char input[INPUT_SIZE];
+	while (listening && (finished < started))
+	{
+		struct epoll_event ep_event;
+		int ready = epoll_wait(pool->epoll_fd, &ep_event, 1, FOREVER);
+		if ((ready < 0) && (errno == EINTR))
+		{
+			continue;
+		}
+		if ((ready > 0) && (ep_event.data.fd == pool->done_fd))
+		{
+			uint64_t done;
+			if (read(pool->done_fd, &done, sizeof(done)) == sizeof(done)) finished += (uint32_t)done;
+		}
+		else if ((ready > 0) && (get_input(input, INPUT_SIZE) != NULL))
+		{
+			uint32_t first;
+			uint32_t last;
+			uint8_t event = parse_input(input, pool->count, &first, &last);
+			if (event == FSM_STAY)
+			{
+				continue;
+			}
+			if (last - first > 1)
+			{
+				for (uint32_t index = 0; index < started; index++)
+				{
+					shard_post(&pool->shards[index], SHARD_ALL, event);
+				}
+			}
+			else
+			{
+				shard *sh = &pool->shards[first / pool->per_shard];
+				shard_post(sh, first - sh->first, event);
+			}
+		}
+		else
+		{
+			listening = REF_INACTIVE;	//stdin was closed, or epoll failed
+		}
+	} //end while (listening)
+
+	for (uint32_t index = 0; index < started; index++)
+	{
+		shard_post(&pool->shards[index], SHARD_CLOSE, EVENT_CLOSE);
+	}
+	for (uint32_t index = 0; index < started; index++)
+	{
+		pthread_join(pool->shards[index].worker, NULL);
+	}
+	return (started == pool->n_shards)? REF_ACTIVATE : REF_INACTIVE;
+} //end uint8_t shard_run()
@@ -14,13 +14,23 @@
  * 2) the only information passed from the previous step to the next is the
  * explicitly specified state.
  *
- * Using an array of function pointers addresses these requirements, where each
- * index of the array is one "state" that calls a function to prime the machine
- * for the next state. The main reason for choosing this approach is that arrays
- * and function pointers offer performance benefits along with a reduced size
- * overhead compared to structs and switch case statements: keeping in mind that
- * this kind of project targets an aircraft's landing gear embedded system, the
- * speed and size aspects were prioritised.
+ * A transition table addresses these requirements: a flat array with one entry
+ * per state and event, holding the state the event moves the machine to, a
+ * guard that can veto the move and an action run on the way (see
+ * fsm_dispatch() in fsm_engine/.) Handling an event is one indexed load from
+ * the table, the whole aircraft table fits into a single cache line, and the
+ * landing gear model (craft_model.c) is data rather than code, so the same
+ * small engine runs any other machine. The table itself is generated at
+ * build time from a description of the machine (craft.fsm), along with a
+ * dispatcher specialised for it that the engine runs instead. Keeping in mind
+ * that this kind of project targets an aircraft's landing gear embedded
+ * system, the speed and size aspects were prioritised.
+ *
+ * The machine doesn't wait itself; one event loop owned by main() does (see
+ * loop_wait()), with a single epoll instance that stdin is registered on for
+ * the lifetime of the process. Every state describes whether it listens to
+ * input and how long it waits, which main() registers whenever the machine
+ * moves, so a transition normally costs a single epoll_wait() call.
  *
  * The logic implemented here is:
  * 1) Initialise a simulated aircraft in its grounded state;
@@ -35,7 +45,7 @@
  * 5) During the cruise state the aircraft's landing gear control system remains
  * disabled to conserve power. The software is still monitoring for pilot input
  * however to then set the aircraft into a desceding state. As implemented, the
- * simulation waits at craft_cruise for an infinite amount of time (a timeout of
+ * simulation waits at cruise for an infinite amount of time (a timeout of
  * -1) until the input to begin descending is received;
  * 6) After descending to an appropriate altitude, begin the landing state: if
  * the landing has to be aborted, the next state is takeoff with another input
@@ -69,40 +79,145 @@
 /* GLOBAL VARIABLES */
 uint8_t current_state = STATE_GROUND;
 aircraft A320;
+event_loop fsm_loop;
 
 /* MAIN */
-int main(void)
+int main(int argc, char *argv[])
 {
-	/* The way this program is structured is using an array of function pointers
-	 * to determine which state the aircraft is in based off user input. All six
-	 * states correspond to one and only one function and the aircraft can be in
-	 * only one of the six states at any given time. An infinite loop sets up
-	 * the entire simulation with a check for whether the simulation is still
-	 * active or not. An active simulation will continue to iterate infinitely.
-	 * An inactive simulation will exit the program.
+	/* The aircraft is run by the fsm engine as craft_machine, which is in one
+	 * and only one of its six states at any given time. An infinite loop sets
+	 * up the entire simulation with a check for whether the simulation is
+	 * still active or not. An active simulation will continue to iterate
+	 * infinitely: the event loop waits for whatever the current state
+	 * describes, and the event is dispatched to the machine, which moves to
+	 * the state its table says. A halted machine (an answer other than "y" on
+	 * the ground, or closed stdin) will exit the program.
+	 * Run as "fsm_practical -f <count>", the program simulates a whole fleet
+	 * of count aircraft instead, each one its own instance of the machine
+	 * with its own state and timers, all driven by the same event loop (see
+	 * fleet_run().) With "-s <scenario>", the simulation (of one aircraft, or
+	 * of a fleet) runs in virtual time instead, its input read from the
+	 * scenario file (see fleet_simulate().) "-t <trace>" records every event
+	 * of either to the trace file (see trace_open()), a single aircraft then
+	 * being run as a fleet of one, and "-r <trace>" replays a recorded trace
+	 * and checks that it plays out the same way (see trace_replay().) With
+	 * "-j <threads>" a live fleet is split into that many shards instead,
+	 * each one run by a thread of its own (see shard_run().) Built with
+	 * "make STATS=1", every dispatch is timed and counted, and the
+	 * statistics are written to stderr at exit or on SIGUSR1 (see
+	 * stats_dump().)
 	 */
-	uint8_t (*const state_array[6])(void) =
+# ifdef FSM_STATS
+	stats_open();
+# endif
+	const fsm_state *states = craft_machine.states;
+	unsigned long fleet_size = 0;
+	unsigned long n_shards = 0;
+	const char *scenario_path = NULL;
+	const char *trace_path = NULL;
+	const char *replay_path = NULL;
+	uint8_t usage = REF_INACTIVE;
+	int option;
+	while ((option = getopt(argc, argv, "f:j:s:t:r:")) != -1)
+	{
+		char *end = NULL;
+		unsigned long number = 0;
+		if (option == 'f') number = fleet_size = strtoul(optarg, &end, 10);
+		else if (option == 'j') number = n_shards = strtoul(optarg, &end, 10);
+		else if (option == 's') scenario_path = optarg;
+		else if (option == 't') trace_path = optarg;
+		else if (option == 'r') replay_path = optarg;
+		else usage = REF_ACTIVATE;
+		if ((end != NULL) && ((*end != '\0') || (number == 0))) usage = REF_ACTIVATE;
+	}
+	usage |= (fleet_size > FLEET_MAX) || (n_shards > SHARD_MAX) || ((n_shards > 0) && (!fleet_size || scenario_path || trace_path));
+	usage |= (replay_path != NULL) && (fleet_size || scenario_path || trace_path);
+	if (usage || (optind != argc))
 	{
-		/* Setting up the array of 6 function pointers. Each function returns a
-		 * uint8_t and take no arguments. Typedefs for the function pointers are
-		 * not used because only the array uses the function pointers, there is
-		 * no other access route within the program.
+		fprintf(stderr, "usage: %s [-f <count, 1 to %d>] [-s <scenario>] [-t <trace>]\n"
+			"       %s -f <count> -j <threads, 1 to %d>\n"
+			"       %s -r <trace>\n", argv[0], FLEET_MAX, argv[0], SHARD_MAX, argv[0]);
+		return 1;
+	}
+
+	if (replay_path != NULL)
+	{
+		return (trace_replay(replay_path) != REF_INACTIVE)? 0 : 1;
+	}
+	if (n_shards > 0)
+	{
+		shard_pool pool;
+		uint8_t status = shard_open(&pool, &craft_fleet_machine, (uint32_t)fleet_size, (uint32_t)n_shards, clock_ns() / NS_PER_MS);
+		if (status != REF_INACTIVE)
+		{
+			status = shard_run(&pool);
+			shard_report(&pool);
+			shard_close(&pool);
+		}
+		return (status != REF_INACTIVE)? 0 : 1;
+	}
+	if ((scenario_path != NULL) || (fleet_size > 0) || (trace_path != NULL))
+	{
+		/* fleet simulation, live or in virtual time: a single aircraft is a
+		 * fleet of one that talks as much as the plain one
 		 */
-		&craft_grounded,
-		&craft_takeoff,
-		&craft_ascend,
-		&craft_cruise,
-		&craft_descend,
-		&craft_landing
-	};
+		FILE *scenario = NULL;
+		if (scenario_path != NULL)
+		{
+			scenario = fopen(scenario_path, "r");
+			if (scenario == NULL)
+			{
+				perror(scenario_path);
+				return 1;
+			}
+		}
+		else if (loop_open() == REF_INACTIVE)
+		{
+			return 1;
+		}
+		fleet fl;
+		trace_ring trace;
+		const fsm_machine *machine = (fleet_size > 0)? &craft_fleet_machine : &craft_machine;
+		int64_t now = (scenario != NULL)? 0 : clock_ns() / NS_PER_MS;
+		uint8_t status = fleet_open(&fl, machine, (fleet_size > 0)? (uint32_t)fleet_size : 1, STATE_GROUND, now);
+		if ((status != REF_INACTIVE) && (trace_path != NULL))
+		{
+			status = trace_open(&trace, trace_path, &fl);
+			fl.trace = (status != REF_INACTIVE)? &trace : NULL;
+		}
+		if (status != REF_INACTIVE)
+		{
+			if (scenario != NULL) status = fleet_simulate(&fl, scenario);
+			else fleet_run(&fl);
+			if (status != REF_INACTIVE)
+			{
+				if (fleet_size == 0) putchar('\n');
+				fleet_report(&fl);
+				if (scenario != NULL) printf("fleet: %.3f s simulated in %.3f s.\n", (double)fl.now / 1000.0, (double)fl.busy_ns / 1e9);
+			}
+			if ((fl.trace != NULL) && (trace_close(&trace) == REF_INACTIVE)) status = REF_INACTIVE;
+		}
+		fleet_close(&fl);
+		if (scenario != NULL) fclose(scenario);
+		else loop_close();
+		return (status != REF_INACTIVE)? 0 : 1;
+	}
 
 	/* flight simulation */
-	current_state = STATE_GROUND;
+	if (loop_open() == REF_INACTIVE)
+	{
+		return 1;
+	}
+	fsm_start(&craft_machine, &current_state, STATE_GROUND, &A320);
+	loop_register(states[current_state].watch_input, states[current_state].timeout);
 	uint8_t sim_return = REF_ACTIVATE;
 	while (sim_return != REF_INACTIVE)
 	{
-		sim_return = state_array[current_state]();
-		putchar('\n');
+		uint8_t event = loop_wait();
+		sim_return = fsm_dispatch(&craft_machine, &current_state, event, &A320);
+		loop_register(states[current_state].watch_input, states[current_state].timeout);
 	}
+	putchar('\n');
+	loop_close();
 	return 0;
 } //end main()
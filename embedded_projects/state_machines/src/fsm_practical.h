@@ -2,14 +2,47 @@
 # define FSM_PRACTICAL_H_
 
 /* INCLUSIONS AND DEFINITIONS */
+# include <errno.h> //EINTR
 # include <stdio.h>
+# include <stdlib.h> //calloc(), aligned_alloc(), free(), strtoul()
 # include <string.h> //strcspn(), strncmp()
-# include <unistd.h> //close(), read(), sleep()
+# include <time.h> //clock_gettime(), nanosleep()
+# include <sched.h> //sched_yield()
+# include <pthread.h> //the trace's writer thread, the shards' workers
+# include <stdatomic.h> //the trace and shard rings' heads and tails
+# include <unistd.h> //close(), read(), write(), sleep(), getopt()
 # include <sys/epoll.h> //epoll() family of functions
+# include <sys/eventfd.h> //eventfd(), how shards are woken up
 
 # define WAIT			5000 //used by epoll_wait() to time the interrupt checks
-# define INPUT_SIZE		6 //used to set the size of input buffers
-# define LONG_SNOOZE	7 //used by sleep() to simulate flying
+# define FOREVER		-1 //used by epoll_wait() to wait for input without a timeout
+# define STDIN_FD		0 //the file descriptor pilot input is read from
+# define STDERR_FD		2 //the file descriptor statistics are dumped to
+# define INPUT_SIZE		16 //used to set the size of input buffers, room for "<id> y" in fleet mode
+# define FSM_STAY		0xFF //transition target of an event a state ignores
+# define FSM_HALT		0xFE //transition target that stops the machine
+# define FLEET_MAX		1000000 //the largest fleet "-f" accepts
+# define NS_PER_MS		1000000 //used to turn clock_ns() readings into epoll timeouts
+# define FLEET_BATCH	64 //timeouts due at once in 1 of this many aircraft (and at least this many) are batched
+# define SCENARIO_LINE	64 //used to set the size of a scenario file's line buffer
+# define TRACE_RING		65536 //events a trace ring holds, a power of two (1 MiB)
+# define TRACE_CHUNK	4096 //events a trace replay reads at a time
+# define TRACE_MAGIC	"FSMT" //the first bytes of a trace file
+# define TRACE_NAP		1000000 //nanoseconds the trace writer sleeps when there's nothing to write
+# define SHARD_MAX		64 //the most shards "-j" accepts
+# define SHARD_RING		4096 //messages a shard's ring holds, a power of two
+# define SHARD_ALL		0xFFFFFFFF //aircraft of a shard message for every aircraft of the shard
+# define SHARD_CLOSE	0xFFFFFFFE //aircraft of a shard message telling it stdin was closed
+# define STATS_SUB_BITS	3 //bits of a latency below its leading one a statistics bucket tells apart
+# define STATS_BUCKETS	304 //buckets of a latency histogram, enough for 2^40 ns at 3 sub-bits
+# define STATS_BLOCKS	65 //threads that get statistics of their own, SHARD_MAX + 1
+# define STATS_LINE		512 //used to set the size of the statistics dump's buffer
+# define WHEEL_LEVELS	4 //levels of a timing wheel, enough for 2^32 ms
+# define WHEEL_BITS		8 //bits of a tick every level of a timing wheel covers
+# define WHEEL_SLOTS	256 //slots of every level of a timing wheel, 1 << WHEEL_BITS
+# define WHEEL_NIL		0xFFFFFFFF //the end of a timing wheel slot's list
+# define WHEEL_IDLE		0xFFFF //the slot of a timer that isn't armed
+# define WHEEL_REBASE	0x80000000 //ticks a re-based wheel keeps behind the time it was re-based for, 2^31 ms
 
 # define REF_ZERO		0x00
 # define REF_INACTIVE	REF_ZERO //used as a function return value
@@ -19,6 +52,8 @@
 # define GEAR_DOWN		REF_ZERO //used by landing_gear to simulate gear_down
 # define LIT_GREEN		REF_ZERO //used by cockpit_lights to set green colour
 # define STATE_GROUND	REF_ZERO //first of the 6 aircraft states
+# define EVENT_INPUT	REF_ZERO //dispatched when pilot input arrived
+# define CTRL_LEVER		REF_ZERO //column of pilot_lever in a fleet
 
 # define REF_ONE		0x01
 # define REF_ACTIVATE	REF_ONE //used as a function return value
@@ -28,23 +63,42 @@
 # define GEAR_UP		REF_ONE //used by landing_gear to simulate gear_change
 # define LIT_RED		REF_ONE //used by cockpit_lights to set red colour
 # define STATE_TAKEOFF	REF_ONE //second of the 6 aircraft states
+# define EVENT_TIMEOUT	REF_ONE //dispatched when the current state's wait ran out
+# define CTRL_LIMIT		REF_ONE //column of limit_switch in a fleet
+# define DRIVE_LIMIT	REF_ONE //drive mask of limit_switch's bit in craft_drives
+# define DRIVE_SQUAT	REF_ONE //drive mask of squat_switch's bit in craft_drives
+# define DRIVE_GEAR		REF_ONE //drive mask of landing_gear's bit in craft_drives
+# define DRIVE_VALVE	REF_ONE //drive mask of direction_valve's bit in craft_drives
 
 # define REF_TWO		0x02
 # define LEV_FALL		REF_TWO //used by pilot_lever to simulate lever_falling
 # define LIT_OFF		REF_TWO //used by cockpit_lights to turn off the lights
 # define STATE_ASCEND	REF_TWO //third of the 6 aircraft states
+# define FSM_MOVED		REF_TWO //returned by fsm_dispatch() when the machine entered a state
+# define CTRL_SQUAT		REF_TWO //column of squat_switch in a fleet
+# define EVENT_CONFIRM	REF_TWO //dispatched when the pilot input was a "y"
 
 # define REF_THREE		0x03
 # define LEV_DOWN		REF_THREE //used by pilot_lever to simulate lever_down
-# define SHORT_SNOOZE	REF_THREE //used by sleep() for a shorter wait time
+# define DRIVE_LEVER	REF_THREE //drive mask of pilot_lever's 2 bits in craft_drives
+# define DRIVE_LIGHTS	REF_THREE //drive mask of cockpit_lights' 2 bits in craft_drives
 # define STATE_CRUISE	REF_THREE //fourth of the 6 aircraft states
+# define EVENT_CLOSE	REF_THREE //dispatched once stdin is closed or broken
+# define CTRL_GEAR		REF_THREE //column of landing_gear in a fleet
 
 # define REF_FOUR		0x04
 # define STATE_DESCEND	REF_FOUR //fifth of the 6 aircraft states
+# define EVENT_COUNT	REF_FOUR //number of aircraft events, the columns of its transition table
+# define CTRL_LIGHTS	REF_FOUR //column of cockpit_lights in a fleet
 
 # define REF_FIVE		0x05
-# define SNOOZE			REF_FIVE //used by sleep() to simulate taxiing
+# define SNOOZE			REF_FIVE //seconds the descend state lasts before it times out (see craft.fsm)
 # define STATE_LANDING	REF_FIVE //sixth and final of the 6 aircraft states
+# define CTRL_VALVE		REF_FIVE //column of direction_valve in a fleet
+
+# define REF_SIX		0x06
+# define STATE_COUNT	REF_SIX //number of aircraft states, the rows of its transition table
+# define CONTROL_COUNT	REF_SIX //number of aircraft controls, the columns of a fleet
 
 /* STRUCTS & ENUMS */
 typedef struct
@@ -67,22 +121,376 @@ typedef struct
 			direction_valve	: 1; //2 states, requires 1 bit
 } aircraft;
 
+//an action run by the engine: on a transition, or on entering a state
+typedef void (*fsm_action)(void *ctx, uint8_t state, uint8_t event);
+//a guard consulted before a transition: 0 vetoes it
+typedef uint8_t (*fsm_guard)(const void *ctx, uint8_t state, uint8_t event);
+//a machine's own dispatcher, generated along with it (see fsm_gen/fsm_gen.c)
+typedef uint8_t (*fsm_dispatcher)(uint8_t *state, uint8_t event, void *ctx);
+
+typedef struct
+{
+	/* One entry of a transition table: what a state does with one event.
+	 * The event moves the machine to next (FSM_STAY ignores it, FSM_HALT
+	 * stops the machine) if guard allows it, running action on the way.
+	 * guard and action are indices into the machine's guards and actions, 0
+	 * meaning none, so that an entry is three bytes and a whole table stays
+	 * in a cache line or two.
+	 */
+	uint8_t next;
+	uint8_t guard;
+	uint8_t action;
+} fsm_transition;
+
+typedef struct
+{
+	/* What a state does when it is entered: its entry action (an index into
+	 * the machine's actions, 0 for none), and what it waits for: whether
+	 * input moves it on and how long it waits before it times out (FOREVER
+	 * for never), which the driver registers with its event loop.
+	 */
+	uint8_t entry;
+	uint8_t watch_input;
+	int32_t timeout;
+} fsm_state;
+
+typedef struct
+{
+	/* A finite state machine described entirely by data, which fsm_dispatch()
+	 * runs: table holds n_states rows of n_events transitions each, flat, so
+	 * the transition of a state and an event is the single entry
+	 * table[state * n_events + event]. states describes every state, and
+	 * actions and guards are the functions the entries refer to by index
+	 * (entry 0 of both is unused.) The same engine runs any machine; the
+	 * instance a machine acts on is the ctx passed to every call. A machine
+	 * generated from a description also has a dispatcher of its own, which
+	 * does what the table says without reading it; it's NULL for a machine
+	 * written by hand.
+	 */
+	const fsm_transition *table;
+	const fsm_state *states;
+	const fsm_action *actions;
+	const fsm_guard *guards;
+	uint8_t n_states;
+	uint8_t n_events;
+	fsm_dispatcher dispatch;
+} fsm_machine;
+
+typedef struct
+{
+	/* The event loop that drives every state: a single epoll instance that
+	 * lives as long as the process does, with stdin registered on it once.
+	 * Rather than setting up epoll themselves, states register what they
+	 * wait for when they are entered (see loop_register()): whether pilot
+	 * input moves them on, and how long they wait before their timeout does.
+	 * watching is what stdin is currently registered for, so that the
+	 * registration is only changed on the rare transitions that stop or
+	 * resume listening. The line of input that was last read is kept in
+	 * input for the state handling it.
+	 */
+	int epoll_fd;
+	int timeout;
+	uint8_t watch_input;
+	uint8_t watching;
+	char input[INPUT_SIZE];
+} event_loop;
+
+typedef struct
+{
+	/* One timer of a timing wheel, linked into the list of the slot it waits
+	 * in: its neighbours there (WHEEL_NIL at either end), the tick it expires
+	 * at and the slot itself (WHEEL_IDLE while the timer isn't armed.)
+	 */
+	uint32_t next;
+	uint32_t prev;
+	uint32_t expiry;
+	uint16_t slot;
+} wheel_timer;
+
+typedef struct
+{
+	/* A hierarchical timing wheel of millisecond ticks: WHEEL_LEVELS wheels
+	 * of WHEEL_SLOTS slots each, every level's slot spanning a whole turn of
+	 * the level below (1 ms, 256 ms, 65.5 s and 4.7 h.) A timer waits in the
+	 * lowest level whose turn it expires in, and is moved down a level each
+	 * time the wheel below comes round to it, so arming, cancelling and
+	 * expiring a timer are all O(1) however many are pending. There is one
+	 * timer per id, kept in timers[id], slots are doubly linked lists whose
+	 * first timers are in heads, and occupied has a bit set for every slot
+	 * that isn't empty, so that finding the next expiry skips empty slots a
+	 * word at a time. tick is the next tick to be expired, counted from
+	 * epoch, the clock's reading (in milliseconds) when the wheel was set up
+	 * or last re-based (see wheel_rebase().)
+	 */
+	wheel_timer *timers;
+	uint32_t heads[WHEEL_LEVELS * WHEEL_SLOTS];
+	uint64_t occupied[WHEEL_LEVELS][WHEEL_SLOTS / 64];
+	uint32_t tick;
+	int64_t epoch;
+	uint32_t pending;
+} timing_wheel;
+
+typedef struct
+{
+	/* Many independent instances of the aircraft machine, all driven by the
+	 * one event loop. The fleet is stored column-wise rather than as an array
+	 * of aircraft: aircraft i is in states[i] (FSM_HALT once its machine
+	 * stopped), its controls are controls[CTRL_...][i], one byte each, and the
+	 * timeout of its state is timer i of the fleet's timing wheel. That way a
+	 * timeout due for many aircraft at once is applied by a few passes over
+	 * contiguous bytes that the compiler vectorises (see fleet_expire()),
+	 * rather than by a dispatch per aircraft. The passes take the effect of
+	 * a timeout from batch_next, where every state's timeout transition
+	 * leads (FSM_STAY if it can't be batched), and from drives and levels,
+	 * which of the controls every state drives on entry and to what, 0xFF or
+	 * 0 and the value for every column. due and due_list are the aircraft
+	 * whose timeouts are being applied. Every event is recorded to trace,
+	 * unless it's NULL (see trace_open().) now is the fleet's clock in
+	 * milliseconds, read once per wakeup, and transitions and busy_ns
+	 * measure the work done between wakeups.
+	 */
+	const fsm_machine *machine;
+	uint8_t *columns;
+	uint8_t *controls[CONTROL_COUNT];
+	uint8_t *states;
+	uint8_t *due;
+	uint32_t *due_list;
+	uint32_t count;
+	uint32_t active;
+	uint8_t batch_next[STATE_COUNT];
+	uint8_t drives[STATE_COUNT][CONTROL_COUNT];
+	uint8_t levels[STATE_COUNT][CONTROL_COUNT];
+	timing_wheel wheel;
+	struct trace_ring *trace;
+	int64_t now;
+	uint64_t transitions;
+	int64_t busy_ns;
+} fleet;
+
+typedef struct
+{
+	/* One event of a trace, as dispatched to aircraft craft at time (in
+	 * milliseconds, by the fleet's clock): the state it was in and the state
+	 * it was in afterwards (the same if it ignored the event, FSM_HALT if it
+	 * halted.) Pilot input and timer expiries are both events, told apart by
+	 * event, so one 16 byte record covers an input or expiry and the
+	 * transition it caused.
+	 */
+	int64_t time;
+	uint32_t craft;
+	uint8_t event;
+	uint8_t state;
+	uint8_t next;
+	uint8_t reserved;
+} trace_event;
+
+typedef struct
+{
+	/* What a trace file starts with: TRACE_MAGIC, the size of the fleet, the
+	 * time its clock started at and whether it ran the talking machine (a
+	 * single aircraft) or the silent one, which is all a replay needs to set
+	 * the fleet up again.
+	 */
+	char magic[4];
+	uint32_t count;
+	int64_t start;
+	uint8_t talking;
+	uint8_t reserved[7];
+} trace_header;
+
+typedef struct trace_ring
+{
+	/* A trace being recorded: events are appended to a ring of TRACE_RING
+	 * records by the fleet, and written to file by a thread of their own, so
+	 * recording an event is a store to memory and the simulation never waits
+	 * for I/O (unless the writer falls a whole ring behind.) head is where
+	 * the next event goes and tail where the writer carries on, both counting
+	 * events ever recorded, and they live on cache lines of their own so the
+	 * two threads don't contend for one. The fleet's side keeps a copy of
+	 * tail, only re-read when the ring looks full. stalls counts the events
+	 * that had to wait for room.
+	 */
+	trace_event *ring;
+	FILE *file;
+	pthread_t writer;
+	uint64_t stalls;
+	uint64_t cached_tail;
+	_Alignas(64) _Atomic uint64_t head;
+	_Alignas(64) _Atomic uint64_t tail;
+	_Atomic uint8_t stop;
+	uint8_t failed;
+} trace_ring;
+
+typedef struct
+{
+	/* A slot of a shard's ring: an event for aircraft craft of the shard
+	 * (or SHARD_ALL, or SHARD_CLOSE), and the slot's sequence number, which
+	 * tells producers and the consumer whose turn it is (see shard_post().)
+	 */
+	_Atomic uint64_t sequence;
+	uint32_t craft;
+	uint8_t event;
+} shard_message;
+
+typedef struct
+{
+	/* One shard of a sharded fleet: a fleet of its own (with its own timing
+	 * wheel) run by a worker thread of its own, waiting on an epoll instance
+	 * of its own. The shard's aircraft are first to first + fl.count - 1 of
+	 * the whole fleet. Events reach it through ring, a bounded lock-free
+	 * queue any number of threads post to and only the worker takes from:
+	 * head is where the next message is posted, tail where the worker
+	 * carries on, each on its own cache line. A poster only writes to
+	 * wake_fd, which wakes the worker up, if signalled says the worker
+	 * hasn't been woken up since it last looked at the ring. finished is set
+	 * once the worker has returned, so nothing waits for room in its ring
+	 * any more.
+	 */
+	fleet fl;
+	uint32_t first;
+	pthread_t worker;
+	int epoll_fd;
+	int wake_fd;
+	int done_fd;
+	shard_message *ring;
+	_Alignas(64) _Atomic uint64_t head;
+	_Alignas(64) uint64_t tail;
+	_Atomic uint8_t signalled;
+	_Atomic uint8_t finished;
+} shard;
+
+typedef struct
+{
+	/* A fleet of count aircraft split into n_shards shards of per_shard
+	 * aircraft (the last one gets whatever is left), so that it can be run by
+	 * as many cores (see shard_run().) The main thread reads pilot input and
+	 * routes it, waiting on epoll_fd for stdin and for done_fd, which every
+	 * worker writes to once it is done.
+	 */
+	shard *shards;
+	uint32_t n_shards;
+	uint32_t count;
+	uint32_t per_shard;
+	int epoll_fd;
+	int done_fd;
+} shard_pool;
+
+# ifdef FSM_STATS
+# include <signal.h> //sigaction(), SIGUSR1 dumps the statistics
+
+//adds to a statistics counter only its own thread writes, without a locked instruction
+# define STATS_ADD(counter, amount) atomic_store_explicit(&(counter), \
+	atomic_load_explicit(&(counter), memory_order_relaxed) + (amount), memory_order_relaxed)
+
+typedef struct
+{
+	/* The statistics one thread gathered (see stats_record()): how often
+	 * every state was entered by a transition, and for every state and event
+	 * how often that moved the machine, how often it was applied in batch
+	 * instead, the longest dispatch and a histogram of how long they all
+	 * took, whose counts add up to how often it was dispatched. The
+	 * histograms are log-linear, as HDR histograms are: a latency's bucket
+	 * is its leading bit and the STATS_SUB_BITS bits below it, so every
+	 * bucket is within 1/8 of the latencies it counts, from nanoseconds up
+	 * to minutes, in a fixed few hundred counters. Counters are atomics only
+	 * so that a dump can read them while their thread writes them: each is
+	 * only ever written by one thread, so no update needs a locked
+	 * instruction.
+	 */
+	_Atomic uint64_t entries[STATE_COUNT];
+	_Atomic uint64_t moved[STATE_COUNT][EVENT_COUNT];
+	_Atomic uint64_t batched[STATE_COUNT][EVENT_COUNT];
+	_Atomic uint64_t max_ns[STATE_COUNT][EVENT_COUNT];
+	_Atomic uint64_t buckets[STATE_COUNT][EVENT_COUNT][STATS_BUCKETS];
+} stats_block;
+# endif
+
 /* GLOBAL VARIABLES */
 //defined in fsm_practical.c [main()]
 extern uint8_t current_state;
 extern aircraft A320;
+extern event_loop fsm_loop;
+//generated from craft.fsm into craft_machine.c
+extern const fsm_machine craft_machine;
+extern const fsm_machine craft_fleet_machine;
+extern const char *const fsm_state_names[STATE_COUNT];
+extern const char *const fsm_event_names[EVENT_COUNT];
+//defined in craft_model.c
+extern const aircraft craft_drives[STATE_COUNT];
+extern const aircraft craft_outputs[STATE_COUNT];
+# ifdef FSM_STATS
+//defined in stats_claim.c
+extern stats_block stats_blocks[STATS_BLOCKS];
+extern _Atomic uint32_t stats_threads;
+# endif
 
 /* USERDEF FUNCTION PROTOTYPES */
 //miscellaneous functions
 void print_state(aircraft *craft);
 char *get_input(char *dest_array, int input_size);
+int64_t clock_ns(void);
+uint8_t parse_input(const char *line, uint32_t count, uint32_t *first, uint32_t *last);
+void craft_unpack(const aircraft *craft, uint8_t *const controls[CONTROL_COUNT], uint32_t index);
+void craft_pack(aircraft *craft, uint8_t *const controls[CONTROL_COUNT], uint32_t index);
+
+//craft functions, the actions and guards of craft.fsm
+void craft_drive(void *ctx, uint8_t state, uint8_t event);
+void craft_enter(void *ctx, uint8_t state, uint8_t event);
+void craft_announce(void *ctx, uint8_t state, uint8_t event);
+void craft_silent(void *ctx, uint8_t state, uint8_t event);
+uint8_t craft_on_ground(const void *ctx, uint8_t state, uint8_t event);
+
+//fsm engine functions
+void fsm_start(const fsm_machine *machine, uint8_t *state, uint8_t initial, void *ctx);
+uint8_t fsm_dispatch(const fsm_machine *machine, uint8_t *state, uint8_t event, void *ctx);
+
+//event loop functions
+uint8_t loop_open(void);
+void loop_register(uint8_t watch_input, int timeout);
+uint8_t loop_wait(void);
+void loop_close(void);
+
+//fleet functions
+uint8_t fleet_open(fleet *fl, const fsm_machine *machine, uint32_t count, uint8_t initial, int64_t now);
+void fleet_arm(fleet *fl, uint32_t craft);
+void fleet_dispatch(fleet *fl, uint32_t craft, uint8_t event);
+int fleet_expire(fleet *fl);
+void fleet_batch(fleet *fl);
+void fleet_input(fleet *fl, const char *line);
+void fleet_run(fleet *fl);
+uint8_t fleet_simulate(fleet *fl, FILE *scenario);
+void fleet_report(const fleet *fl);
+void fleet_close(fleet *fl);
+
+//trace functions
+uint8_t trace_open(trace_ring *trace, const char *path, const fleet *fl);
+void trace_record(trace_ring *trace, int64_t time, uint32_t craft, uint8_t event, uint8_t state, uint8_t next);
+uint8_t trace_close(trace_ring *trace);
+uint8_t trace_replay(const char *path);
+
+//shard functions
+uint8_t shard_open(shard_pool *pool, const fsm_machine *machine, uint32_t count, uint32_t n_shards, int64_t now);
+void shard_post(shard *sh, uint32_t craft, uint8_t event);
+uint8_t shard_run(shard_pool *pool);
+void shard_report(const shard_pool *pool);
+void shard_close(shard_pool *pool);
+
+# ifdef FSM_STATS
+//statistics functions, only built with "make STATS=1"
+void stats_open(void);
+stats_block *stats_claim(void);
+void stats_record(uint8_t state, uint8_t event, uint8_t next, uint8_t moved, int64_t ns);
+void stats_batched(uint8_t state, uint8_t event, uint8_t next);
+void stats_dump(int fd);
+# endif
 
-//craft_state functions
-uint8_t craft_grounded(void);
-uint8_t craft_takeoff(void);
-uint8_t craft_ascend(void);
-uint8_t craft_cruise(void);
-uint8_t craft_descend(void);
-uint8_t craft_landing(void);
+//timing wheel functions
+uint8_t wheel_open(timing_wheel *wheel, uint32_t n_timers, int64_t now);
+void wheel_insert(timing_wheel *wheel, uint32_t id, int64_t deadline);
+void wheel_cancel(timing_wheel *wheel, uint32_t id);
+void wheel_rebase(timing_wheel *wheel, int64_t epoch);
+uint32_t wheel_advance(timing_wheel *wheel, int64_t now, uint32_t *expired);
+int wheel_next(const timing_wheel *wheel, int64_t now);
+void wheel_close(timing_wheel *wheel);
 
 # endif /* FSM_PRACTICAL_H_ */
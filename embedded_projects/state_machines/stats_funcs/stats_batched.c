@@ -0,0 +1,17 @@
+# include "../src/fsm_practical.h"
+
+void stats_batched(uint8_t state, uint8_t event, uint8_t next)
+{
+	/* This function counts an event applied to an aircraft in batch (see
+	 * fleet_batch()) rather than dispatched to it, which moved it from state
+	 * to next. No latency is recorded, as a batch takes no time per aircraft
+	 * that could be told apart.
+	 */
+	if ((state >= STATE_COUNT) || (event >= EVENT_COUNT) || (next >= STATE_COUNT))
+	{
+		return;
+	}
+	stats_block *block = stats_claim();
+	STATS_ADD(block->batched[state][event], 1);
+	STATS_ADD(block->entries[next], 1);
+} //end void stats_batched()
@@ -0,0 +1,22 @@
+# include "../src/fsm_practical.h"
+
+/* GLOBAL VARIABLES */
+stats_block stats_blocks[STATS_BLOCKS];
+_Atomic uint32_t stats_threads;
+static _Thread_local stats_block *stats_mine;
+
+stats_block *stats_claim(void)
+{
+	/* This function returns the statistics block of the calling thread,
+	 * claiming the next free one the first time the thread records anything.
+	 * Threads beyond STATS_BLOCKS share the last block, which only risks
+	 * losing a count now and then. Blocks are never given back: a dump sums
+	 * every claimed block, so a finished thread's statistics aren't lost.
+	 */
+	if (stats_mine == NULL)
+	{
+		uint32_t claimed = atomic_fetch_add_explicit(&stats_threads, 1, memory_order_relaxed);
+		stats_mine = &stats_blocks[(claimed < STATS_BLOCKS)? claimed : STATS_BLOCKS - 1];
+	}
+	return stats_mine;
+} //end stats_block *stats_claim()
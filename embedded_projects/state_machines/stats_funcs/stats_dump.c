@@ -0,0 +1,195 @@
+# include "../src/fsm_practical.h"
+
+typedef struct
+{
+	//a line of the dump being put together, written out whenever it fills up
+	char text[STATS_LINE];
+	size_t len;
+	int fd;
+} stats_line;
+
+static void line_flush(stats_line *line)
+{
+	size_t written = 0;
+	while (written < line->len)
+	{
+		ssize_t chunk = write(line->fd, line->text + written, line->len - written);
+		if ((chunk < 0) && (errno == EINTR))
+		{
+			continue;
+		}
+		if (chunk <= 0)
+		{
+			break;	//nowhere to dump to, the rest is dropped
+		}
+		written += (size_t)chunk;
+	}
+	line->len = 0;
+}
+
+static void line_text(stats_line *line, const char *text)
+{
+	for (; *text != '\0'; text++)
+	{
+		if (line->len == STATS_LINE)
+		{
+			line_flush(line);
+		}
+		line->text[line->len++] = *text;
+	}
+}
+
+static void line_number(stats_line *line, uint64_t number)
+{
+	//snprintf() isn't async-signal-safe, so numbers are formatted by hand
+	char digits[24];
+	size_t at = sizeof(digits);
+	digits[--at] = '\0';
+	do
+	{
+		digits[--at] = (char)('0' + (number % 10));
+		number /= 10;
+	} while (number > 0);
+	line_text(line, &digits[at]);
+}
+
+static void line_field(stats_line *line, const char *name, uint64_t number)
+{
+	line_text(line, ",\"");
+	line_text(line, name);
+	line_text(line, "\":");
+	line_number(line, number);
+}
+
+static uint64_t bucket_low(uint32_t bucket)
+{
+	//the shortest latency bucket counts (see stats_record())
+	if (bucket < (1 << STATS_SUB_BITS))
+	{
+		return bucket;
+	}
+	uint32_t magnitude = (bucket >> STATS_SUB_BITS) + STATS_SUB_BITS - 1;
+	return (uint64_t)((1 << STATS_SUB_BITS) + (bucket & ((1 << STATS_SUB_BITS) - 1))) << (magnitude - STATS_SUB_BITS);
+}
+
+static void line_latencies(stats_line *line, const uint64_t buckets[STATS_BUCKETS], uint64_t count, uint64_t max_ns)
+{
+	/* The 50th, 90th and 99th percentile and the longest of count latencies,
+	 * a percentile being the longest latency of the bucket it falls in (but
+	 * never longer than the longest latency seen.)
+	 */
+	static const uint8_t percents[] = {50, 90, 99};
+	static const char *const names[] = {"p50_ns", "p90_ns", "p99_ns"};
+	uint64_t seen = 0;
+	uint32_t bucket = 0;
+	for (uint32_t i = 0; i < sizeof(percents); i++)
+	{
+		uint64_t rank = ((count * percents[i]) + 99) / 100;
+		while ((bucket < STATS_BUCKETS - 1) && (seen + buckets[bucket] < rank))
+		{
+			seen += buckets[bucket++];
+		}
+		uint64_t high = (bucket < STATS_BUCKETS - 1)? bucket_low(bucket + 1) - 1 : max_ns;
+		line_field(line, names[i], (high < max_ns)? high : max_ns);
+	}
+	line_field(line, "max_ns", max_ns);
+}
+
+void stats_dump(int fd)
+{
+	/* This function writes the statistics of every thread, summed, to fd as
+	 * JSON lines: a header, then a line for every state (how often it was
+	 * entered and dispatched to, and its dispatch latencies) and one for
+	 * every transition that was ever dispatched or batched, with its
+	 * latencies and histogram as [shortest latency, count] pairs of the
+	 * buckets that aren't empty. Dispatch counts are the sums of the
+	 * histograms, which count every dispatch. It only reads the counters
+	 * and calls write(), so it is async-signal-safe and can run in the
+	 * SIGUSR1 handler while the counters are being written; a dump is then a
+	 * moment's snapshot, with the counters of one transition not necessarily
+	 * agreeing to the count.
+	 */
+	stats_line line = {.len = 0, .fd = fd};
+	uint32_t threads = atomic_load_explicit(&stats_threads, memory_order_relaxed);
+	uint32_t blocks = (threads < STATS_BLOCKS)? threads : STATS_BLOCKS;
+	uint64_t state_buckets[STATS_BUCKETS];
+	uint64_t buckets[STATS_BUCKETS];
+
+	line_text(&line, "{\"stats\":\"fsm\"");
+	line_field(&line, "threads", threads);
+	line_field(&line, "states", STATE_COUNT);
+	line_field(&line, "events", EVENT_COUNT);
+	line_field(&line, "sub_bits", STATS_SUB_BITS);
+	line_text(&line, "}\n");
+	for (uint8_t state = 0; state < STATE_COUNT; state++)
+	{
+		uint64_t state_count = 0, state_max = 0;
+		memset(state_buckets, 0, sizeof(state_buckets));
+		for (uint8_t event = 0; event < EVENT_COUNT; event++)
+		{
+			uint64_t count = 0, moved = 0, batched = 0, max_ns = 0;
+			memset(buckets, 0, sizeof(buckets));
+			for (uint32_t i = 0; i < blocks; i++)
+			{
+				const stats_block *block = &stats_blocks[i];
+				for (uint32_t j = 0; j < STATS_BUCKETS; j++)
+				{
+					buckets[j] += atomic_load_explicit(&block->buckets[state][event][j], memory_order_relaxed);
+				}
+				moved += atomic_load_explicit(&block->moved[state][event], memory_order_relaxed);
+				batched += atomic_load_explicit(&block->batched[state][event], memory_order_relaxed);
+				uint64_t block_max = atomic_load_explicit(&block->max_ns[state][event], memory_order_relaxed);
+				max_ns = (block_max > max_ns)? block_max : max_ns;
+			}
+			for (uint32_t j = 0; j < STATS_BUCKETS; j++)
+			{
+				state_buckets[j] += buckets[j];
+				count += buckets[j];
+			}
+			state_count += count;
+			state_max = (max_ns > state_max)? max_ns : state_max;
+			if ((count == 0) && (batched == 0))
+			{
+				continue;
+			}
+			line_text(&line, "{\"transition\":\"");
+			line_text(&line, fsm_state_names[state]);
+			line_text(&line, "\",\"event\":\"");
+			line_text(&line, fsm_event_names[event]);
+			line_text(&line, "\"");
+			line_field(&line, "dispatches", count);
+			line_field(&line, "moved", moved);
+			line_field(&line, "batched", batched);
+			line_latencies(&line, buckets, count, max_ns);
+			line_text(&line, ",\"histogram\":[");
+			const char *separator = "";
+			for (uint32_t i = 0; i < STATS_BUCKETS; i++)
+			{
+				if (buckets[i] != 0)
+				{
+					line_text(&line, separator);
+					line_text(&line, "[");
+					line_number(&line, bucket_low(i));
+					line_text(&line, ",");
+					line_number(&line, buckets[i]);
+					line_text(&line, "]");
+					separator = ",";
+				}
+			}
+			line_text(&line, "]}\n");
+		} //end for (event < EVENT_COUNT)
+		line_text(&line, "{\"state\":\"");
+		line_text(&line, fsm_state_names[state]);
+		line_text(&line, "\"");
+		uint64_t entries = 0;
+		for (uint32_t i = 0; i < blocks; i++)
+		{
+			entries += atomic_load_explicit(&stats_blocks[i].entries[state], memory_order_relaxed);
+		}
+		line_field(&line, "entries", entries);
+		line_field(&line, "dispatches", state_count);
+		line_latencies(&line, state_buckets, state_count, state_max);
+		line_text(&line, "}\n");
+	} //end for (state < STATE_COUNT)
+	line_flush(&line);
+} //end void stats_dump()
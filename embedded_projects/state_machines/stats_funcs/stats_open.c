@@ -0,0 +1,36 @@
+# include "../src/fsm_practical.h"
+
+static void stats_on_signal(int signal_number)
+{
+	(void)signal_number;
+	int saved_errno = errno;
+	stats_dump(STDERR_FD);
+	errno = saved_errno;
+}
+
+static void stats_on_exit(void)
+{
+	stats_dump(STDERR_FD);
+}
+
+void stats_open(void)
+{
+	/* This function has the statistics dumped to stderr whenever the process
+	 * gets SIGUSR1 ("kill -USR1 <pid>") and once more when it exits. The
+	 * handler is installed with SA_RESTART, so reads it interrupts are
+	 * resumed; the waits of the event loops resume themselves.
+	 */
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = stats_on_signal;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGUSR1, &action, NULL))
+	{
+		fprintf(stderr, "stats_open(): couldn't install the SIGUSR1 handler.\n");
+	}
+	if (atexit(stats_on_exit))
+	{
+		fprintf(stderr, "stats_open(): couldn't have the statistics dumped at exit.\n");
+	}
+} //end void stats_open()
@@ -0,0 +1,38 @@
+# include "../src/fsm_practical.h"
+
+void stats_record(uint8_t state, uint8_t event, uint8_t next, uint8_t moved, int64_t ns)
+{
+	/* This function records one dispatch of event to a machine in state,
+	 * which took ns nanoseconds and left it in next (moved being what
+	 * fsm_dispatch() returned.) Recording is a handful of stores into the
+	 * calling thread's own block, with nothing allocated and no lock taken.
+	 * A latency below 1 << STATS_SUB_BITS has a bucket of its own; any other
+	 * goes to the bucket of its leading bit's position and the STATS_SUB_BITS
+	 * bits after it, and latencies too long for the last bucket are counted
+	 * in it.
+	 */
+	if ((state >= STATE_COUNT) || (event >= EVENT_COUNT))
+	{
+		return;
+	}
+	stats_block *block = stats_claim();
+	uint64_t latency = (ns > 0)? (uint64_t)ns : 0;
+	uint64_t bucket = latency;
+	if (latency >= (1 << STATS_SUB_BITS))
+	{
+		uint32_t magnitude = 63 - (uint32_t)__builtin_clzll(latency);
+		bucket = ((uint64_t)(magnitude - STATS_SUB_BITS + 1) << STATS_SUB_BITS)
+			+ ((latency >> (magnitude - STATS_SUB_BITS)) & ((1 << STATS_SUB_BITS) - 1));
+	}
+	bucket = (bucket < STATS_BUCKETS)? bucket : STATS_BUCKETS - 1;
+	STATS_ADD(block->buckets[state][event][bucket], 1);
+	if (latency > atomic_load_explicit(&block->max_ns[state][event], memory_order_relaxed))
+	{
+		atomic_store_explicit(&block->max_ns[state][event], latency, memory_order_relaxed);
+	}
+	if ((moved == FSM_MOVED) && (next < STATE_COUNT))
+	{
+		STATS_ADD(block->moved[state][event], 1);
+		STATS_ADD(block->entries[next], 1);
+	}
+} //end void stats_record()
@@ -0,0 +1,23 @@
+# include "../src/fsm_practical.h"
+
+uint8_t trace_close(trace_ring *trace)
+{
+	/* This function stops recording a trace: the writer thread is asked to
+	 * stop, which it only does once every event is written, and the file is
+	 * closed. Returns REF_INACTIVE, having said so, if any of the trace
+	 * couldn't be written.
+	 */
+	atomic_store_explicit(&trace->stop, REF_ACTIVATE, memory_order_release);
+	pthread_join(trace->writer, NULL);
+	uint8_t failed = trace->failed | (fclose(trace->file) != 0);
+	free(trace->ring);
+	uint64_t events = atomic_load_explicit(&trace->head, memory_order_relaxed);
+	if (failed)
+	{
+		fprintf(stderr, "trace_close(): the trace couldn't be written.\n");
+		return REF_INACTIVE;
+	}
+	fprintf(stderr, "trace: %llu events recorded, %llu waited for the writer.\n",
+		(unsigned long long)events, (unsigned long long)trace->stalls);
+	return REF_ACTIVATE;
+} //end uint8_t trace_close()
@@ -0,0 +1,67 @@
+# include "../src/fsm_practical.h"
+
+static void *trace_writer(void *arg)
+{
+	/* The writer thread: whatever the fleet recorded since the last write is
+	 * written out in one go (in two, when it wraps around the end of the
+	 * ring), and the thread naps when nothing was. Once asked to stop it
+	 * writes whatever is left and returns.
+	 */
+	trace_ring *trace = arg;
+	for (;;)
+	{
+		uint8_t stopping = atomic_load_explicit(&trace->stop, memory_order_acquire);
+		uint64_t head = atomic_load_explicit(&trace->head, memory_order_acquire);
+		uint64_t tail = atomic_load_explicit(&trace->tail, memory_order_relaxed);
+		if (head == tail)
+		{
+			if (stopping) break;
+			struct timespec nap = {0, TRACE_NAP};
+			nanosleep(&nap, NULL);
+			continue;
+		}
+		uint64_t start = tail & (TRACE_RING - 1);
+		uint64_t length = head - tail;
+		if (start + length > TRACE_RING) length = TRACE_RING - start;
+		if (fwrite(&trace->ring[start], sizeof(trace_event), length, trace->file) != length)
+		{
+			trace->failed = REF_ACTIVATE;
+		}
+		atomic_store_explicit(&trace->tail, tail + length, memory_order_release);
+	}
+	return NULL;
+} //end void *trace_writer()
+
+uint8_t trace_open(trace_ring *trace, const char *path, const fleet *fl)
+{
+	/* This function starts recording a trace of a freshly opened fleet to the
+	 * file at path: its header is written straight away, and the writer
+	 * thread is started. The fleet records to the trace once its trace is
+	 * pointed at it. Returns REF_INACTIVE, with nothing left open, if any of
+	 * that fails.
+	 */
+	trace->ring = malloc(TRACE_RING * sizeof(trace_event));
+	trace->file = fopen(path, "wb");
+	if ((trace->ring == NULL) || (trace->file == NULL))
+	{
+		if (trace->file == NULL) perror(path);
+		else fclose(trace->file);
+		free(trace->ring);
+		return REF_INACTIVE;
+	}
+	trace_header header = {TRACE_MAGIC, fl->count, fl->now, (fl->machine == &craft_machine), {0}};
+	trace->stalls = 0;
+	trace->cached_tail = 0;
+	trace->failed = (fwrite(&header, sizeof(header), 1, trace->file) != 1);
+	atomic_init(&trace->head, 0);
+	atomic_init(&trace->tail, 0);
+	atomic_init(&trace->stop, REF_INACTIVE);
+	if (pthread_create(&trace->writer, NULL, trace_writer, trace))
+	{
+		fprintf(stderr, "trace_open(): couldn't start the writer thread.\n");
+		fclose(trace->file);
+		free(trace->ring);
+		return REF_INACTIVE;
+	}
+	return REF_ACTIVATE;
+} //end uint8_t trace_open()
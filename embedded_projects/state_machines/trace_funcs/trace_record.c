@@ -0,0 +1,25 @@
+# include "../src/fsm_practical.h"
+
+void trace_record(trace_ring *trace, int64_t time, uint32_t craft, uint8_t event, uint8_t state, uint8_t next)
+{
+	/* This function records an event, that is writes it into the ring and
+	 * publishes it to the writer thread. Only the fleet ever moves head, so
+	 * it is read without ordering, and the release store of the new head is
+	 * a plain store on x86. When the ring looks full, the writer's tail is
+	 * read again, and only when it really is full does the fleet wait,
+	 * yielding to the writer until there is room again.
+	 */
+	uint64_t head = atomic_load_explicit(&trace->head, memory_order_relaxed);
+	if (head - trace->cached_tail == TRACE_RING)
+	{
+		trace->cached_tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+		if (head - trace->cached_tail == TRACE_RING) trace->stalls++;
+		while (head - trace->cached_tail == TRACE_RING)
+		{
+			sched_yield();
+			trace->cached_tail = atomic_load_explicit(&trace->tail, memory_order_acquire);
+		}
+	}
+	trace->ring[head & (TRACE_RING - 1)] = (trace_event){time, craft, event, state, next, 0};
+	atomic_store_explicit(&trace->head, head + 1, memory_order_release);
+} //end void trace_record()
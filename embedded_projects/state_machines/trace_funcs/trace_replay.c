@@ -0,0 +1,71 @@
+# include "../src/fsm_practical.h"
+
+uint8_t trace_replay(const char *path)
+{
+	/* This function re-drives a fleet from the trace at path, as fast as it
+	 * can: the fleet is set up as the header says, and every event of the
+	 * trace is dispatched again in the order it was recorded, with the
+	 * fleet's clock set to its time. Timers play no part, since their expiry
+	 * is in the trace, and there's no waiting. Every event is also checked
+	 * against the recording: the aircraft has to be in the recorded state
+	 * beforehand and in the recorded next state afterwards, and anything
+	 * else is counted as a divergence (the first is shown.) A talking trace
+	 * says again everything the aircraft said. Returns REF_INACTIVE if the
+	 * trace can't be read or the replay diverged.
+	 */
+	FILE *file = fopen(path, "rb");
+	if (file == NULL)
+	{
+		perror(path);
+		return REF_INACTIVE;
+	}
+	trace_header header;
+	trace_event *events = malloc(TRACE_CHUNK * sizeof(trace_event));
+	fleet fl;
+	if ((events == NULL) || (fread(&header, sizeof(header), 1, file) != 1)
+		|| memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) || (header.count == 0) || (header.count > FLEET_MAX)
+		|| !fleet_open(&fl, (header.talking)? &craft_machine : &craft_fleet_machine, header.count, STATE_GROUND, header.start))
+	{
+		fprintf(stderr, "trace_replay(): %s is not a trace.\n", path);
+		free(events);
+		fclose(file);
+		return REF_INACTIVE;
+	}
+
+	uint64_t replayed = 0;
+	uint64_t diverged = 0;
+	int64_t start = clock_ns();
+	size_t n_events;
+	while ((n_events = fread(events, sizeof(trace_event), TRACE_CHUNK, file)) > 0)
+	{
+		for (size_t index = 0; index < n_events; index++)
+		{
+			const trace_event *event = &events[index];
+			if (event->craft >= fl.count)
+			{
+				diverged++;
+				continue;
+			}
+			uint8_t before = fl.states[event->craft];
+			fl.now = event->time;
+			fleet_dispatch(&fl, event->craft, event->event);
+			if ((before != event->state) || (fl.states[event->craft] != event->next))
+			{
+				if (diverged++ == 0)
+				{
+					fprintf(stderr, "trace_replay(): event %llu diverged: aircraft %u went from %u to %u, not %u to %u.\n",
+						(unsigned long long)replayed, event->craft, before, fl.states[event->craft], event->state, event->next);
+				}
+			}
+			replayed++;
+		}
+	}
+	fl.busy_ns = clock_ns() - start;
+	if (header.talking) putchar('\n');
+	fleet_report(&fl);
+	printf("trace: %llu events replayed, %llu diverged.\n", (unsigned long long)replayed, (unsigned long long)diverged);
+	fleet_close(&fl);
+	free(events);
+	fclose(file);
+	return (diverged == 0)? REF_ACTIVATE : REF_INACTIVE;
+} //end uint8_t trace_replay()
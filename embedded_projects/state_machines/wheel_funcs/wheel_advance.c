@@ -0,0 +1,65 @@
+# include "../src/fsm_practical.h"
+
+uint32_t wheel_advance(timing_wheel *wheel, int64_t now, uint32_t *expired)
+{
+	/* This function turns the wheel up to now, disarming every timer that
+	 * expired by then and storing its id in expired (which has room for every
+	 * timer, as each expires at most once), in the order they expired.
+	 * Returns how many did. Whenever a level comes round to its next slot,
+	 * which happens on ticks whose bits below it are all 0, that slot's
+	 * timers are re-inserted and so move down to the level they now belong
+	 * in; the highest level is moved first, as its timers may land in the
+	 * slot of the level below that is due on the same tick. The wheel doesn't
+	 * step through the ticks in between: it jumps straight to the next one
+	 * wheel_next() finds something to do at, so advancing costs the timers
+	 * expired and moved rather than the time that passed. Once now is out of
+	 * reach of the wheel's 32 bit ticks, the wheel is re-based first, to its
+	 * current tick or to WHEEL_REBASE ticks before now, whichever is later.
+	 */
+	int64_t ticks = now - wheel->epoch;
+	if (ticks >= (int64_t)UINT32_MAX)
+	{
+		int64_t behind = now - WHEEL_REBASE;
+		wheel_rebase(wheel, (wheel->epoch + wheel->tick > behind)? wheel->epoch + wheel->tick : behind);
+		ticks = now - wheel->epoch;
+	}
+	uint32_t target = (ticks < 0)? 0 : (uint32_t)ticks;
+	uint32_t n_expired = 0;
+	while ((wheel->pending > 0) && (wheel->tick <= target))
+	{
+		uint32_t tick = wheel->tick;
+		for (uint8_t level = WHEEL_LEVELS - 1; level > 0; level--)
+		{
+			uint8_t shift = (uint8_t)(level * WHEEL_BITS);
+			if ((tick & (uint32_t)(((uint64_t)1 << shift) - 1)) != 0) continue;
+			uint32_t slot = (level * WHEEL_SLOTS) + ((tick >> shift) & (WHEEL_SLOTS - 1));
+			while (wheel->heads[slot] != WHEEL_NIL)
+			{
+				uint32_t id = wheel->heads[slot];
+				int64_t deadline = wheel->epoch + wheel->timers[id].expiry;
+				wheel_cancel(wheel, id);
+				wheel_insert(wheel, id, deadline);
+			}
+		}
+		uint32_t slot = tick & (WHEEL_SLOTS - 1);
+		while (wheel->heads[slot] != WHEEL_NIL)
+		{
+			uint32_t id = wheel->heads[slot];
+			wheel_cancel(wheel, id);
+			expired[n_expired++] = id;
+		}
+
+		wheel->tick = tick + 1;
+		int wait = wheel_next(wheel, wheel->epoch + wheel->tick);
+		if ((wait == FOREVER) || ((uint32_t)wait > target - tick))
+		{
+			break;
+		}
+		wheel->tick += (uint32_t)wait;
+	}
+	if (wheel->tick <= target)
+	{
+		wheel->tick = target + 1;
+	}
+	return n_expired;
+} //end uint32_t wheel_advance()
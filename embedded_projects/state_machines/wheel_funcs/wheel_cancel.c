@@ -0,0 +1,32 @@
+# include "../src/fsm_practical.h"
+
+void wheel_cancel(timing_wheel *wheel, uint32_t id)
+{
+	/* This function disarms timer id, if it is armed, by unlinking it from
+	 * its slot; the slot's occupied bit is cleared once it is empty.
+	 */
+	wheel_timer *timer = &wheel->timers[id];
+	if (timer->slot == WHEEL_IDLE)
+	{
+		return;
+	}
+	if (timer->prev != WHEEL_NIL)
+	{
+		wheel->timers[timer->prev].next = timer->next;
+	}
+	else
+	{
+		wheel->heads[timer->slot] = timer->next;
+	}
+	if (timer->next != WHEEL_NIL)
+	{
+		wheel->timers[timer->next].prev = timer->prev;
+	}
+	if (wheel->heads[timer->slot] == WHEEL_NIL)
+	{
+		uint32_t index = timer->slot % WHEEL_SLOTS;
+		wheel->occupied[timer->slot / WHEEL_SLOTS][index / 64] &= ~((uint64_t)1 << (index % 64));
+	}
+	*timer = (wheel_timer){WHEEL_NIL, WHEEL_NIL, 0, WHEEL_IDLE};
+	wheel->pending--;
+} //end void wheel_cancel()
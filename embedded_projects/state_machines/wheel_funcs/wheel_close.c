@@ -0,0 +1,9 @@
+# include "../src/fsm_practical.h"
+
+void wheel_close(timing_wheel *wheel)
+{
+	/* This function releases a timing wheel's timers. */
+	free(wheel->timers);
+	wheel->timers = NULL;
+	wheel->pending = 0;
+} //end void wheel_close()
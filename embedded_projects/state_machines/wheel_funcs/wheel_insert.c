@@ -0,0 +1,43 @@
+# include "../src/fsm_practical.h"
+
+void wheel_insert(timing_wheel *wheel, uint32_t id, int64_t deadline)
+{
+	/* This function arms timer id to expire at deadline (in milliseconds, by
+	 * the same clock as the wheel's epoch), cancelling it first if it was
+	 * armed already. The level a timer goes into is the highest WHEEL_BITS
+	 * group in which its expiry differs from the current tick, so it only
+	 * ever has to move down (see wheel_advance()), and its slot there is the
+	 * expiry's own bits of that group. A deadline that has already passed
+	 * expires with the next tick. A deadline out of reach of the wheel's 32
+	 * bit ticks re-bases the wheel first (see wheel_rebase()), to its current
+	 * tick or to WHEEL_REBASE ticks before the deadline, whichever is later:
+	 * as no timeout is longer than INT32_MAX ms, that is never after the
+	 * time the timer was armed at.
+	 */
+	wheel_timer *timers = wheel->timers;
+	if (timers[id].slot != WHEEL_IDLE)
+	{
+		wheel_cancel(wheel, id);
+	}
+	int64_t ticks = deadline - wheel->epoch;
+	if (ticks > (int64_t)UINT32_MAX)
+	{
+		int64_t behind = deadline - WHEEL_REBASE;
+		wheel_rebase(wheel, (wheel->epoch + wheel->tick > behind)? wheel->epoch + wheel->tick : behind);
+		ticks = deadline - wheel->epoch;
+	}
+	uint32_t expiry = (ticks < (int64_t)wheel->tick)? wheel->tick : (uint32_t)ticks;
+	uint32_t differ = expiry ^ wheel->tick;
+	uint8_t level = (differ != 0)? (uint8_t)((31 - __builtin_clz(differ)) / WHEEL_BITS) : 0;
+	uint32_t index = (expiry >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+	uint16_t slot = (uint16_t)((level * WHEEL_SLOTS) + index);
+
+	timers[id] = (wheel_timer){wheel->heads[slot], WHEEL_NIL, expiry, slot};
+	if (wheel->heads[slot] != WHEEL_NIL)
+	{
+		timers[wheel->heads[slot]].prev = id;
+	}
+	wheel->heads[slot] = id;
+	wheel->occupied[level][index / 64] |= (uint64_t)1 << (index % 64);
+	wheel->pending++;
+} //end void wheel_insert()
@@ -0,0 +1,53 @@
+# include "../src/fsm_practical.h"
+
+static uint32_t next_occupied(const uint64_t *occupied, uint32_t from)
+{
+	/* The first occupied slot of a level from slot from on, or WHEEL_SLOTS if
+	 * there's none: a whole word of slots is skipped at a time.
+	 */
+	for (uint32_t word = from / 64; word < WHEEL_SLOTS / 64; word++)
+	{
+		uint64_t bits = occupied[word];
+		if (word == from / 64) bits &= ~(uint64_t)0 << (from % 64);
+		if (bits != 0)
+		{
+			return (word * 64) + (uint32_t)__builtin_ctzll(bits);
+		}
+	}
+	return WHEEL_SLOTS;
+} //end uint32_t next_occupied()
+
+int wheel_next(const timing_wheel *wheel, int64_t now)
+{
+	/* This function works out how many milliseconds from now the wheel next
+	 * needs advancing, which is what the event loop waits for: FOREVER with
+	 * no timer armed, and 0 if something is due already. Every level is
+	 * searched for its next occupied slot: in level 0 that slot's tick is
+	 * when its timers expire; higher up, it's the tick at which the wheel
+	 * below comes round to the slot, which moves its timers down. The
+	 * earliest of those is the answer. A level's current slot is only looked
+	 * at on the very tick it comes round (it hasn't been moved down yet), as
+	 * it is empty at any other time. Usually the lowest level that has a
+	 * timer at all has the earliest one, but not on such a tick, when level
+	 * 0 may already hold timers armed after the ones still waiting above.
+	 */
+	if (wheel->pending == 0)
+	{
+		return FOREVER;
+	}
+	int64_t next = INT64_MAX;
+	for (uint8_t level = 0; level < WHEEL_LEVELS; level++)
+	{
+		uint8_t shift = (uint8_t)(level * WHEEL_BITS);
+		uint32_t below = (uint32_t)(((uint64_t)1 << shift) - 1);
+		uint32_t index = (wheel->tick >> shift) & (WHEEL_SLOTS - 1);
+		uint32_t slot = next_occupied(wheel->occupied[level], ((wheel->tick & below) == 0)? index : index + 1);
+		if (slot < WHEEL_SLOTS)
+		{
+			int64_t start = (int64_t)((((uint64_t)wheel->tick >> shift) - index + slot) << shift);
+			if (start < next) next = start;
+		}
+	}
+	int64_t wait = wheel->epoch + next - now;
+	return (wait <= 0)? 0 : (wait > INT32_MAX)? INT32_MAX : (int)wait;
+} //end int wheel_next()
@@ -0,0 +1,25 @@
+# include "../src/fsm_practical.h"
+
+uint8_t wheel_open(timing_wheel *wheel, uint32_t n_timers, int64_t now)
+{
+	/* This function sets up an empty timing wheel for timers 0 to n_timers - 1,
+	 * starting its ticks at now (in milliseconds.) The only allocation a wheel
+	 * ever makes is its timers, here, so arming and expiring them never fail.
+	 * Returns REF_INACTIVE if the timers don't fit into memory.
+	 */
+	wheel->timers = malloc((size_t)n_timers * sizeof(wheel_timer));
+	if (wheel->timers == NULL)
+	{
+		return REF_INACTIVE;
+	}
+	for (uint32_t id = 0; id < n_timers; id++)
+	{
+		wheel->timers[id] = (wheel_timer){WHEEL_NIL, WHEEL_NIL, 0, WHEEL_IDLE};
+	}
+	memset(wheel->heads, 0xFF, sizeof(wheel->heads));
+	memset(wheel->occupied, 0, sizeof(wheel->occupied));
+	wheel->tick = 0;
+	wheel->epoch = now;
+	wheel->pending = 0;
+	return REF_ACTIVATE;
+} //end uint8_t wheel_open()
@@ -0,0 +1,39 @@
+# include "../src/fsm_practical.h"
+
+void wheel_rebase(timing_wheel *wheel, int64_t epoch)
+{
+	/* This function restarts a wheel's ticks at epoch, which the ticks
+	 * would otherwise outgrow after 2^32 ms (49.7 days): every armed timer
+	 * is unlinked onto one list, through its next link, and inserted again
+	 * at the deadline it had, relative to the new epoch. A timer whose
+	 * deadline is before the new epoch expires with the next tick, as any
+	 * deadline that already passed does. Only the wheel's own lists are
+	 * walked, so it costs the timers that are armed, about once every
+	 * 24.8 days of ticks.
+	 */
+	uint32_t chain = WHEEL_NIL;
+	for (uint32_t slot = 0; slot < WHEEL_LEVELS * WHEEL_SLOTS; slot++)
+	{
+		uint32_t id = wheel->heads[slot];
+		while (id != WHEEL_NIL)
+		{
+			uint32_t next = wheel->timers[id].next;
+			wheel->timers[id].next = chain;
+			wheel->timers[id].slot = WHEEL_IDLE;
+			chain = id;
+			id = next;
+		}
+	}
+	int64_t old_epoch = wheel->epoch;
+	memset(wheel->heads, 0xFF, sizeof(wheel->heads));
+	memset(wheel->occupied, 0, sizeof(wheel->occupied));
+	wheel->tick = 0;
+	wheel->epoch = epoch;
+	wheel->pending = 0;
+	while (chain != WHEEL_NIL)
+	{
+		uint32_t id = chain;
+		chain = wheel->timers[id].next;
+		wheel_insert(wheel, id, old_epoch + wheel->timers[id].expiry);
+	}
+} //end void wheel_rebase()
@@ -0,0 +1,94 @@
+# include "../src/claytor.h"
+
+uint8_t ast_eval(const calc_ast_t *ast, const calc_value_t *vars, calc_value_t *result)
+{
+	/* This function evaluates an AST directly, which is what an expression
+	 * that is only evaluated once needs: compiling it first would cost more
+	 * than it saves. Every node's value is computed from the values of its
+	 * children, and since children always come first in the arena, that is
+	 * a single loop over the nodes that never has to recurse. Variables take
+	 * their values from vars, indexed 0 for 'a' to 25 for 'z'; if vars is
+	 * NULL (as it is interactively) an expression that uses one fails with
+	 * CALC_EUNBOUND. The AST itself is not modified. Numbers and variables
+	 * are only borrowed, so in bignum mode the owned flags keep track of
+	 * which values are intermediate results that have to be released once
+	 * their parent consumed them. The values live in a local array unless
+	 * the AST is unusually large, so evaluation normally doesn't allocate.
+	 */
+	if (ast->len == 0)
+	{
+		return CALC_ESYNTAX;
+	}
+	calc_value_t local_values[PROG_STACK];
+	uint8_t local_owned[PROG_STACK];
+	calc_value_t *values = local_values;
+	uint8_t *owned = local_owned;
+	if (ast->len > PROG_STACK)
+	{
+		values = malloc((size_t)ast->len * sizeof(calc_value_t));
+		owned = malloc(ast->len);
+		if ((values == NULL) || (owned == NULL))
+		{
+			free(values);
+			free(owned);
+			return CALC_ENOMEM;
+		}
+	}
+
+	uint8_t status = CALC_OK;
+	uint32_t index = REF_INACTIVE;
+	for (; (index < ast->len) && (status == CALC_OK); index++)
+	{
+		const calc_node_t *node = &ast->nodes[index];
+		owned[index] = REF_INACTIVE;
+		switch (node->kind)
+		{
+			case NODE_NUMBER: values[index] = node->value; break;
+			case NODE_VARIABLE:
+			{
+				if (vars == NULL) status = CALC_EUNBOUND;
+				else values[index] = vars[VALUE_AS_INT(node->value)];
+				break;
+			}
+			case NODE_OP:
+			{
+				uint8_t binary = (OP_ARITY(node->opcode) == 2);
+				calc_value_t rhs = (binary)? values[node->rhs] : VALUE_INT(REF_INACTIVE);
+				status = op_apply(node->opcode, values[node->lhs], rhs, &values[index]);
+				owned[index] = (status == CALC_OK);
+				if (VALUE_OWNS_MEMORY)
+				{
+					if (owned[node->lhs]) value_release(&values[node->lhs]);
+					if (binary && owned[node->rhs]) value_release(&values[node->rhs]);
+				}
+				owned[node->lhs] = REF_INACTIVE;
+				if (binary) owned[node->rhs] = REF_INACTIVE;
+				break;
+			}
+			default: break;	//folded away
+		}
+	} //end for-loop over nodes
+
+	if (status == CALC_OK)
+	{
+		/* Hand the value of the root over to the caller. If the whole
+		 * expression was just a number or a variable, it is still borrowed,
+		 * so it is copied.
+		 */
+		index--;
+		status = (owned[index])? (*result = values[index], CALC_OK) : value_copy(values[index], result);
+	}
+	else if (VALUE_OWNS_MEMORY)
+	{
+		while (index-- > 0)
+		{
+			if (owned[index]) value_release(&values[index]);
+		}
+	}
+	if (values != local_values)
+	{
+		free(values);
+		free(owned);
+	}
+	return status;
+} //end uint8_t ast_eval()
@@ -0,0 +1,73 @@
+# include "../src/claytor.h"
+
+static uint8_t fold_identity(uint8_t opcode, calc_value_t constant, uint8_t constant_is_right)
+{
+	/* Whether an operator with this constant on the given side leaves the
+	 * other operand unchanged, as its entry in calc_ops[] lists: x+0, 0+x,
+	 * x-0, x*1, 1*x, x/1 and x^1. Only identities that hold for every value
+	 * of x (including errors) are listed, which rules out x*0 and x^0.
+	 */
+	const calc_op_t *op = &calc_ops[opcode];
+	uint8_t side = (constant_is_right)? IDENTITY_RIGHT : IDENTITY_LEFT;
+	return (op->identity & side) && VALUE_IS(constant, op->unit);
+}
+
+void ast_fold(calc_ast_t *ast)
+{
+	/* This function is the optimisation pass that runs between parsing an
+	 * expression and compiling it, so that a program evaluated many times
+	 * only ever executes the operations it really needs. Since every node
+	 * comes after its children, a single pass front to back sees every
+	 * operand in its final, folded form before the node that uses it:
+	 * 1) an operator whose operands are all numbers is evaluated right here
+	 * and the node becomes a number (unless the op fails, say by dividing by
+	 * zero, in which case it is kept so that evaluation reports the error as
+	 * it always would); variables are never constant, whatever they are bound
+	 * to later;
+	 * 2) an operator with one number operand that is an identity for it (x*1,
+	 * x+0 and so on) is replaced by its other operand, which is moved into
+	 * the operator's node;
+	 * 3) anything else is kept as it is.
+	 * Nodes that are folded away are marked NODE_DEAD rather than removed, so
+	 * indices stay valid, and every other pass simply skips them. The nodes
+	 * that remain are still in POSTFIX order: a folded sub-expression is
+	 * replaced by a single node in its root's place.
+	 */
+	for (uint32_t index = 0; index < ast->len; index++)
+	{
+		calc_node_t *node = &ast->nodes[index];
+		if (node->kind != NODE_OP) continue;
+		calc_node_t *lhs = &ast->nodes[node->lhs];
+		calc_node_t *rhs = (OP_ARITY(node->opcode) == 2)? &ast->nodes[node->rhs] : NULL;
+		if ((lhs->kind == NODE_NUMBER) && ((rhs == NULL) || (rhs->kind == NODE_NUMBER)))
+		{
+			calc_value_t folded = VALUE_INT(REF_INACTIVE);
+			if (op_apply(node->opcode, lhs->value, (rhs != NULL)? rhs->value : VALUE_INT(REF_INACTIVE), &folded) == CALC_OK)
+			{
+				value_release(&lhs->value);
+				lhs->kind = NODE_DEAD;
+				if (rhs != NULL)
+				{
+					value_release(&rhs->value);
+					rhs->kind = NODE_DEAD;
+				}
+				node->kind = NODE_NUMBER;
+				node->value = folded;
+			}
+		}
+		else if ((rhs != NULL) && (rhs->kind == NODE_NUMBER) && fold_identity(node->opcode, rhs->value, REF_ACTIVATE))
+		{
+			value_release(&rhs->value);
+			rhs->kind = NODE_DEAD;
+			*node = *lhs;
+			lhs->kind = NODE_DEAD;
+		}
+		else if ((rhs != NULL) && (lhs->kind == NODE_NUMBER) && fold_identity(node->opcode, lhs->value, REF_INACTIVE))
+		{
+			value_release(&lhs->value);
+			lhs->kind = NODE_DEAD;
+			*node = *rhs;
+			rhs->kind = NODE_DEAD;
+		}
+	} //end for-loop over nodes
+} //end void ast_fold()
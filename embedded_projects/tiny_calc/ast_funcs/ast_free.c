@@ -0,0 +1,17 @@
+# include "../src/claytor.h"
+
+void ast_free(calc_ast_t *ast)
+{
+	/* This function releases an AST: the numbers its live nodes own and then
+	 * the arena itself. The AST is left empty, so freeing it twice is
+	 * harmless.
+	 */
+	for (uint32_t index = 0; index < ast->len; index++)
+	{
+		if (ast->nodes[index].kind == NODE_NUMBER) value_release(&ast->nodes[index].value);
+	}
+	free(ast->nodes);
+	ast->nodes = NULL;
+	ast->len = REF_INACTIVE;
+	ast->cap = REF_INACTIVE;
+} //end void ast_free()
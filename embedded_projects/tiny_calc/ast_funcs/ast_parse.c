@@ -0,0 +1,179 @@
+# include "../src/claytor.h"
+
+typedef struct parser
+{
+	const char *src;	//the expression, only ever read
+	size_t offset;		//where lex_next() carries on
+	calc_token_t token;	//the token being looked at
+	uint16_t depth;		//how deeply parse_expr() has recursed
+	calc_ast_t *ast;
+} parser_t;
+
+static uint8_t advance(parser_t *parser)
+{
+	/* Moves on to the next token. A number token's value has always been
+	 * moved into a node (or released) by the time this is called.
+	 */
+	return lex_next(parser->src, &parser->offset, parser->token.kind, &parser->token);
+}
+
+static uint8_t expect(parser_t *parser, uint8_t kind)
+{
+	return (parser->token.kind == kind)? advance(parser) : CALC_ESYNTAX;
+}
+
+static uint8_t add_node(calc_ast_t *ast, uint8_t kind, uint8_t opcode, uint32_t lhs, uint32_t rhs, calc_value_t value, uint32_t *index)
+{
+	/* Appends a node to the arena, doubling it whenever it is full, and
+	 * returns its index through index. The arena takes ownership of value,
+	 * and releases it if there's no room for it.
+	 */
+	if (ast->len == ast->cap)
+	{
+		uint32_t cap = (ast->cap != 0)? ast->cap * 2 : 16;
+		calc_node_t *nodes = (cap > ast->cap)? realloc(ast->nodes, (size_t)cap * sizeof(calc_node_t)) : NULL;
+		if (nodes == NULL)
+		{
+			value_release(&value);
+			return CALC_ENOMEM;
+		}
+		ast->nodes = nodes;
+		ast->cap = cap;
+	}
+	ast->nodes[ast->len] = (calc_node_t){kind, opcode, lhs, rhs, value};
+	*index = ast->len++;
+	return CALC_OK;
+}
+
+static void binding_power(uint8_t opcode, uint8_t *left, uint8_t *right)
+{
+	/* How strongly a binary operator binds the operand on its left, and the
+	 * binding power its right operand is parsed with, both taken from the
+	 * operator's precedence in calc_ops[]. The left-associative operators
+	 * parse their right operand at their own power, so the next operator of
+	 * the same level ends it ((a-b)-c); right-associative ones such as '^' go
+	 * one lower, so the next one of their level continues it (a^(b^c)).
+	 */
+	*left = calc_ops[opcode].precedence;
+	*right = calc_ops[opcode].precedence - (calc_ops[opcode].assoc == ASSOC_RIGHT);
+}
+
+static uint8_t parse_expr(parser_t *parser, uint8_t min_power, uint32_t *index)
+{
+	/* Parses the expression starting at the current token for as long as its
+	 * operators bind tighter than min_power, and returns the index of its
+	 * root node. The token that ends it is left for the caller.
+	 */
+	if (parser->depth++ > PARSE_DEPTH)	//the whole expression is level 0
+	{
+		return CALC_ESYNTAX;
+	}
+	calc_ast_t *ast = parser->ast;
+	calc_token_t token = parser->token;
+	uint32_t lhs = REF_INACTIVE;
+	uint32_t rhs = REF_INACTIVE;
+	uint8_t status = CALC_OK;
+	switch (token.kind)
+	{
+		case TOKEN_NUMBER:
+		case TOKEN_VARIABLE:
+		{
+			parser->token.value = VALUE_INT(REF_INACTIVE);	//the value moves into the node
+			status = add_node(ast, (token.kind == TOKEN_NUMBER)? NODE_NUMBER : NODE_VARIABLE,
+				REF_INACTIVE, REF_INACTIVE, REF_INACTIVE, token.value, &lhs);
+			if (status == CALC_OK) status = advance(parser);
+			break;
+		}
+		case TOKEN_PREFIX:
+		{
+			uint8_t opcode = (uint8_t)VALUE_AS_INT(token.value);
+			status = advance(parser);
+			if (status == CALC_OK) status = parse_expr(parser, calc_ops[opcode].precedence, &rhs);
+			if (status == CALC_OK) status = add_node(ast, NODE_OP, opcode, rhs, REF_INACTIVE, VALUE_INT(REF_INACTIVE), &lhs);
+			break;
+		}
+		case TOKEN_LPAREN:
+		{
+			status = advance(parser);
+			if (status == CALC_OK) status = parse_expr(parser, REF_INACTIVE, &lhs);
+			if (status == CALC_OK) status = expect(parser, TOKEN_RPAREN);
+			break;
+		}
+		case TOKEN_FUNCTION:
+		{
+			uint8_t opcode = (uint8_t)VALUE_AS_INT(token.value);
+			uint32_t args[2] = {REF_INACTIVE, REF_INACTIVE};
+			status = advance(parser);
+			if (status == CALC_OK) status = expect(parser, TOKEN_LPAREN);
+			for (uint8_t arg = 0; (status == CALC_OK) && (arg < OP_ARITY(opcode)); arg++)
+			{
+				if (arg > 0) status = expect(parser, TOKEN_COMMA);
+				if (status == CALC_OK) status = parse_expr(parser, REF_INACTIVE, &args[arg]);
+			}
+			if (status == CALC_OK) status = expect(parser, TOKEN_RPAREN);
+			if (status == CALC_OK) status = add_node(ast, NODE_OP, opcode, args[0], args[1], VALUE_INT(REF_INACTIVE), &lhs);
+			break;
+		}
+		default: status = CALC_ESYNTAX; break;	//an operator, a ')' or the end where an operand should be
+	} //end switch (token.kind)
+
+	while ((status == CALC_OK) && (parser->token.kind == TOKEN_OPERATOR))
+	{
+		uint8_t opcode = (uint8_t)VALUE_AS_INT(parser->token.value);
+		uint8_t left_power = REF_INACTIVE;
+		uint8_t right_power = REF_INACTIVE;
+		binding_power(opcode, &left_power, &right_power);
+		if (left_power <= min_power) break;
+		status = advance(parser);
+		if (status == CALC_OK) status = parse_expr(parser, right_power, &rhs);
+		if (status == CALC_OK) status = add_node(ast, NODE_OP, opcode, lhs, rhs, VALUE_INT(REF_INACTIVE), &lhs);
+	}
+	parser->depth--;
+	*index = lhs;
+	return status;
+}
+
+uint8_t ast_parse(const char *src_array, calc_ast_t *ast)
+{
+	/* This function parses an expression into an AST. It is a Pratt parser:
+	 * every operand (a number, a variable, a parenthesised expression, a
+	 * function call or a prefix operator applied to an operand) is parsed
+	 * first, and is then taken as the left operand of every following
+	 * operator that binds tighter than the operator the whole expression is
+	 * the right operand of (see binding_power()). Precedence, associativity
+	 * and the number of arguments a function takes all come from the
+	 * operator registry, calc_ops[], so the parser itself knows no operator:
+	 * 10-2+3 is 11 and 2^3^2 is 512 because of their entries there. Tokens
+	 * are read one at a time by lex_next() as the parse goes, so the source
+	 * is read only once and never copied.
+	 * The nodes are appended to one growing arena, and a node is only ever
+	 * appended once its children have been, so the arena is the expression
+	 * in POSTFIX order and every pass over the AST (ast_fold(), ast_eval()
+	 * and prog_compile()) is a plain loop rather than a recursion. The parser
+	 * itself recurses for nesting (parentheses, calls and prefix operators)
+	 * and for every further operand of a chain of right-associative
+	 * operators, as 2^3^2 is 2^(3^2). Both count against PARSE_DEPTH
+	 * levels, so a chain of more than PARSE_DEPTH '^' is rejected just like
+	 * too deep a nesting is. A chain of left-associative operators only
+	 * recurses once per precedence level, however long it is.
+	 * If the expression is malformed, CALC_ESYNTAX is returned (or the error
+	 * of the lexer, for a number that doesn't fit), the AST is left empty and
+	 * its error_offset is where in the source the problem was found.
+	 */
+	*ast = (calc_ast_t){NULL, 0, 0, 0};
+	parser_t parser = {src_array, 0, {TOKEN_END, 0, 0, VALUE_INT(REF_INACTIVE)}, 0, ast};
+	uint32_t root = REF_INACTIVE;
+	uint8_t status = advance(&parser);
+	if (status == CALC_OK) status = parse_expr(&parser, REF_INACTIVE, &root);
+	if ((status == CALC_OK) && (parser.token.kind != TOKEN_END))
+	{
+		status = CALC_ESYNTAX;	//something is left over, say "2 3" or "(1))"
+	}
+	if (status != CALC_OK)
+	{
+		if (parser.token.kind == TOKEN_NUMBER) value_release(&parser.token.value);
+		ast_free(ast);
+		ast->error_offset = parser.token.offset;
+	}
+	return status;
+} //end uint8_t ast_parse()
@@ -0,0 +1,24 @@
+# include "../src/claytor.h"
+
+void batch_append(batch_chunk_t *chunk, const char *text, size_t len)
+{
+	/* This function appends text to the output arena of a batch chunk, growing
+	 * the arena geometrically whenever it runs out of room. Since a chunk is
+	 * only ever written by the worker that claimed it, no locking is required.
+	 */
+	if (chunk->len + len > chunk->cap)
+	{
+		size_t new_cap = (chunk->cap)? chunk->cap : (BATCH_CHUNK * 8);
+		while (new_cap < chunk->len + len) new_cap *= 2;
+		char *grown = realloc(chunk->text, new_cap);
+		if (grown == NULL)
+		{
+			fprintf(stderr, "realloc() failure, exiting.\n");
+			exit(EXIT_FAILURE);
+		}
+		chunk->text = grown;
+		chunk->cap = new_cap;
+	}
+	memcpy(chunk->text + chunk->len, text, len);
+	chunk->len += len;
+} //end void batch_append()
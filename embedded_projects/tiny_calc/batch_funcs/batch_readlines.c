@@ -0,0 +1,77 @@
+# include "../src/claytor.h"
+
+char **batch_readlines(FILE *src_file, char **buffer, size_t *n_lines)
+{
+	/* This function reads an entire input stream into one heap buffer and then
+	 * splits it into lines in place: every newline is overwritten with a null
+	 * terminator and a pointer to the start of every line is recorded. Doing
+	 * it this way costs two allocations for the whole input rather than one
+	 * per line, and the lines stay contiguous in memory which suits workers
+	 * that walk through them in order. A trailing newline at the end of the
+	 * stream does not produce an extra empty line. The buffer is handed back
+	 * through the buffer pointer so that the caller can free it once done with
+	 * the lines. NULL is returned if the stream could not be read.
+	 */
+	size_t cap = BUFSIZ;
+	size_t len = REF_INACTIVE;
+	char *text = malloc(cap);
+	if (text == NULL)
+	{
+		fprintf(stderr, "malloc() failure, exiting.\n");
+		exit(EXIT_FAILURE);
+	}
+	while (!feof(src_file))
+	{
+		if (len + BUFSIZ + 1 > cap)
+		{
+			cap *= 2;
+			char *grown = realloc(text, cap);
+			if (grown == NULL)
+			{
+				fprintf(stderr, "realloc() failure, exiting.\n");
+				exit(EXIT_FAILURE);
+			}
+			text = grown;
+		}
+		len += fread(text + len, 1, BUFSIZ, src_file);
+		if (ferror(src_file))
+		{
+			fprintf(stderr, "batch_readlines(): Error reading input.\n");
+			free(text);
+			return NULL;
+		}
+	} //end while (!feof(src_file))
+	text[len] = 0;
+
+	/* Count the lines first so that the pointer array is sized exactly, then
+	 * walk the buffer a second time terminating and recording every line.
+	 */
+	size_t count = REF_INACTIVE;
+	for (size_t index = 0; index < len; index++)
+	{
+		if ((text[index] == '\n') || (index == len - 1)) count++;
+	}
+	char **lines = malloc((count + 1) * sizeof(char *));
+	if (lines == NULL)
+	{
+		fprintf(stderr, "malloc() failure, exiting.\n");
+		exit(EXIT_FAILURE);
+	}
+	char *line_start = text;
+	size_t line = REF_INACTIVE;
+	for (size_t index = 0; index < len; index++)
+	{
+		if (text[index] == '\n')
+		{
+			text[index] = 0;
+			lines[line++] = line_start;
+			line_start = text + index + 1;
+		}
+	}
+	if (line < count) lines[line++] = line_start; //the last line had no newline
+	lines[count] = NULL;
+
+	*buffer = text;
+	*n_lines = count;
+	return lines;
+} //end char **batch_readlines()
@@ -0,0 +1,73 @@
+# include "../src/claytor.h"
+
+int batch_run(const char *src_path, uint16_t u_threads)
+{
+	/* This function drives batch mode: every line of the source file (or of
+	 * stdin if the path is "-") is an independent expression, so the lines
+	 * are read in once, split into chunks of BATCH_CHUNK lines and handed out
+	 * to a pool of u_threads worker threads. Once every worker has been joined
+	 * the chunk arenas are written to stdout one after the other, which keeps
+	 * the results in input order no matter which worker evaluated which chunk.
+	 * If fewer chunks exist than threads were requested, only as many threads
+	 * as there are chunks are started.
+	 */
+	FILE *src_file = stdin;
+	if (strcmp(src_path, "-") != 0)
+	{
+		src_file = fopen(src_path, "r");
+		if (src_file == NULL)
+		{
+			fprintf(stderr, "batch_run(): Error accessing batch source \"%s\".\n", src_path);
+			return EXIT_FAILURE;
+		}
+	}
+	batch_ctx_t batch = {0};
+	char *buffer = NULL;
+	batch.lines = batch_readlines(src_file, &buffer, &batch.n_lines);
+	if (src_file != stdin) fclose(src_file);
+	if (batch.lines == NULL)
+	{
+		return EXIT_FAILURE;
+	}
+
+	batch.n_chunks = (batch.n_lines + BATCH_CHUNK - 1) / BATCH_CHUNK;
+	batch.chunks = calloc(batch.n_chunks + 1, sizeof(batch_chunk_t));
+	if (batch.chunks == NULL)
+	{
+		fprintf(stderr, "calloc() failure, exiting.\n");
+		exit(EXIT_FAILURE);
+	}
+	atomic_init(&batch.next_chunk, 0);
+
+	if (u_threads > batch.n_chunks) u_threads = batch.n_chunks;
+	pthread_t workers[BATCH_THREADS];
+	uint16_t u_started = REF_INACTIVE;
+	for (; u_started < u_threads; u_started++)
+	{
+		if (pthread_create(&workers[u_started], NULL, batch_worker, &batch) != 0)
+		{
+			/* If a thread can't be started the batch still completes, only
+			 * with fewer workers. If not even one could be started, the
+			 * calling thread evaluates everything itself below.
+			 */
+			fprintf(stderr, "batch_run(): pthread_create() failure, continuing with %u workers.\n", u_started);
+			break;
+		}
+	}
+	if (u_started == 0) batch_worker(&batch);
+	for (uint16_t u_joined = 0; u_joined < u_started; u_joined++)
+	{
+		pthread_join(workers[u_joined], NULL);
+	}
+
+	for (size_t chunk = 0; chunk < batch.n_chunks; chunk++)
+	{
+		fwrite(batch.chunks[chunk].text, 1, batch.chunks[chunk].len, stdout);
+		free(batch.chunks[chunk].text);
+	}
+	fflush(stdout);
+	free(batch.chunks);
+	free(batch.lines);
+	free(buffer);
+	return EXIT_SUCCESS;
+} //end int batch_run()
@@ -0,0 +1,57 @@
+# include "../src/claytor.h"
+
+void *batch_worker(void *ctx)
+{
+	/* This function is the body of every batch worker thread. Workers share a
+	 * batch_ctx_t and repeatedly claim the next unprocessed chunk of lines by
+	 * atomically incrementing next_chunk, so that a worker that drew cheap
+	 * expressions simply claims more chunks rather than idling while another
+	 * grinds through expensive ones. Every line of a claimed chunk is parsed
+	 * and evaluated exactly as it would be interactively, and the result (or
+	 * "error") is formatted into that chunk's own output arena. The ASTs built
+	 * by ast_parse() are local to every line, so the workers never touch each
+	 * other's data.
+	 */
+	batch_ctx_t *batch = ctx;
+	char result_line[RESULT_SIZE] = {REF_INACTIVE};
+	size_t chunk_index = atomic_fetch_add(&batch->next_chunk, 1);
+	while (chunk_index < batch->n_chunks)
+	{
+		batch_chunk_t *chunk = &batch->chunks[chunk_index];
+		size_t first = chunk_index * BATCH_CHUNK;
+		size_t last = first + BATCH_CHUNK;
+		if (last > batch->n_lines) last = batch->n_lines;
+		for (size_t line = first; line < last; line++)
+		{
+			calc_ast_t ast = {NULL, 0, 0, 0};
+			if (ast_parse(batch->lines[line], &ast) != CALC_OK)
+			{
+				batch_append(chunk, "error\n", strlen("error\n"));
+				continue;
+			}
+			calc_value_t result = VALUE_INT(REF_INACTIVE);
+			uint8_t status = ast_eval(&ast, NULL, &result);
+			ast_free(&ast);
+			if (status != CALC_OK)
+			{
+				int written = snprintf(result_line, RESULT_SIZE, "error: %s\n", calc_strerror(status));
+				batch_append(chunk, result_line, written);
+				continue;
+			}
+			char *formatted = value_string(result, result_line, RESULT_SIZE);
+			if (formatted == NULL)
+			{
+				batch_append(chunk, "error\n", strlen("error\n"));
+			}
+			else
+			{
+				batch_append(chunk, formatted, strlen(formatted));
+				batch_append(chunk, "\n", 1);
+			}
+			if (formatted != result_line) free(formatted);
+			value_release(&result);
+		}
+		chunk_index = atomic_fetch_add(&batch->next_chunk, 1);
+	} //end while (chunk_index < batch->n_chunks)
+	return NULL;
+} //end void *batch_worker()
@@ -0,0 +1,185 @@
+# include "../src/claytor.h"
+
+# define LEAF_SIZE	24	//longest operand leaf() writes, with its space
+
+typedef struct generator
+{
+	uint64_t *seed;
+	uint8_t use_vars;
+	char *writer;
+	const char *end;	//where the terminating NUL goes
+	size_t reserved;	//room the constructs already started need to be completed
+} generator_t;
+
+static void expression(generator_t *gen, uint8_t depth);
+
+static uint64_t next_random(uint64_t *seed)
+{
+	/* xorshift64*: fast, and the same seed always yields the same sequence. */
+	*seed ^= *seed >> 12;
+	*seed ^= *seed << 25;
+	*seed ^= *seed >> 27;
+	return *seed * 0x2545F4914F6CDD1DULL;
+}
+
+static void emit(generator_t *gen, const char *text)
+{
+	/* Appends text, sometimes with a space in front of it, which the lexer
+	 * has to skip like any user would type it.
+	 */
+	if ((next_random(gen->seed) & 7) == 0) *gen->writer++ = ' ';
+	size_t len = strlen(text);
+	memcpy(gen->writer, text, len);
+	gen->writer += len;
+}
+
+static void leaf(generator_t *gen, uint8_t exponent)
+{
+	/* Writes an operand: mostly short numbers, some long enough to overflow
+	 * the fixed-width modes once multiplied, and variables if enabled. The
+	 * exponent of '^' and pow(), like the places of a shift, is a small
+	 * number or a variable, as it is in practice; powers of powers would only
+	 * measure how slowly bignums of hundreds of thousands of digits are
+	 * formatted.
+	 */
+	char text[LEAF_SIZE] = {REF_INACTIVE};
+	uint64_t pick = next_random(gen->seed);
+	if (gen->use_vars && ((pick & 3) == 0))
+	{
+		text[0] = (char)('a' + ((pick >> 8) % 5));
+	}
+	else if (exponent)
+	{
+		snprintf(text, LEAF_SIZE, "%llu", (unsigned long long)((pick >> 8) % 13));
+	}
+	else if ((pick & 15) == 1)
+	{
+		snprintf(text, LEAF_SIZE, "%llu", (unsigned long long)((pick >> 8) % 10000000000000000ULL));
+	}
+	else
+	{
+# if defined(CALC_MODE_DOUBLE) || defined(CALC_MODE_RATIONAL)
+		snprintf(text, LEAF_SIZE, ((pick & 15) == 2)? "%llu.5" : "%llu", (unsigned long long)((pick >> 8) % 1000));
+# else
+		snprintf(text, LEAF_SIZE, "%llu", (unsigned long long)((pick >> 8) % 1000));
+# endif
+	}
+	emit(gen, text);
+}
+
+static uint8_t leaf_operands(const char *op)
+{
+	/* Whether an operator only gets leaves as its operands: '^' and the
+	 * shifts, whose right operand is an exponent (see leaf()).
+	 */
+	return (op[0] == 0x5E) || ((op[0] == 0x3C) && (op[1] == 0x3C)) || ((op[0] == 0x3E) && (op[1] == 0x3E));	//"^", "<<", ">>"
+}
+
+static void operand(generator_t *gen, uint8_t depth, size_t closing)
+{
+	/* Writes an operand of a construct that still needs closing characters
+	 * (and, for the left operand of two, room for the right one) once the
+	 * operand is written.
+	 */
+	gen->reserved += closing;
+	expression(gen, depth);
+	gen->reserved -= closing;
+}
+
+static void expression(generator_t *gen, uint8_t depth)
+{
+	/* Writes an expression of at most depth levels. A construct is only
+	 * started if there is room for it and two operands of LEAF_SIZE besides
+	 * whatever the constructs around it still need (reserved), so the
+	 * expression always fits; once the room or the depth runs out, an
+	 * operand is written instead. Every construct writes at most 12
+	 * characters of its own, and every call leaves at least as much room as
+	 * was reserved when it started.
+	 */
+	static const char *const binary[] = {"+", "-", "*", "/", "+", "-", "*", "^",
+		"%", "&", "|", "<<", ">>", "<", "==", ">="};
+	static const char *const calls[] = {"min(", "max(", "pow(", "xor("};
+	static const char *const unary[] = {"-", "~", "abs(", "sqrt("};
+	uint64_t pick = next_random(gen->seed);
+	size_t room = (size_t)(gen->end - gen->writer);
+	if ((depth == 0) || (room < gen->reserved + 2 * LEAF_SIZE + 12) || ((pick & 15) == 0))
+	{
+		leaf(gen, REF_INACTIVE);
+		return;
+	}
+	const char *op = binary[(pick >> 8) & 15];
+	const char *call = calls[(pick >> 12) & 3];
+	const char *prefix = unary[(pick >> 14) & 1];
+	const char *function = unary[2 + ((pick >> 15) & 1)];
+	switch ((pick >> 4) & 7)
+	{
+		case 0:	//a parenthesised binary operation
+		{
+			emit(gen, "(");
+			if (leaf_operands(op)) leaf(gen, REF_INACTIVE);
+			else operand(gen, depth - 1, 4 + LEAF_SIZE);
+			emit(gen, op);
+			if (leaf_operands(op)) leaf(gen, REF_ACTIVATE);
+			else operand(gen, depth - 1, 2);
+			emit(gen, ")");
+			break;
+		}
+		case 1:	//a unary minus or '~'
+		{
+			emit(gen, prefix);
+			expression(gen, depth - 1);
+			break;
+		}
+		case 2:	//a call with one operand
+		{
+			emit(gen, function);
+			operand(gen, depth - 1, 2);
+			emit(gen, ")");
+			break;
+		}
+		case 3:	//a call with two operands
+		{
+			emit(gen, call);
+			if (call[0] == 'p') leaf(gen, REF_INACTIVE);
+			else operand(gen, depth - 1, 4 + LEAF_SIZE);
+			emit(gen, ",");
+			if (call[0] == 'p') leaf(gen, REF_ACTIVATE);
+			else operand(gen, depth - 1, 2);
+			emit(gen, ")");
+			break;
+		}
+		default:	//a bare binary operation, left to precedence
+		{
+			if (leaf_operands(op)) leaf(gen, REF_INACTIVE);
+			else operand(gen, depth - 1, 2 + LEAF_SIZE);
+			emit(gen, op);
+			if (leaf_operands(op)) leaf(gen, REF_ACTIVATE);
+			else expression(gen, depth - 1);
+			break;
+		}
+	} //end switch (construct)
+}
+
+size_t bench_gen(uint64_t *seed, uint8_t depth, uint8_t use_vars, char *dest_array, size_t size)
+{
+	/* This function generates a random, syntactically valid expression into
+	 * dest_array (which holds size characters, the terminating NUL
+	 * included) and returns its length. depth limits how deeply operations
+	 * nest and size how long the expression gets, so the benchmark can
+	 * sweep both separately. The expressions use every operator and
+	 * function, both prefix operators, parentheses, some stray spaces and,
+	 * with use_vars set, the variables 'a' to 'e'. Whether evaluating them
+	 * succeeds is left to chance: some overflow or divide by zero, as real
+	 * input does. The same seed always generates the same expressions, and
+	 * is advanced so that the next call generates a different one.
+	 */
+	generator_t gen = {seed, use_vars, dest_array, dest_array + size - 1, 0};
+	if (size < LEAF_SIZE + 1)
+	{
+		dest_array[0] = '\0';
+		return 0;
+	}
+	expression(&gen, depth);
+	*gen.writer = '\0';
+	return (size_t)(gen.writer - dest_array);
+} //end size_t bench_gen()
@@ -0,0 +1,232 @@
+/* This is the benchmark of the calculator's core ("make bench" builds it as
+ * src/claytor-bench.) It generates a set of random expressions (see
+ * bench_gen()) of a chosen nesting depth ("-d") and length ("-l"), as many as
+ * asked for ("-n", from the seed given by "-s"), and times every stage of
+ * evaluating them separately, over the whole set at once:
+ * 1) tokenizing, lex_next() over every expression until its end,
+ * 2) parsing, ast_parse() into an AST,
+ * 3) evaluating the ASTs as they were parsed, through ast_eval(),
+ * 4) folding and compiling the ASTs into programs, through ast_fold() and
+ * prog_compile(),
+ * 5) evaluating those programs, through prog_eval(),
+ * 6) end to end, parsing, evaluating and formatting every expression exactly
+ * like batch mode does for every line.
+ * Every stage reports its time per expression and its throughput, along
+ * with how many allocations (malloc(), calloc() and realloc() calls) and
+ * bytes it asked for per expression. The allocations are counted by a shim
+ * that the linker puts in front of the allocator ("-Wl,--wrap"), so the
+ * calculator itself is measured exactly as it is built otherwise.
+ */
+
+# include "../src/claytor.h"
+
+# define BENCH_COUNT	10000	//expressions generated by default
+# define BENCH_DEPTH	6		//default nesting depth of the expressions
+# define BENCH_LENGTH	256		//default limit of the length of the expressions
+
+# if defined(CALC_MODE_RATIONAL)
+# define MODE_NAME		"rational"
+# elif defined(CALC_MODE_BIGNUM)
+# define MODE_NAME		"bignum"
+# elif defined(CALC_MODE_INT128)
+# define MODE_NAME		"int128"
+# elif defined(CALC_MODE_DOUBLE)
+# define MODE_NAME		"double"
+# else
+# define MODE_NAME		"int64"
+# endif
+
+/* COUNTING ALLOCATOR
+ * Only the calls made by the objects being linked are redirected, so the
+ * allocations of the C library itself (stdio buffers and the like) aren't
+ * counted.
+ */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+static uint64_t n_allocs = 0;
+static uint64_t n_bytes = 0;
+
+void *__wrap_malloc(size_t size)
+{
+	n_allocs++;
+	n_bytes += size;
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+	n_allocs++;
+	n_bytes += count * size;
+	return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	n_allocs++;
+	n_bytes += size;
+	return __real_realloc(ptr, size);
+}
+
+typedef struct stage
+{
+	/* What a stage started from: the time and the allocator's counters. */
+	struct timespec start;
+	uint64_t allocs;
+	uint64_t bytes;
+} stage_t;
+
+static void stage_start(stage_t *stage)
+{
+	stage->allocs = n_allocs;
+	stage->bytes = n_bytes;
+	clock_gettime(CLOCK_MONOTONIC, &stage->start);
+}
+
+static void stage_report(const stage_t *stage, const char *name, size_t count)
+{
+	/* Prints the time, throughput and allocations of a stage that just
+	 * processed count expressions.
+	 */
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	double seconds = (double)(now.tv_sec - stage->start.tv_sec) + ((double)(now.tv_nsec - stage->start.tv_nsec) / 1e9);
+	printf("%-16s %10.3f ms %10.1f ns/expr %12.0f expr/s %8.2f allocs/expr %10.1f bytes/expr\n",
+		name, seconds * 1e3, (seconds * 1e9) / count, (seconds > 0)? count / seconds : 0,
+		(double)(n_allocs - stage->allocs) / count, (double)(n_bytes - stage->bytes) / count);
+}
+
+static long parse_flag(int argc, char **argv, int *argv_x, long min, long max)
+{
+	/* Reads the value of a flag, which has to be between min and max. */
+	long value = (*argv_x + 1 < argc)? strtol(argv[++(*argv_x)], NULL, BASE) : min - 1;
+	if ((value < min) || (value > max))
+	{
+		fprintf(stderr, "claytor-bench: \"%s\" expects %ld to %ld.\n", argv[*argv_x], min, max);
+		exit(EXIT_FAILURE);
+	}
+	return value;
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = BENCH_COUNT;
+	uint8_t depth = BENCH_DEPTH;
+	size_t length = BENCH_LENGTH;
+	uint64_t seed = 0x9E3779B97F4A7C15ULL;
+	for (int argv_x = 1; argv_x < argc; argv_x++)
+	{
+		if (strcmp(argv[argv_x], "-n") == 0) count = parse_flag(argc, argv, &argv_x, 1, 100000000);
+		else if (strcmp(argv[argv_x], "-d") == 0) depth = parse_flag(argc, argv, &argv_x, 0, 64);
+		else if (strcmp(argv[argv_x], "-l") == 0) length = parse_flag(argc, argv, &argv_x, 32, 1 << 20);
+		else if (strcmp(argv[argv_x], "-s") == 0) seed = parse_flag(argc, argv, &argv_x, 1, INT32_MAX);
+		else
+		{
+			fprintf(stderr, "usage: claytor-bench [-n expressions] [-d depth] [-l length] [-s seed]\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* The expressions are generated up front into one arena, so generating
+	 * them is neither timed nor counted.
+	 */
+	char *text = malloc(count * (length + 1));
+	char **exprs = malloc(count * sizeof(char *));
+	calc_ast_t *asts = calloc(count, sizeof(calc_ast_t));
+	calc_prog_t *progs = calloc(count, sizeof(calc_prog_t));
+	if ((text == NULL) || (exprs == NULL) || (asts == NULL) || (progs == NULL))
+	{
+		fprintf(stderr, "claytor-bench: Error allocating %zu expressions.\n", count);
+		return EXIT_FAILURE;
+	}
+	size_t total_length = REF_INACTIVE;
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		exprs[expr] = text + (expr * (length + 1));
+		total_length += bench_gen(&seed, depth, REF_INACTIVE, exprs[expr], length + 1);
+	}
+
+	size_t n_tokens = REF_INACTIVE;
+	size_t n_failed = REF_INACTIVE;
+	stage_t stage;
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		calc_token_t token = {TOKEN_END, 0, 0, VALUE_INT(REF_INACTIVE)};
+		size_t offset = REF_INACTIVE;
+		do
+		{
+			if (lex_next(exprs[expr], &offset, token.kind, &token) != CALC_OK) break;
+			if (token.kind == TOKEN_NUMBER) value_release(&token.value);
+			n_tokens++;
+		} while (token.kind != TOKEN_END);
+	}
+	printf("%zu expressions (depth %u, %.1f characters and %.1f tokens on average, %s mode)\n\n",
+		count, depth, (double)total_length / count, (double)n_tokens / count,
+		MODE_NAME);
+	stage_report(&stage, "tokenize", count);
+
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++) ast_parse(exprs[expr], &asts[expr]);
+	stage_report(&stage, "parse", count);
+
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		calc_value_t result = VALUE_INT(REF_INACTIVE);
+		if (ast_eval(&asts[expr], NULL, &result) == CALC_OK) value_release(&result);
+		else n_failed++;
+	}
+	stage_report(&stage, "eval (AST)", count);
+
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		ast_fold(&asts[expr]);
+		prog_compile(&asts[expr], &progs[expr]);
+	}
+	stage_report(&stage, "fold + compile", count);
+
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		calc_value_t result = VALUE_INT(REF_INACTIVE);
+		if (prog_eval(&progs[expr], NULL, &result) == CALC_OK) value_release(&result);
+	}
+	stage_report(&stage, "eval (program)", count);
+
+	char scratch[RESULT_SIZE] = {REF_INACTIVE};
+	size_t n_chars = REF_INACTIVE;
+	stage_start(&stage);
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		calc_ast_t ast = {NULL, 0, 0, 0};
+		calc_value_t result = VALUE_INT(REF_INACTIVE);
+		if (ast_parse(exprs[expr], &ast) != CALC_OK) continue;
+		uint8_t status = ast_eval(&ast, NULL, &result);
+		ast_free(&ast);
+		if (status != CALC_OK) continue;
+		char *formatted = value_string(result, scratch, RESULT_SIZE);
+		if (formatted != NULL) n_chars += strlen(formatted);
+		if (formatted != scratch) free(formatted);
+		value_release(&result);
+	}
+	stage_report(&stage, "end to end", count);
+	printf("\n%zu expressions (%.1f%%) failed to evaluate, %zu result characters formatted.\n",
+		n_failed, (100.0 * n_failed) / count, n_chars);
+
+	for (size_t expr = 0; expr < count; expr++)
+	{
+		ast_free(&asts[expr]);
+		prog_free(&progs[expr]);
+	}
+	free(progs);
+	free(asts);
+	free(exprs);
+	free(text);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/* This is the differential fuzz target of the calculator ("make fuzz" builds
+ * it as src/claytor-fuzz.) Every input is taken as an expression, and every
+ * way the calculator has of evaluating one has to agree on its outcome. The
+ * reference is the most direct of them, ast_eval() over the AST exactly as
+ * ast_parse() built it; it is checked against:
+ * 1) ast_eval() over the AST once folded by ast_fold(),
+ * 2) prog_eval() over the program compiled from the folded AST,
+ * 3) col_eval() over a table of FUZZ_ROWS rows, a block at a time,
+ * 4) col_eval() through native code, wherever jit_compile() can translate
+ * the program,
+ * 5) claytor_eval(), the library's way in.
+ * Every row of the table binds the variables to a different mix of edge
+ * cases (see samples), and every path is evaluated for every row, so the
+ * same expression is also checked at the limits of the numeric mode. Both
+ * the status and the result have to match, and if they don't, the input,
+ * the row and both outcomes are printed and the target aborts, which is
+ * what fuzzers recognise as a crash.
+ * Built with libFuzzer (the default, "make fuzz") the fuzzer drives the
+ * target. Built without it ("make fuzz FUZZ_CC=afl-clang-fast FUZZ_SAN=address"
+ * for AFL, or FUZZ_CC=gcc to replay inputs), every file named on the command
+ * line is one input, stdin is one if there are none, and "-r N" checks N
+ * random expressions from bench_gen() instead.
+ */
+
+# include "../src/claytor.h"
+
+# define FUZZ_INPUT		512	//longest input tried, longer ones are cut short
+# define FUZZ_ROWS		64	//rows every expression is evaluated for
+# define FUZZ_DEPTH		8	//nesting depth of the expressions "-r" generates
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/* The values the variables are bound to, row by row: zero, small values,
+ * and values at (and just past) the limits of the fixed-width modes.
+ */
+static const int64_t samples[] = {0, 1, -1, 2, -2, 3, 7, -10, 37, 1000, 3037000499, -3037000500,
+	INT32_MAX, INT32_MIN, 4611686018427387904, INT64_MAX, INT64_MIN, INT64_MIN + 1};
+
+static uint8_t same(uint8_t status_1, calc_value_t value_1, uint8_t status_2, calc_value_t value_2)
+{
+	/* Whether two outcomes agree: the same status and, if that is CALC_OK,
+	 * the same value. Doubles have to be identical down to the bit, so a
+	 * -0.0 where +0.0 is expected is a difference too.
+	 */
+	if (status_1 != status_2)
+	{
+		return REF_INACTIVE;
+	}
+	if (status_1 != CALC_OK)
+	{
+		return REF_ACTIVATE;
+	}
+# if defined(CALC_MODE_DOUBLE)
+	return memcmp(&value_1, &value_2, sizeof(calc_value_t)) == 0;
+# else
+	return value_cmp(value_1, value_2) == 0;
+# endif
+}
+
+static void check(const char *path, const char *src, size_t row, uint8_t ref_status, calc_value_t ref,
+	uint8_t status, calc_value_t value)
+{
+	/* Aborts with a report of both outcomes if a path disagrees with the
+	 * reference.
+	 */
+	if (same(ref_status, ref, status, value))
+	{
+		return;
+	}
+	char scratch_1[RESULT_SIZE] = {REF_INACTIVE};
+	char scratch_2[RESULT_SIZE] = {REF_INACTIVE};
+	char *text_1 = (ref_status == CALC_OK)? value_string(ref, scratch_1, RESULT_SIZE) : NULL;
+	char *text_2 = (status == CALC_OK)? value_string(value, scratch_2, RESULT_SIZE) : NULL;
+	fprintf(stderr, "claytor-fuzz: %s disagrees on \"%s\" (row %zu):\n", path, src, row);
+	fprintf(stderr, "\treference: %s %s\n\t%s: %s %s\n", calc_strerror(ref_status), (text_1 != NULL)? text_1 : "",
+		path, calc_strerror(status), (text_2 != NULL)? text_2 : "");
+	abort();
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	char src[FUZZ_INPUT + 1] = {REF_INACTIVE};
+	if (size > FUZZ_INPUT) size = FUZZ_INPUT;
+	memcpy(src, data, size);	//stops at the first NUL like any C string
+
+	calc_ast_t reference = {NULL, 0, 0, 0};
+	claytor_expr_t *expr = NULL;
+	uint8_t parsed = ast_parse(src, &reference);
+	uint8_t compiled = claytor_compile(src, &expr, NULL);
+	if ((parsed != CALC_OK) || (compiled != CALC_OK))
+	{
+		check("claytor_compile()", src, 0, parsed, VALUE_INT(REF_INACTIVE), compiled, VALUE_INT(REF_INACTIVE));
+		ast_free(&reference);
+		claytor_free(expr);
+		return 0;
+	}
+	calc_ast_t folded = {NULL, 0, 0, 0};
+	calc_prog_t prog = {NULL, 0, 0};
+	calc_jit_t jit = {NULL, NULL, 0};
+	col_table_t table = {{NULL}, NULL, FUZZ_ROWS};
+	calc_value_t col_results[FUZZ_ROWS];
+	calc_value_t jit_results[FUZZ_ROWS];
+	uint8_t col_status[FUZZ_ROWS] = {REF_INACTIVE};
+	uint8_t jit_status[FUZZ_ROWS] = {REF_INACTIVE};
+	uint8_t status = ast_parse(src, &folded);
+	ast_fold(&folded);
+	if (status == CALC_OK) status = prog_compile(&folded, &prog);
+	for (uint8_t var = 0; (status == CALC_OK) && (var < CALC_VARS); var++)
+	{
+		table.columns[var] = malloc(FUZZ_ROWS * sizeof(calc_value_t));
+		if (table.columns[var] == NULL) status = CALC_ENOMEM;
+		for (size_t row = 0; (status == CALC_OK) && (row < FUZZ_ROWS); row++)
+		{
+			table.columns[var][row] = VALUE_INT(samples[((row * 7) + var) % (sizeof(samples) / sizeof(samples[0]))]);
+		}
+	}
+	if (status == CALC_OK)
+	{
+		table.status = col_status;
+		status = col_eval(&prog, NULL, &table, col_results);
+	}
+	if ((status == CALC_OK) && (jit_compile(&prog, &jit) == CALC_OK))
+	{
+		table.status = jit_status;
+		status = col_eval(&prog, &jit, &table, jit_results);
+	}
+
+	for (size_t row = 0; (status == CALC_OK) && (row < FUZZ_ROWS); row++)
+	{
+		calc_value_t vars[CALC_VARS];
+		for (uint8_t var = 0; var < CALC_VARS; var++) vars[var] = table.columns[var][row];
+		calc_value_t ref = VALUE_INT(REF_INACTIVE);
+		calc_value_t value = VALUE_INT(REF_INACTIVE);
+		uint8_t ref_status = ast_eval(&reference, vars, &ref);
+		uint8_t value_status = ast_eval(&folded, vars, &value);
+		check("ast_fold()", src, row, ref_status, ref, value_status, value);
+		if (value_status == CALC_OK) value_release(&value);
+		value_status = prog_eval(&prog, vars, &value);
+		check("prog_eval()", src, row, ref_status, ref, value_status, value);
+		if (value_status == CALC_OK) value_release(&value);
+		value_status = claytor_eval(expr, vars, &value);
+		check("claytor_eval()", src, row, ref_status, ref, value_status, value);
+		if (value_status == CALC_OK) value_release(&value);
+		check("col_eval()", src, row, ref_status, ref, col_status[row], col_results[row]);
+		if (col_status[row] == CALC_OK) value_release(&col_results[row]);
+		if (jit.fn != NULL) check("jit_compile()", src, row, ref_status, ref, jit_status[row], jit_results[row]);
+		if (ref_status == CALC_OK) value_release(&ref);
+	} //end for-loop over rows
+
+	for (uint8_t var = 0; var < CALC_VARS; var++) free(table.columns[var]);	//the samples own no memory
+	jit_free(&jit);
+	prog_free(&prog);
+	ast_free(&folded);
+	ast_free(&reference);
+	claytor_free(expr);
+	return 0;
+} //end int LLVMFuzzerTestOneInput()
+
+# if defined(FUZZ_STANDALONE)
+static void run_file(FILE *src_file)
+{
+	/* Feeds a whole file to the target as one input. */
+	uint8_t data[FUZZ_INPUT] = {REF_INACTIVE};
+	size_t size = fread(data, 1, FUZZ_INPUT, src_file);
+	LLVMFuzzerTestOneInput(data, size);
+}
+
+int main(int argc, char **argv)
+{
+	if ((argc >= 3) && (strcmp(argv[1], "-r") == 0))
+	{
+		long count = strtol(argv[2], NULL, BASE);
+		uint64_t seed = (argc >= 4)? strtoull(argv[3], NULL, BASE) : 0x9E3779B97F4A7C15ULL;
+		char src[FUZZ_INPUT] = {REF_INACTIVE};
+		for (long input = 0; input < count; input++)
+		{
+			size_t len = bench_gen(&seed, FUZZ_DEPTH, REF_ACTIVATE, src, sizeof(src));
+			LLVMFuzzerTestOneInput((const uint8_t *)src, len);
+		}
+		fprintf(stderr, "claytor-fuzz: %ld random expressions checked, no differences.\n", count);
+		return EXIT_SUCCESS;
+	}
+	if (argc == 1)
+	{
+		run_file(stdin);
+		return EXIT_SUCCESS;
+	}
+	for (int argv_x = 1; argv_x < argc; argv_x++)
+	{
+		FILE *src_file = fopen(argv[argv_x], "rb");
+		if (src_file == NULL)
+		{
+			fprintf(stderr, "claytor-fuzz: Error accessing input \"%s\".\n", argv[argv_x]);
+			return EXIT_FAILURE;
+		}
+		run_file(src_file);
+		fclose(src_file);
+	}
+	return EXIT_SUCCESS;
+}
+# endif
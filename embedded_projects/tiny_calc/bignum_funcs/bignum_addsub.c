@@ -0,0 +1,51 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_addsub(calc_integer_t augend, calc_integer_t addend, uint8_t negate_addend, calc_integer_t *sum)
+{
+	/* This function is the slow path of op_add() and op_sub() in bignum mode,
+	 * taken once the checked int64_t fast path overflowed or either operand is
+	 * already big. Subtraction is addition with the addend's sign flipped.
+	 * Working on sign and magnitude: if both signs agree the magnitudes are
+	 * added and the sign kept; otherwise the smaller magnitude is subtracted
+	 * from the larger and the result takes the sign of the larger.
+	 */
+	uint32_t a_scratch[2], b_scratch[2];
+	const uint32_t *a_limbs, *b_limbs;
+	uint32_t a_len, b_len;
+	uint8_t a_negative, b_negative;
+	bignum_view(&augend, a_scratch, &a_limbs, &a_len, &a_negative);
+	bignum_view(&addend, b_scratch, &b_limbs, &b_len, &b_negative);
+	b_negative ^= (negate_addend != 0);
+
+	uint8_t subtract = (a_negative != b_negative);
+	if (bignum_cmp(a_limbs, a_len, b_limbs, b_len) < 0)
+	{
+		/* Keep the larger magnitude in a so that subtraction never borrows out
+		 * of the top limb.
+		 */
+		const uint32_t *swap_limbs = a_limbs; a_limbs = b_limbs; b_limbs = swap_limbs;
+		uint32_t swap_len = a_len; a_len = b_len; b_len = swap_len;
+		a_negative = b_negative;
+	}
+	calc_bignum_t *big = bignum_alloc(a_len + 1);
+	if (big == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	int64_t carry = REF_INACTIVE;	//a carry when adding, a borrow (negative) when subtracting
+	for (uint32_t index = 0; index < a_len; index++)
+	{
+		int64_t limb = (int64_t)a_limbs[index] + carry;
+		if (index < b_len)
+		{
+			limb += (subtract)? -(int64_t)b_limbs[index] : (int64_t)b_limbs[index];
+		}
+		big->limbs[index] = (uint32_t)limb;
+		carry = limb >> LIMB_BITS;	//arithmetic shift: -1 for a borrow, 1 for a carry
+	}
+	big->limbs[a_len] = (uint32_t)carry;
+	big->len = a_len + 1;
+	big->negative = a_negative;
+	*sum = bignum_normalize(big);
+	return CALC_OK;
+} //end uint8_t bignum_addsub()
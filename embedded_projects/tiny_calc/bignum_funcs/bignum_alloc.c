@@ -0,0 +1,17 @@
+# include "../src/claytor.h"
+
+calc_bignum_t *bignum_alloc(uint32_t cap)
+{
+	/* This function allocates the heap part of a bignum with room for cap
+	 * limbs, all of them zeroed, in a single allocation (the limbs are a
+	 * flexible array member.) NULL is returned if the allocation failed, which
+	 * the callers report as CALC_ENOMEM.
+	 */
+	calc_bignum_t *big = calloc(1, sizeof(calc_bignum_t) + ((size_t)cap * sizeof(uint32_t)));
+	if (big == NULL)
+	{
+		return NULL;
+	}
+	big->cap = cap;
+	return big;
+} //end calc_bignum_t *bignum_alloc()
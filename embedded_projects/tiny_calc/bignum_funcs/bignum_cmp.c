@@ -0,0 +1,22 @@
+# include "../src/claytor.h"
+
+int bignum_cmp(const uint32_t *a_limbs, uint32_t a_len, const uint32_t *b_limbs, uint32_t b_len)
+{
+	/* This function compares two limb magnitudes without leading zero limbs,
+	 * returning a negative, zero or positive value like memcmp() does. The
+	 * longer magnitude is always the larger one; otherwise limbs are compared
+	 * from the most significant down.
+	 */
+	if (a_len != b_len)
+	{
+		return (a_len > b_len)? 1 : -1;
+	}
+	for (uint32_t index = a_len; index-- > 0;)
+	{
+		if (a_limbs[index] != b_limbs[index])
+		{
+			return (a_limbs[index] > b_limbs[index])? 1 : -1;
+		}
+	}
+	return 0;
+} //end int bignum_cmp()
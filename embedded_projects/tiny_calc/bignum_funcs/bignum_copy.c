@@ -0,0 +1,26 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_copy(calc_integer_t src, calc_integer_t *dest)
+{
+	/* This function makes an independent copy of an integer (value_copy() in
+	 * bignum mode), so that both the source and the copy can be released
+	 * separately. Small values are simply assigned; big ones get a bignum of
+	 * their own.
+	 */
+	if (src.big == NULL)
+	{
+		*dest = src;
+		return CALC_OK;
+	}
+	calc_bignum_t *big = bignum_alloc(src.big->len);
+	if (big == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	memcpy(big->limbs, src.big->limbs, (size_t)src.big->len * sizeof(uint32_t));
+	big->len = src.big->len;
+	big->negative = src.big->negative;
+	dest->small = REF_INACTIVE;
+	dest->big = big;
+	return CALC_OK;
+} //end uint8_t bignum_copy()
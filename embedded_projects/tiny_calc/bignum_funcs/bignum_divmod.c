@@ -0,0 +1,161 @@
+# include "../src/claytor.h"
+
+static void limbs_divmod(uint32_t *quot, uint32_t *rem, uint32_t *dividend, uint32_t m, const uint32_t *divisor, uint32_t n, uint32_t *norm_div)
+{
+	/* Knuth's algorithm D (TAOCP vol. 2, 4.3.1) on 32 bit limbs, dividing an m
+	 * limb dividend by an n limb divisor (n >= 2, m >= n, no leading zeros.)
+	 * The divisor is shifted left until its top bit is set, which guarantees
+	 * that every estimate of a quotient limb from the top two dividend limbs
+	 * is at most two too large. Each estimate is corrected against the top
+	 * two divisor limbs and then multiplied and subtracted out; the rare case
+	 * where it was still one too large is undone by adding the divisor back.
+	 * dividend has to have room for m + 1 limbs and is destroyed in the
+	 * process; norm_div is scratch for n limbs. The remainder is shifted back
+	 * down into rem, which may be NULL if it isn't wanted.
+	 */
+	const uint64_t limb_base = (uint64_t)1 << LIMB_BITS;
+	int shift = __builtin_clz(divisor[n - 1]);
+	for (uint32_t index = n - 1; index > 0; index--)
+	{
+		norm_div[index] = (uint32_t)((divisor[index] << shift) | ((uint64_t)divisor[index - 1] >> (LIMB_BITS - shift)));
+	}
+	norm_div[0] = divisor[0] << shift;
+	dividend[m] = (uint32_t)((uint64_t)dividend[m - 1] >> (LIMB_BITS - shift));
+	for (uint32_t index = m - 1; index > 0; index--)
+	{
+		dividend[index] = (uint32_t)((dividend[index] << shift) | ((uint64_t)dividend[index - 1] >> (LIMB_BITS - shift)));
+	}
+	dividend[0] <<= shift;
+
+	for (uint32_t step = m - n + 1; step-- > 0;)
+	{
+		uint64_t top = ((uint64_t)dividend[step + n] << LIMB_BITS) | dividend[step + n - 1];
+		uint64_t q_hat = top / norm_div[n - 1];
+		uint64_t r_hat = top % norm_div[n - 1];
+		while ((q_hat >= limb_base) ||
+			   (q_hat * norm_div[n - 2] > ((r_hat << LIMB_BITS) | dividend[step + n - 2])))
+		{
+			q_hat--;
+			r_hat += norm_div[n - 1];
+			if (r_hat >= limb_base) break;
+		}
+		/* Multiply and subtract q_hat * divisor from the current window.
+		 */
+		int64_t borrow = REF_INACTIVE;
+		uint64_t carry = REF_INACTIVE;
+		for (uint32_t index = 0; index < n; index++)
+		{
+			uint64_t product = q_hat * norm_div[index] + carry;
+			carry = product >> LIMB_BITS;
+			borrow += (int64_t)dividend[step + index] - (int64_t)(uint32_t)product;
+			dividend[step + index] = (uint32_t)borrow;
+			borrow >>= LIMB_BITS;
+		}
+		borrow += (int64_t)dividend[step + n] - (int64_t)carry;
+		dividend[step + n] = (uint32_t)borrow;
+		if (borrow < 0)
+		{
+			/* q_hat was one too large: add the divisor back once.
+			 */
+			q_hat--;
+			uint64_t add_carry = REF_INACTIVE;
+			for (uint32_t index = 0; index < n; index++)
+			{
+				add_carry += (uint64_t)dividend[step + index] + norm_div[index];
+				dividend[step + index] = (uint32_t)add_carry;
+				add_carry >>= LIMB_BITS;
+			}
+			dividend[step + n] += (uint32_t)add_carry;
+		}
+		quot[step] = (uint32_t)q_hat;
+	} //end for-loop over quotient limbs
+
+	if (rem != NULL)
+	{
+		for (uint32_t index = 0; index < n - 1; index++)
+		{
+			rem[index] = (uint32_t)((dividend[index] >> shift) | ((uint64_t)dividend[index + 1] << (LIMB_BITS - shift)));
+		}
+		rem[n - 1] = dividend[n - 1] >> shift;
+	}
+}
+
+uint8_t bignum_divmod(calc_integer_t dividend, calc_integer_t divisor, calc_integer_t *quotient, calc_integer_t *remainder)
+{
+	/* This function is the slow path of op_div() in bignum mode: truncating
+	 * division, like C's own, so the quotient is rounded towards zero and the
+	 * remainder takes the sign of the dividend. A dividend smaller than the
+	 * divisor gives a zero quotient straight away, a single limb divisor is
+	 * handled by simple short division, and anything longer goes through
+	 * algorithm D. remainder may be NULL if only the quotient is wanted.
+	 */
+	uint32_t a_scratch[2], b_scratch[2];
+	const uint32_t *a_limbs, *b_limbs;
+	uint32_t a_len, b_len;
+	uint8_t a_negative, b_negative;
+	bignum_view(&dividend, a_scratch, &a_limbs, &a_len, &a_negative);
+	bignum_view(&divisor, b_scratch, &b_limbs, &b_len, &b_negative);
+	if (b_len == 0)
+	{
+		return CALC_EDIVZERO;
+	}
+	if (bignum_cmp(a_limbs, a_len, b_limbs, b_len) < 0)
+	{
+		if (remainder != NULL)
+		{
+			calc_bignum_t *rem = bignum_alloc(a_len);
+			if (rem == NULL)
+			{
+				return CALC_ENOMEM;
+			}
+			memcpy(rem->limbs, a_limbs, (size_t)a_len * sizeof(uint32_t));
+			rem->len = a_len;
+			rem->negative = a_negative;
+			*remainder = bignum_normalize(rem);
+		}
+		*quotient = INTEGER_INT(REF_INACTIVE);
+		return CALC_OK;
+	}
+
+	calc_bignum_t *quot = bignum_alloc(a_len - b_len + 1);
+	calc_bignum_t *rem = bignum_alloc(b_len);
+	uint32_t *work = malloc(((size_t)a_len + 1 + b_len) * sizeof(uint32_t));
+	if ((quot == NULL) || (rem == NULL) || (work == NULL))
+	{
+		free(quot);
+		free(rem);
+		free(work);
+		return CALC_ENOMEM;
+	}
+	if (b_len == 1)
+	{
+		uint64_t partial = REF_INACTIVE;
+		for (uint32_t index = a_len; index-- > 0;)
+		{
+			partial = (partial << LIMB_BITS) | a_limbs[index];
+			quot->limbs[index] = (uint32_t)(partial / b_limbs[0]);
+			partial %= b_limbs[0];
+		}
+		rem->limbs[0] = (uint32_t)partial;
+	}
+	else
+	{
+		memcpy(work, a_limbs, (size_t)a_len * sizeof(uint32_t));
+		limbs_divmod(quot->limbs, rem->limbs, work, a_len, b_limbs, b_len, work + a_len + 1);
+	}
+	free(work);
+	quot->len = a_len - b_len + 1;
+	quot->negative = (a_negative != b_negative);
+	rem->len = b_len;
+	rem->negative = a_negative;
+	*quotient = bignum_normalize(quot);
+	if (remainder != NULL)
+	{
+		*remainder = bignum_normalize(rem);
+	}
+	else
+	{
+		free(rem);
+	}
+	return CALC_OK;
+} //end uint8_t bignum_divmod()
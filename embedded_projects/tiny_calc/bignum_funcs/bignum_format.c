@@ -0,0 +1,64 @@
+# include "../src/claytor.h"
+
+int bignum_format(calc_integer_t value, char *dest_array, size_t size)
+{
+	/* This function is value_format() for bignum mode and, like snprintf(),
+	 * returns the full length of the number even if only part of it fit into
+	 * dest_array. Small values are printed directly. Big ones are converted by
+	 * repeatedly dividing a copy of the magnitude by LIMB_DECIMAL, each
+	 * remainder being the next nine decimal digits from the bottom up; these
+	 * are then printed most significant first, zero-padded except for the
+	 * leading group. -1 is returned if the scratch memory couldn't be had.
+	 */
+	if (value.big == NULL)
+	{
+		return snprintf(dest_array, size, "%lld", (long long)value.small);
+	}
+	uint32_t len = value.big->len;
+	uint32_t *magnitude = malloc((size_t)len * sizeof(uint32_t));
+	uint32_t *groups = malloc(((size_t)len * 2 + 1) * sizeof(uint32_t)); //2^32 < 10^18, so at most two groups per limb
+	if ((magnitude == NULL) || (groups == NULL))
+	{
+		free(magnitude);
+		free(groups);
+		return -1;
+	}
+	memcpy(magnitude, value.big->limbs, (size_t)len * sizeof(uint32_t));
+	size_t n_groups = REF_INACTIVE;
+	while (len > 0)
+	{
+		uint64_t partial = REF_INACTIVE;
+		for (uint32_t index = len; index-- > 0;)
+		{
+			partial = (partial << LIMB_BITS) | magnitude[index];
+			magnitude[index] = (uint32_t)(partial / LIMB_DECIMAL);
+			partial %= LIMB_DECIMAL;
+		}
+		groups[n_groups++] = (uint32_t)partial;
+		while ((len > 0) && (magnitude[len - 1] == 0)) len--;
+	}
+
+	/* Every group is printed into a small buffer first so that the number can
+	 * be both measured and truncated to whatever room the caller gave.
+	 */
+	int written = REF_INACTIVE;
+	char group_text[LIMB_DIGITS + 2] = {REF_INACTIVE};
+	if (value.big->negative)
+	{
+		if (size > 1) *dest_array++ = '-', size--;
+		written++;
+	}
+	for (size_t group = n_groups; group-- > 0;)
+	{
+		int group_len = snprintf(group_text, sizeof(group_text), (group == n_groups - 1)? "%u" : "%09u", groups[group]);
+		for (int index = 0; index < group_len; index++)
+		{
+			if (size > 1) *dest_array++ = group_text[index], size--;
+		}
+		written += group_len;
+	}
+	if (size > 0) *dest_array = 0;
+	free(magnitude);
+	free(groups);
+	return written;
+} //end int bignum_format()
@@ -0,0 +1,48 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_gcd(calc_integer_t integer_1, calc_integer_t integer_2, calc_integer_t *gcd)
+{
+	/* This function computes the greatest common divisor of two integers,
+	 * which is never negative, and is 0 only if both integers are. It is the
+	 * slow path of rational_make(): Euclid's algorithm, one division by
+	 * bignum_divmod() per step, since every step shortens the operands by
+	 * about a limb's worth of bits where a binary GCD would only shift out a
+	 * few. Once both operands fit into 64 bits the remainders are computed
+	 * natively.
+	 */
+	calc_integer_t dividend = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t divisor = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_copy(integer_1, &dividend);
+	if (status == CALC_OK) status = bignum_copy(integer_2, &divisor);
+	while ((status == CALC_OK) && !INTEGER_IS(divisor, 0))
+	{
+		calc_integer_t remainder = INTEGER_INT(REF_INACTIVE);
+		if ((dividend.big == NULL) && (divisor.big == NULL))
+		{
+			remainder = INTEGER_INT((divisor.small == -1)? 0 : dividend.small % divisor.small);
+		}
+		else
+		{
+			calc_integer_t quotient = INTEGER_INT(REF_INACTIVE);
+			status = bignum_divmod(dividend, divisor, &quotient, &remainder);
+			bignum_release(&quotient);
+		}
+		bignum_release(&dividend);
+		dividend = divisor;
+		divisor = remainder;
+	} //end while (the divisor isn't 0)
+	bignum_release(&divisor);
+	if ((status == CALC_OK) && INTEGER_NEGATIVE(dividend))
+	{
+		status = bignum_addsub(INTEGER_INT(REF_INACTIVE), dividend, REF_ACTIVATE, gcd);
+		bignum_release(&dividend);
+		return status;
+	}
+	if (status != CALC_OK)
+	{
+		bignum_release(&dividend);
+		return status;
+	}
+	*gcd = dividend;
+	return CALC_OK;
+} //end uint8_t bignum_gcd()
@@ -0,0 +1,72 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_isqrt(calc_integer_t square, calc_integer_t *root)
+{
+	/* This function computes the integer square root of a non-negative
+	 * integer, the largest root whose square doesn't exceed it, for sqrt() in
+	 * bignum and rational mode. It is Newton's iteration x = (x + n/x) / 2
+	 * started from a power of two no smaller than the root, which only ever
+	 * decreases and stops as soon as it doesn't. Integers that fit into 64
+	 * bits take the same steps natively.
+	 */
+	if (square.big == NULL)
+	{
+		if (square.small < 2)
+		{
+			*root = square;
+			return CALC_OK;
+		}
+		uint8_t bits = LIMB_BITS * 2 - __builtin_clzll((uint64_t)square.small);
+		int64_t guess = (int64_t)1 << ((bits + 1) / 2);
+		for (;;)
+		{
+			int64_t next = (guess + (square.small / guess)) / 2;
+			if (next >= guess) break;
+			guess = next;
+		}
+		*root = INTEGER_INT(guess);
+		return CALC_OK;
+	}
+	uint64_t bits = ((uint64_t)(square.big->len - 1) * LIMB_BITS) + (LIMB_BITS - __builtin_clz(square.big->limbs[square.big->len - 1]));
+	uint64_t half = (bits + 1) / 2;
+	calc_bignum_t *power = bignum_alloc((uint32_t)(half / LIMB_BITS) + 1);
+	if (power == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	power->len = power->cap;
+	power->limbs[half / LIMB_BITS] = (uint32_t)1 << (half % LIMB_BITS);
+	calc_integer_t guess = bignum_normalize(power);
+	uint8_t status = CALC_OK;
+	for (;;)
+	{
+		calc_integer_t quotient = INTEGER_INT(REF_INACTIVE);
+		calc_integer_t sum = INTEGER_INT(REF_INACTIVE);
+		calc_integer_t next = INTEGER_INT(REF_INACTIVE);
+		status = bignum_divmod(square, guess, &quotient, NULL);
+		if (status == CALC_OK) status = bignum_addsub(guess, quotient, REF_INACTIVE, &sum);
+		if (status == CALC_OK) status = bignum_divmod(sum, INTEGER_INT(2), &next, NULL);
+		bignum_release(&quotient);
+		bignum_release(&sum);
+		uint32_t next_scratch[2], guess_scratch[2];
+		const uint32_t *next_limbs, *guess_limbs;
+		uint32_t next_len, guess_len;
+		uint8_t negative;
+		bignum_view(&next, next_scratch, &next_limbs, &next_len, &negative);
+		bignum_view(&guess, guess_scratch, &guess_limbs, &guess_len, &negative);
+		if ((status != CALC_OK) || (bignum_cmp(next_limbs, next_len, guess_limbs, guess_len) >= 0))
+		{
+			bignum_release(&next);
+			break;
+		}
+		bignum_release(&guess);
+		guess = next;
+	} //end for-loop over Newton steps
+	if (status != CALC_OK)
+	{
+		bignum_release(&guess);
+		return status;
+	}
+	*root = guess;
+	return CALC_OK;
+} //end uint8_t bignum_isqrt()
@@ -0,0 +1,32 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_mul(calc_integer_t multiplicand, calc_integer_t multiplier, calc_integer_t *prod)
+{
+	/* This function is the slow path of op_mul() in bignum mode. The product of
+	 * two magnitudes is at most as long as both of them together, so that is
+	 * allocated up front, filled by bignum_mul_limbs() and then normalised
+	 * (which demotes the product again if it happens to fit into 64 bits.)
+	 */
+	uint32_t a_scratch[2], b_scratch[2];
+	const uint32_t *a_limbs, *b_limbs;
+	uint32_t a_len, b_len;
+	uint8_t a_negative, b_negative;
+	bignum_view(&multiplicand, a_scratch, &a_limbs, &a_len, &a_negative);
+	bignum_view(&multiplier, b_scratch, &b_limbs, &b_len, &b_negative);
+
+	calc_bignum_t *big = bignum_alloc(a_len + b_len);
+	if (big == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	uint8_t status = bignum_mul_limbs(big->limbs, a_limbs, a_len, b_limbs, b_len);
+	if (status != CALC_OK)
+	{
+		free(big);
+		return status;
+	}
+	big->len = a_len + b_len;
+	big->negative = (a_negative != b_negative);
+	*prod = bignum_normalize(big);
+	return CALC_OK;
+} //end uint8_t bignum_mul()
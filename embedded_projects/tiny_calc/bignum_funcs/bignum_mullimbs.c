@@ -0,0 +1,145 @@
+# include "../src/claytor.h"
+
+static uint32_t limbs_add_into(uint32_t *dest, uint32_t dest_len, const uint32_t *src, uint32_t src_len)
+{
+	/* dest += src over dest_len limbs (src_len <= dest_len), returning the
+	 * carry out of the top limb.
+	 */
+	uint64_t carry = REF_INACTIVE;
+	uint32_t index = REF_INACTIVE;
+	for (; index < src_len; index++)
+	{
+		carry += (uint64_t)dest[index] + src[index];
+		dest[index] = (uint32_t)carry;
+		carry >>= LIMB_BITS;
+	}
+	for (; (carry != 0) && (index < dest_len); index++)
+	{
+		carry += dest[index];
+		dest[index] = (uint32_t)carry;
+		carry >>= LIMB_BITS;
+	}
+	return (uint32_t)carry;
+}
+
+static void limbs_sub_into(uint32_t *dest, uint32_t dest_len, const uint32_t *src, uint32_t src_len)
+{
+	/* dest -= src over dest_len limbs, where dest is known to be the larger.
+	 */
+	int64_t borrow = REF_INACTIVE;
+	uint32_t index = REF_INACTIVE;
+	for (; index < src_len; index++)
+	{
+		borrow += (int64_t)dest[index] - src[index];
+		dest[index] = (uint32_t)borrow;
+		borrow >>= LIMB_BITS;
+	}
+	for (; (borrow != 0) && (index < dest_len); index++)
+	{
+		borrow += dest[index];
+		dest[index] = (uint32_t)borrow;
+		borrow >>= LIMB_BITS;
+	}
+}
+
+uint8_t bignum_mul_limbs(uint32_t *prod, const uint32_t *a_limbs, uint32_t a_len, const uint32_t *b_limbs, uint32_t b_len)
+{
+	/* This function multiplies two limb magnitudes into prod, which has to have
+	 * room for a_len + b_len limbs (every one of which is written.) Operands
+	 * shorter than KARATSUBA_LIMBS are multiplied the schoolbook way, which is
+	 * O(n*m) but has tiny constants. Above the threshold the Karatsuba split
+	 * is used: with a = a1*B^m + a0 and b = b1*B^m + b0,
+	 * 		a*b = z2*B^2m + z1*B^m + z0, where
+	 * 		z0 = a0*b0, z2 = a1*b1 and z1 = (a0 + a1)*(b0 + b1) - z0 - z2,
+	 * which needs three half-size products instead of four and gives roughly
+	 * O(n^1.58) overall. z0 and z2 are computed straight into the low and high
+	 * halves of prod. If b is less than half as long as a, a is split alone
+	 * and both halves are multiplied by the whole of b instead. The scratch
+	 * memory for the sums and z1 is allocated once per level of recursion.
+	 */
+	if (a_len < b_len)
+	{
+		const uint32_t *swap_limbs = a_limbs; a_limbs = b_limbs; b_limbs = swap_limbs;
+		uint32_t swap_len = a_len; a_len = b_len; b_len = swap_len;
+	}
+	memset(prod, 0, ((size_t)a_len + b_len) * sizeof(uint32_t));
+	if (b_len < KARATSUBA_LIMBS)
+	{
+		for (uint32_t b_index = 0; b_index < b_len; b_index++)
+		{
+			uint64_t carry = REF_INACTIVE;
+			uint64_t multiplier = b_limbs[b_index];
+			for (uint32_t a_index = 0; a_index < a_len; a_index++)
+			{
+				carry += (uint64_t)a_limbs[a_index] * multiplier + prod[a_index + b_index];
+				prod[a_index + b_index] = (uint32_t)carry;
+				carry >>= LIMB_BITS;
+			}
+			prod[a_len + b_index] = (uint32_t)carry;
+		}
+		return CALC_OK;
+	} //end if (b_len < KARATSUBA_LIMBS)
+
+	uint32_t half = (a_len + 1) / 2;
+	if (b_len <= half)
+	{
+		/* Unbalanced operands: a0*b goes straight into prod, a1*b into scratch
+		 * which is then added in at an offset of half limbs.
+		 */
+		uint32_t high_len = a_len - half + b_len;
+		uint32_t *high = malloc((size_t)high_len * sizeof(uint32_t));
+		if (high == NULL)
+		{
+			return CALC_ENOMEM;
+		}
+		uint8_t status = bignum_mul_limbs(prod, a_limbs, half, b_limbs, b_len);
+		if (status == CALC_OK)
+		{
+			status = bignum_mul_limbs(high, a_limbs + half, a_len - half, b_limbs, b_len);
+		}
+		if (status == CALC_OK)
+		{
+			limbs_add_into(prod + half, a_len + b_len - half, high, high_len);
+		}
+		free(high);
+		return status;
+	} //end if (b_len <= half)
+
+	/* Balanced operands: both halves of a and b are at most half limbs long,
+	 * so each sum fits half + 1 limbs and their product 2*half + 2 limbs.
+	 */
+	uint32_t *scratch = malloc(((size_t)4 * half + 4) * sizeof(uint32_t));
+	if (scratch == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	uint32_t *a_sum = scratch;
+	uint32_t *b_sum = a_sum + half + 1;
+	uint32_t *middle = b_sum + half + 1;
+	uint32_t middle_len = 2 * half + 2;
+
+	memset(scratch, 0, ((size_t)2 * half + 2) * sizeof(uint32_t));
+	memcpy(a_sum, a_limbs, (size_t)half * sizeof(uint32_t));
+	a_sum[half] = limbs_add_into(a_sum, half, a_limbs + half, a_len - half);
+	memcpy(b_sum, b_limbs, (size_t)half * sizeof(uint32_t));
+	b_sum[half] = limbs_add_into(b_sum, half, b_limbs + half, b_len - half);
+
+	uint8_t status = bignum_mul_limbs(prod, a_limbs, half, b_limbs, half);
+	if (status == CALC_OK)
+	{
+		status = bignum_mul_limbs(prod + 2 * half, a_limbs + half, a_len - half, b_limbs + half, b_len - half);
+	}
+	if (status == CALC_OK)
+	{
+		status = bignum_mul_limbs(middle, a_sum, half + 1, b_sum, half + 1);
+	}
+	if (status == CALC_OK)
+	{
+		limbs_sub_into(middle, middle_len, prod, 2 * half);
+		limbs_sub_into(middle, middle_len, prod + 2 * half, a_len + b_len - 2 * half);
+		while ((middle_len > 0) && (middle[middle_len - 1] == 0)) middle_len--;
+		limbs_add_into(prod + half, a_len + b_len - half, middle, middle_len);
+	}
+	free(scratch);
+	return status;
+} //end uint8_t bignum_mul_limbs()
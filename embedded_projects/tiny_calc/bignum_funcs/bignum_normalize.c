@@ -0,0 +1,30 @@
+# include "../src/claytor.h"
+
+calc_integer_t bignum_normalize(calc_bignum_t *big)
+{
+	/* This function turns a freshly computed bignum into a value. Leading zero
+	 * limbs are stripped first, and then if the magnitude fits into an int64_t
+	 * the bignum is freed and the value demoted to the small fast path. This is
+	 * what keeps intermediate results that shrink back (such as a big product
+	 * divided by a big divisor) from dragging the heap along. The magnitude of
+	 * -2^63 doesn't fit an int64_t but the value does, so it is special-cased.
+	 */
+	while ((big->len > 0) && (big->limbs[big->len - 1] == 0))
+	{
+		big->len--;
+	}
+	if (big->len <= 2)
+	{
+		uint64_t magnitude = (big->len > 0)? big->limbs[0] : 0;
+		if (big->len == 2) magnitude |= (uint64_t)big->limbs[1] << LIMB_BITS;
+		if ((magnitude <= INT64_MAX) || (big->negative && (magnitude == (uint64_t)INT64_MAX + 1)))
+		{
+			int64_t small = (int64_t)magnitude;
+			if (big->negative) small = (int64_t)(0 - magnitude);
+			free(big);
+			return INTEGER_INT(small);
+		}
+	}
+	calc_integer_t value = {REF_INACTIVE, big};
+	return value;
+} //end calc_integer_t bignum_normalize()
@@ -0,0 +1,59 @@
+# include "../src/claytor.h"
+
+uint8_t bignum_parse(const char *src_array, char **end_ptr, calc_integer_t *value)
+{
+	/* This function is value_parse() for bignum mode. Numbers of up to 18
+	 * digits always fit into an int64_t, so they are converted straight into
+	 * a small value. Longer numbers are accumulated into limbs LIMB_DIGITS
+	 * digits at a time (multiplying what was accumulated so far by the power
+	 * of 10 that the next group of digits represents and adding the group),
+	 * which needs one multiply-add pass over the limbs per nine digits.
+	 */
+	const char *reader = src_array;
+	while (isdigit((unsigned char)*reader)) reader++;
+	*end_ptr = (char *)reader;
+	size_t digits = reader - src_array;
+	if (digits <= 2 * LIMB_DIGITS)
+	{
+		int64_t small = REF_INACTIVE;
+		for (reader = src_array; reader < *end_ptr; reader++)
+		{
+			small = (small * BASE) + (*reader - '0');
+		}
+		*value = INTEGER_INT(small);
+		return CALC_OK;
+	}
+
+	calc_bignum_t *big = bignum_alloc((digits / LIMB_DIGITS) + 1);
+	if (big == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	reader = src_array;
+	size_t group = digits % LIMB_DIGITS;
+	if (group == 0) group = LIMB_DIGITS;
+	while (reader < *end_ptr)
+	{
+		uint32_t chunk = REF_INACTIVE;
+		uint32_t scale = 1;
+		for (size_t index = 0; index < group; index++, reader++)
+		{
+			chunk = (chunk * BASE) + (*reader - '0');
+			scale *= BASE;
+		}
+		uint64_t carry = chunk;
+		for (uint32_t index = 0; index < big->len; index++)
+		{
+			carry += (uint64_t)big->limbs[index] * scale;
+			big->limbs[index] = (uint32_t)carry;
+			carry >>= LIMB_BITS;
+		}
+		if (carry != 0)
+		{
+			big->limbs[big->len++] = (uint32_t)carry;
+		}
+		group = LIMB_DIGITS;
+	} //end while (reader < *end_ptr)
+	*value = bignum_normalize(big);
+	return CALC_OK;
+} //end uint8_t bignum_parse()
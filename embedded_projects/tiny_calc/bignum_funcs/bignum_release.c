@@ -0,0 +1,13 @@
+# include "../src/claytor.h"
+
+void bignum_release(calc_integer_t *integer)
+{
+	/* This function frees the bignum owned by an integer, if it has one, and
+	 * leaves the integer as a small zero. It is value_release() in bignum
+	 * mode, where a value is a single integer. Small values own nothing, so
+	 * for them this is a no-op. free(NULL) is a no-op as well.
+	 */
+	free(integer->big);
+	integer->big = NULL;
+	integer->small = REF_INACTIVE;
+} //end void bignum_release()
@@ -0,0 +1,25 @@
+# include "../src/claytor.h"
+
+void bignum_view(const calc_integer_t *value, uint32_t scratch[2], const uint32_t **limbs, uint32_t *len, uint8_t *negative)
+{
+	/* This function presents any value as a sign and a limb magnitude, so that
+	 * the limb arithmetic never has to care whether an operand was small or
+	 * big. A big value simply lends out its own limbs. A small value has its
+	 * magnitude split into the caller's two-limb scratch array instead, which
+	 * lives on the caller's stack, so mixing a small operand into a bignum op
+	 * costs no allocation.
+	 */
+	if (value->big != NULL)
+	{
+		*limbs = value->big->limbs;
+		*len = value->big->len;
+		*negative = value->big->negative;
+		return;
+	}
+	uint64_t magnitude = (value->small < 0)? 0 - (uint64_t)value->small : (uint64_t)value->small;
+	scratch[0] = (uint32_t)magnitude;
+	scratch[1] = (uint32_t)(magnitude >> LIMB_BITS);
+	*limbs = scratch;
+	*len = (scratch[1] != 0)? 2 : ((scratch[0] != 0)? 1 : 0);
+	*negative = (value->small < 0);
+} //end void bignum_view()
@@ -0,0 +1,20 @@
+# include "../src/claytor.h"
+
+void cache_free(calc_cache_t *cache)
+{
+	/* This function releases a cache: the key, program and result of every
+	 * entry in use, and then the entries and buckets themselves. The cache is
+	 * left disabled (see cache_init()), so freeing it twice is harmless.
+	 */
+	for (uint32_t index = 0; index < cache->capacity; index++)
+	{
+		cache_entry_t *entry = &cache->entries[index];
+		if (entry->key == NULL) continue;
+		free(entry->key);
+		prog_free(&entry->prog);
+		value_release(&entry->result);
+	}
+	free(cache->entries);
+	free(cache->buckets);
+	*cache = (calc_cache_t){NULL, NULL, 0, 0, 0, CACHE_NONE, CACHE_NONE, 0, 0};
+} //end void cache_free()
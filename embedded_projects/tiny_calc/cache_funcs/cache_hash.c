@@ -0,0 +1,16 @@
+# include "../src/claytor.h"
+
+uint64_t cache_hash(const char *key)
+{
+	/* This function hashes a cache key with 64 bit FNV-1a: every byte is
+	 * folded into the hash with an xor and a multiplication by the FNV
+	 * prime, which spreads even keys that differ in a single digit.
+	 */
+	uint64_t hash = 0xCBF29CE484222325u;	//FNV offset basis
+	for (const char *reader = key; *reader != 0; reader++)
+	{
+		hash ^= (uint8_t)*reader;
+		hash *= 0x100000001B3u;	//FNV prime
+	}
+	return hash;
+} //end uint64_t cache_hash()
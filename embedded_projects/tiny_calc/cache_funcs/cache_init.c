@@ -0,0 +1,34 @@
+# include "../src/claytor.h"
+
+uint8_t cache_init(calc_cache_t *cache, uint32_t capacity)
+{
+	/* This function sets up an empty cache of at most capacity entries. The
+	 * entries and the buckets are allocated once, here, with at least as many
+	 * buckets as entries (rounded up to a power of two, so a hash picks its
+	 * bucket with a mask) to keep the chains short. A capacity of 0 gives a
+	 * cache that is always empty: every lookup misses and nothing is ever
+	 * inserted. CALC_ENOMEM is returned if the cache couldn't be allocated,
+	 * in which case it is left disabled.
+	 */
+	*cache = (calc_cache_t){NULL, NULL, 0, 0, 0, CACHE_NONE, CACHE_NONE, 0, 0};
+	if (capacity == 0)
+	{
+		return CALC_OK;
+	}
+	uint32_t n_buckets = 1;
+	while (n_buckets < capacity) n_buckets <<= 1;
+	cache->entries = calloc(capacity, sizeof(cache_entry_t));
+	cache->buckets = malloc((size_t)n_buckets * sizeof(uint32_t));
+	if ((cache->entries == NULL) || (cache->buckets == NULL))
+	{
+		free(cache->entries);
+		free(cache->buckets);
+		cache->entries = NULL;
+		cache->buckets = NULL;
+		return CALC_ENOMEM;
+	}
+	for (uint32_t bucket = 0; bucket < n_buckets; bucket++) cache->buckets[bucket] = CACHE_NONE;
+	cache->n_buckets = n_buckets;
+	cache->capacity = capacity;
+	return CALC_OK;
+} //end uint8_t cache_init()
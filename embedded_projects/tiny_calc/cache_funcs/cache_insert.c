@@ -0,0 +1,66 @@
+# include "../src/claytor.h"
+
+static void evict(calc_cache_t *cache, uint32_t index)
+{
+	/* Removes an entry from its hash chain and releases what it owns, so
+	 * that it can be reused. It stays in the recency list, where the caller
+	 * moves it to the head.
+	 */
+	cache_entry_t *entry = &cache->entries[index];
+	uint32_t *link = &cache->buckets[entry->hash & (cache->n_buckets - 1)];
+	while (*link != index) link = &cache->entries[*link].chain;
+	*link = entry->chain;
+	free(entry->key);
+	entry->key = NULL;
+	prog_free(&entry->prog);
+	value_release(&entry->result);
+}
+
+const cache_entry_t *cache_insert(calc_cache_t *cache, const char *key, calc_prog_t *prog, uint8_t status, calc_value_t *result)
+{
+	/* This function remembers a normalized expression that missed the cache,
+	 * along with the program it compiled into and the status and result of
+	 * evaluating it. The program and the result are moved into the cache and
+	 * the caller's copies are left empty, so the caller can release them
+	 * either way. If the cache is full, its least recently used entry is
+	 * evicted to make room. The new entry is returned, or NULL if the cache
+	 * is disabled or the key couldn't be copied, in which case nothing is
+	 * moved.
+	 */
+	if (cache->capacity == 0)
+	{
+		return NULL;
+	}
+	char *key_copy = malloc(strlen(key) + 1);
+	if (key_copy == NULL)
+	{
+		return NULL;
+	}
+	strcpy(key_copy, key);
+	uint32_t index = cache->len;
+	if (cache->len < cache->capacity)
+	{
+		cache->entries[index].prev = CACHE_NONE;
+		cache->entries[index].next = CACHE_NONE;
+		cache->len++;
+	}
+	else
+	{
+		index = cache->tail;
+		evict(cache, index);
+	}
+	cache_entry_t *entry = &cache->entries[index];
+	uint64_t hash = cache_hash(key);
+	uint32_t *bucket = &cache->buckets[hash & (cache->n_buckets - 1)];
+	entry->key = key_copy;
+	entry->hash = hash;
+	entry->chain = *bucket;
+	*bucket = index;
+	entry->prog = *prog;
+	entry->status = status;
+	entry->result = *result;
+	*prog = (calc_prog_t){NULL, 0, 0};
+	*result = VALUE_INT(REF_INACTIVE);
+	cache_touch(cache, index);
+	return entry;
+} //end const cache_entry_t *cache_insert()
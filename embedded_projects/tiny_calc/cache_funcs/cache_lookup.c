@@ -0,0 +1,33 @@
+# include "../src/claytor.h"
+
+const cache_entry_t *cache_lookup(calc_cache_t *cache, const char *key)
+{
+	/* This function looks a normalized expression up in the cache. Its hash
+	 * picks a bucket, and the chain of that bucket is walked comparing
+	 * hashes first, so the keys themselves are only compared once the hashes
+	 * match. On a hit the entry becomes the most recently used one and is
+	 * returned, so the caller can use its result (and program) without
+	 * parsing anything; on a miss NULL is returned. Either way the lookup is
+	 * counted towards the hit rate.
+	 */
+	if (cache->capacity == 0)
+	{
+		cache->misses++;
+		return NULL;
+	}
+	uint64_t hash = cache_hash(key);
+	uint32_t index = cache->buckets[hash & (cache->n_buckets - 1)];
+	while (index != CACHE_NONE)
+	{
+		cache_entry_t *entry = &cache->entries[index];
+		if ((entry->hash == hash) && (strcmp(entry->key, key) == 0))
+		{
+			cache->hits++;
+			cache_touch(cache, index);
+			return entry;
+		}
+		index = entry->chain;
+	}
+	cache->misses++;
+	return NULL;
+} //end const cache_entry_t *cache_lookup()
@@ -0,0 +1,42 @@
+# include "../src/claytor.h"
+
+static uint8_t is_word(char c)
+{
+	return isalnum((unsigned char)c) || (c == '.');	//part of a number or a name
+}
+
+static uint8_t is_symbol(char c)
+{
+	return ispunct((unsigned char)c) && (c != '(') && (c != ')') && (c != ',');	//part of an operator
+}
+
+void cache_normalize(const char *src_array, char *dest_array)
+{
+	/* This function writes the normalized text of an expression into
+	 * dest_array, which needs room for at least as many characters as
+	 * src_array. Expressions that only differ in their spacing normalize to
+	 * the same text, so "1 + 2" and "1+2" share a single cache entry. Spaces
+	 * are dropped, except for a single one between two characters that
+	 * would otherwise run into each other and become one token ("1 2" is an
+	 * error, "12" is not, and neither is "1 < < 2" the same as "1 << 2"),
+	 * which keeps the normalized text meaning exactly
+	 * what the expression meant.
+	 */
+	char *writer = dest_array;
+	uint8_t pending_space = REF_INACTIVE;
+	for (const char *reader = src_array; *reader != 0; reader++)
+	{
+		if (isspace((unsigned char)*reader))
+		{
+			pending_space = (writer != dest_array);
+			continue;
+		}
+		if (pending_space && ((is_word(writer[-1]) && is_word(*reader)) || (is_symbol(writer[-1]) && is_symbol(*reader))))
+		{
+			*writer++ = ' ';
+		}
+		pending_space = REF_INACTIVE;
+		*writer++ = *reader;
+	}
+	*writer = 0;
+} //end void cache_normalize()
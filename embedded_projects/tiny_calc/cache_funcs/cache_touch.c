@@ -0,0 +1,24 @@
+# include "../src/claytor.h"
+
+void cache_touch(calc_cache_t *cache, uint32_t index)
+{
+	/* This function makes an entry the most recently used one: it is
+	 * unlinked from wherever it is in the recency list (a new entry isn't
+	 * linked anywhere yet) and linked back in at the head. Everything is
+	 * linked through indices, so this is a handful of stores.
+	 */
+	cache_entry_t *entries = cache->entries;
+	cache_entry_t *entry = &entries[index];
+	if (cache->head == index)
+	{
+		return;
+	}
+	if (entry->prev != CACHE_NONE) entries[entry->prev].next = entry->next;
+	if (entry->next != CACHE_NONE) entries[entry->next].prev = entry->prev;
+	else if (cache->tail == index) cache->tail = entry->prev;
+	entry->prev = CACHE_NONE;
+	entry->next = cache->head;
+	if (cache->head != CACHE_NONE) entries[cache->head].prev = index;
+	cache->head = index;
+	if (cache->tail == CACHE_NONE) cache->tail = index;
+} //end void cache_touch()
@@ -0,0 +1,91 @@
+# include "../src/claytor.h"
+
+uint8_t col_eval(const calc_prog_t *prog, const calc_jit_t *jit, col_table_t *table, calc_value_t *results)
+{
+	/* This function evaluates one compiled program for every row of a column
+	 * table, writing the result of every row into results and its first error
+	 * (if any) into table->status. Rather than running the whole program once
+	 * per row, the rows are taken COL_BLOCK at a time and the program is run
+	 * once per block, with every operand on the stack being a whole block of
+	 * values instead of a single one. Every instruction then becomes a single
+	 * tight loop over the block (see col_op()), so the instruction dispatch is
+	 * paid once per block rather than once per row, and the loops themselves
+	 * can be vectorised. Pushing a variable costs nothing at all: its operand
+	 * simply points into the table's column, since the columns are stored
+	 * contiguously. Constants are broadcast into a block of their own, and the
+	 * result of an operator overwrites the block of its left (or only)
+	 * operand's stack slot, so the whole evaluation needs prog->depth blocks
+	 * of workspace. In bignum and rational mode values own memory and every
+	 * op may allocate, so nothing is gained from blocks; the rows are
+	 * evaluated one at a time through prog_eval() instead, with the variables
+	 * borrowed from the columns.
+	 * If the program was also translated into native code (jit is non-NULL
+	 * and jit_compile() succeeded), that code evaluates the rows one at a
+	 * time instead, straight off the columns. CALC_ENOMEM is returned if the
+	 * workspace couldn't be allocated.
+	 */
+	if ((jit != NULL) && (jit->fn != NULL))
+	{
+		for (size_t row = 0; row < table->n_rows; row++)
+		{
+			if (table->status[row] == CALC_OK) table->status[row] = jit->fn(table->columns, row, &results[row]);
+		}
+		return CALC_OK;
+	}
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+	calc_value_t vars[CALC_VARS];
+	for (size_t row = 0; row < table->n_rows; row++)
+	{
+		results[row] = VALUE_INT(REF_INACTIVE);
+		if (table->status[row] != CALC_OK) continue;
+		for (uint8_t var = 0; var < CALC_VARS; var++)
+		{
+			vars[var] = (table->columns[var] != NULL)? table->columns[var][row] : VALUE_INT(REF_INACTIVE);
+		}
+		table->status[row] = prog_eval(prog, vars, &results[row]);
+	}
+	return CALC_OK;
+# else
+	calc_value_t *slots = malloc(((size_t)prog->depth + 1) * COL_BLOCK * sizeof(calc_value_t));
+	const calc_value_t **operands = malloc(((size_t)prog->depth + 1) * sizeof(calc_value_t *));
+	if ((slots == NULL) || (operands == NULL))
+	{
+		free(slots);
+		free(operands);
+		return CALC_ENOMEM;
+	}
+	for (size_t first = 0; first < table->n_rows; first += COL_BLOCK)
+	{
+		size_t count = table->n_rows - first;
+		if (count > COL_BLOCK) count = COL_BLOCK;
+		uint8_t *status = table->status + first;
+		uint32_t top = REF_INACTIVE;
+		for (uint32_t index = 0; index < prog->len; index++)
+		{
+			const calc_instr_t *instr = &prog->code[index];
+			calc_value_t *slot = slots + ((size_t)top * COL_BLOCK);
+			if (instr->opcode == INSTR_PUSH)
+			{
+				for (size_t row = 0; row < count; row++) slot[row] = instr->value;
+				operands[top++] = slot;
+			}
+			else if (instr->opcode == INSTR_VAR)
+			{
+				operands[top++] = table->columns[VALUE_AS_INT(instr->value)] + first;
+			}
+			else
+			{
+				uint8_t arity = OP_ARITY(instr->opcode);
+				slot -= arity * COL_BLOCK;	//the slot of the left operand
+				col_op(instr->opcode, operands[top - arity], (arity == 2)? operands[top - 1] : NULL, slot, status, count);
+				top -= arity - 1;
+				operands[top - 1] = slot;
+			}
+		} //end for-loop over instructions
+		memcpy(results + first, operands[0], count * sizeof(calc_value_t));
+	} //end for-loop over blocks
+	free(slots);
+	free(operands);
+	return CALC_OK;
+# endif
+} //end uint8_t col_eval()
@@ -0,0 +1,23 @@
+# include "../src/claytor.h"
+
+void col_free(col_table_t *table)
+{
+	/* This function releases a column table: every value of every column (in
+	 * bignum and rational mode values may own memory of their own), the
+	 * columns themselves and the row statuses. The table is left empty, so
+	 * freeing it twice is harmless.
+	 */
+	for (uint8_t var = 0; var < CALC_VARS; var++)
+	{
+		if (table->columns[var] == NULL) continue;
+		if (VALUE_OWNS_MEMORY)
+		{
+			for (size_t row = 0; row < table->n_rows; row++) value_release(&table->columns[var][row]);
+		}
+		free(table->columns[var]);
+		table->columns[var] = NULL;
+	}
+	free(table->status);
+	table->status = NULL;
+	table->n_rows = REF_INACTIVE;
+} //end void col_free()
@@ -0,0 +1,171 @@
+# include "../src/claytor.h"
+
+void col_op(uint8_t opcode, const calc_value_t *lhs, const calc_value_t *rhs, calc_value_t *out, uint8_t *status, size_t count)
+{
+	/* This function applies one operator to count rows of column mode at
+	 * once: out[i] = lhs[i] op rhs[i], or op lhs[i] for unary ops (whose rhs
+	 * is NULL). Every row keeps the first error it ran into in status[i], so
+	 * a row that already failed carries on computing whatever it computes but
+	 * is never reported as anything else. The loops are written for the
+	 * compiler's auto-vectoriser: they have no early exits and no calls, and
+	 * errors are folded in with selects rather than branches. In INT64 mode
+	 * addition and subtraction detect overflow from the sign bits of the
+	 * wrapped result (the same test the checked builtins make, only one that
+	 * vectorises), while division swaps the divisors that would trap for 1
+	 * before dividing. Double mode checks that every result is finite.
+	 * Negation, abs(), min() and max() are plain selects in both modes.
+	 * 64 bit multiplication and integer division have no vector instructions
+	 * on x86-64 up to AVX2 and stay scalar, as does everything in INT128 mode
+	 * and every other operator ('^', '%', the bitwise ones, the comparisons
+	 * and so on), which simply go through op_apply(). out may be the same block
+	 * as lhs or rhs, so every result is only stored once both operands have
+	 * been read.
+	 */
+	switch (opcode)
+	{
+# if defined(CALC_MODE_INT64)
+		case OP_ADD:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				uint64_t sum = (uint64_t)lhs[row] + (uint64_t)rhs[row];
+				uint8_t overflow = ((((uint64_t)lhs[row] ^ sum) & ((uint64_t)rhs[row] ^ sum)) >> 63);
+				out[row] = (int64_t)sum;
+				status[row] = (status[row])? status[row] : (overflow * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_SUB:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				uint64_t diff = (uint64_t)lhs[row] - (uint64_t)rhs[row];
+				uint8_t overflow = ((((uint64_t)lhs[row] ^ (uint64_t)rhs[row]) & ((uint64_t)lhs[row] ^ diff)) >> 63);
+				out[row] = (int64_t)diff;
+				status[row] = (status[row])? status[row] : (overflow * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_MUL:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				int64_t prod = REF_INACTIVE;	//never straight into out, which may alias an operand
+				uint8_t overflow = __builtin_mul_overflow(lhs[row], rhs[row], &prod);
+				out[row] = prod;
+				status[row] = (status[row])? status[row] : (overflow * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_DIV:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				uint8_t by_zero = (rhs[row] == 0);
+				uint8_t overflow = ((rhs[row] == -1) & (lhs[row] == INT64_MIN));
+				int64_t divisor = (by_zero | overflow)? 1 : rhs[row];
+				out[row] = lhs[row] / divisor;
+				uint8_t failed = (by_zero)? CALC_EDIVZERO : (overflow * CALC_EOVERFLOW);
+				status[row] = (status[row])? status[row] : failed;
+			}
+			break;
+		}
+		case OP_NEG:
+		case OP_ABS:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				int64_t negated = (int64_t)(0 - (uint64_t)lhs[row]);
+				uint8_t overflow = (lhs[row] == INT64_MIN);
+				out[row] = ((opcode == OP_NEG) || (lhs[row] < 0))? negated : lhs[row];
+				status[row] = (status[row])? status[row] : (overflow * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_MIN:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = (lhs[row] <= rhs[row])? lhs[row] : rhs[row];
+			break;
+		}
+		case OP_MAX:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = (lhs[row] >= rhs[row])? lhs[row] : rhs[row];
+			break;
+		}
+# elif defined(CALC_MODE_DOUBLE)
+		case OP_ADD:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				out[row] = lhs[row] + rhs[row];
+				status[row] = (status[row])? status[row] : (!isfinite(out[row]) * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_SUB:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				out[row] = lhs[row] - rhs[row];
+				status[row] = (status[row])? status[row] : (!isfinite(out[row]) * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_MUL:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				out[row] = lhs[row] * rhs[row];
+				status[row] = (status[row])? status[row] : (!isfinite(out[row]) * CALC_EOVERFLOW);
+			}
+			break;
+		}
+		case OP_DIV:
+		{
+			for (size_t row = 0; row < count; row++)
+			{
+				uint8_t by_zero = (rhs[row] == 0);
+				out[row] = lhs[row] / rhs[row];
+				uint8_t failed = (by_zero)? CALC_EDIVZERO : (!isfinite(out[row]) * CALC_EOVERFLOW);
+				status[row] = (status[row])? status[row] : failed;
+			}
+			break;
+		}
+		case OP_NEG:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = -lhs[row];
+			break;
+		}
+		case OP_ABS:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = fabs(lhs[row]);
+			break;
+		}
+		case OP_MIN:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = (lhs[row] <= rhs[row])? lhs[row] : rhs[row];
+			break;
+		}
+		case OP_MAX:
+		{
+			for (size_t row = 0; row < count; row++) out[row] = (lhs[row] >= rhs[row])? lhs[row] : rhs[row];
+			break;
+		}
+# endif
+		default:
+		{
+			/* Everything without a loop of its own (all of INT128 mode, and
+			 * every operator not listed above everywhere) goes through
+			 * op_apply() one row at a time.
+			 */
+			for (size_t row = 0; row < count; row++)
+			{
+				calc_value_t value = VALUE_INT(REF_INACTIVE);
+				uint8_t failed = op_apply(opcode, lhs[row], (rhs != NULL)? rhs[row] : VALUE_INT(REF_INACTIVE), &value);
+				out[row] = value;
+				status[row] = (status[row])? status[row] : failed;
+			}
+			break;
+		}
+	} //end switch (opcode)
+} //end void col_op()
@@ -0,0 +1,94 @@
+# include "../src/claytor.h"
+
+uint8_t col_readbin(FILE *src_file, uint8_t n_cols, col_table_t *table)
+{
+	/* This function reads the input of column mode from a binary file: rows
+	 * of n_cols values of the compiled-in numeric type, in native byte order,
+	 * one after the other and without any header. Since a binary file can't
+	 * name its columns, they are bound to the variables in order: the first
+	 * value of every row is 'a', the second 'b' and so on. The rows are read
+	 * in a block at a time and transposed into one array per column, which is
+	 * the layout col_eval() expects. Bignums have no fixed width, so in bignum
+	 * and rational mode only CSV input is supported. CALC_ESYNTAX is returned
+	 * if the file couldn't be read or doesn't hold a whole number of rows,
+	 * or if n_cols is 0 (an expression without variables gives the rows no
+	 * width to be counted by), and CALC_ENOMEM if the columns couldn't be
+	 * allocated.
+	 */
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+	(void)src_file;
+	(void)n_cols;
+	(void)table;
+	fprintf(stderr, "col_readbin(): binary input isn't supported in bignum or rational mode.\n");
+	return CALC_ESYNTAX;
+# else
+	if (n_cols == 0)
+	{
+		fprintf(stderr, "col_readbin(): binary input needs an expression that uses a variable.\n");
+		return CALC_ESYNTAX;
+	}
+	size_t cap = COL_BLOCK;
+	calc_value_t *block = malloc((size_t)n_cols * COL_BLOCK * sizeof(calc_value_t));
+	uint8_t status = (block == NULL)? CALC_ENOMEM : CALC_OK;
+	for (uint8_t col = 0; (status == CALC_OK) && (col < n_cols); col++)
+	{
+		table->columns[col] = malloc(cap * sizeof(calc_value_t));
+		if (table->columns[col] == NULL) status = CALC_ENOMEM;
+	}
+	table->n_rows = REF_INACTIVE;
+	size_t row_size = (size_t)n_cols * sizeof(calc_value_t);
+	size_t partial = REF_INACTIVE;	//bytes read past the last whole row
+	while ((status == CALC_OK) && !feof(src_file))
+	{
+		size_t bytes = fread(block, 1, COL_BLOCK * row_size, src_file);
+		if (ferror(src_file))
+		{
+			fprintf(stderr, "col_readbin(): Error reading input.\n");
+			status = CALC_ESYNTAX;
+			break;
+		}
+		size_t rows = bytes / row_size;
+		partial = bytes % row_size;
+		if (table->n_rows + rows > cap)
+		{
+			cap *= 2;
+			for (uint8_t col = 0; col < n_cols; col++)
+			{
+				calc_value_t *grown = realloc(table->columns[col], cap * sizeof(calc_value_t));
+				if (grown == NULL)
+				{
+					status = CALC_ENOMEM;
+					break;
+				}
+				table->columns[col] = grown;
+			}
+			if (status != CALC_OK) break;
+		}
+		for (size_t row = 0; row < rows; row++)
+		{
+			for (uint8_t col = 0; col < n_cols; col++)
+			{
+				table->columns[col][table->n_rows + row] = block[(row * n_cols) + col];
+			}
+		}
+		table->n_rows += rows;
+		if (partial != 0) break;	//only the very end of the file may hold less than a block
+	} //end while (!feof(src_file))
+	if ((status == CALC_OK) && ((partial != 0) || (fgetc(src_file) != EOF)))
+	{
+		fprintf(stderr, "col_readbin(): the input isn't a whole number of %u column rows.\n", n_cols);
+		status = CALC_ESYNTAX;
+	}
+	free(block);
+	if (status == CALC_OK)
+	{
+		table->status = calloc(table->n_rows + 1, 1);
+		if (table->status == NULL) status = CALC_ENOMEM;
+	}
+	if (status != CALC_OK)
+	{
+		col_free(table);
+	}
+	return status;
+# endif
+} //end uint8_t col_readbin()
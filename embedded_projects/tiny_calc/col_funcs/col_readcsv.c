@@ -0,0 +1,135 @@
+# include "../src/claytor.h"
+
+static uint8_t field_parse(const char *field, const char *field_end, calc_value_t *value)
+{
+	/* Converts one CSV field into a value. Spaces around the number and a
+	 * leading minus sign are allowed. value_parse() only ever sees unsigned
+	 * numbers (as it does from the expression parser), so a negative number
+	 * is parsed as its magnitude and then subtracted from 0; like in an
+	 * expression, the most negative INT64 can't be written out. Anything else
+	 * left in the field is a syntax error.
+	 */
+	while ((field < field_end) && isspace((unsigned char)*field)) field++;
+	while ((field_end > field) && isspace((unsigned char)field_end[-1])) field_end--;
+	uint8_t negative = ((field < field_end) && (*field == '-'));
+	if (negative) field++;
+	if ((field == field_end) || !isdigit((unsigned char)*field))
+	{
+		return CALC_ESYNTAX;
+	}
+	char *number_end = NULL;
+	calc_value_t magnitude = VALUE_INT(REF_INACTIVE);
+	uint8_t status = value_parse(field, &number_end, &magnitude);
+	if ((status == CALC_OK) && (number_end != field_end))
+	{
+		status = CALC_ESYNTAX;
+	}
+	if (status != CALC_OK)
+	{
+		value_release(&magnitude);
+		return status;
+	}
+	if (!negative)
+	{
+		*value = magnitude;
+		return CALC_OK;
+	}
+	status = op_sub(VALUE_INT(REF_INACTIVE), magnitude, value);
+	value_release(&magnitude);
+	return status;
+}
+
+uint8_t col_readcsv(FILE *src_file, col_table_t *table)
+{
+	/* This function reads the input of column mode from a CSV file. The first
+	 * line is a header naming every column, and since columns are bound to
+	 * the variables of the expression, every name has to be a single letter
+	 * from 'a' to 'z' (each used once.) Every line after that is one row. The
+	 * lines are read in with batch_readlines(), then every field is parsed
+	 * straight into the column it belongs to, so the table ends up stored
+	 * column by column as col_eval() expects. A row that doesn't have exactly
+	 * one number per column is still kept (so that the output stays aligned
+	 * with the input), but its status records why it can't be evaluated. The
+	 * whole file is rejected with CALC_ESYNTAX only if its header is unusable,
+	 * and with CALC_ENOMEM if the columns couldn't be allocated.
+	 */
+	char *buffer = NULL;
+	size_t n_lines = REF_INACTIVE;
+	char **lines = batch_readlines(src_file, &buffer, &n_lines);
+	if (lines == NULL)
+	{
+		return CALC_ESYNTAX;
+	}
+	if (n_lines == 0)
+	{
+		fprintf(stderr, "col_readcsv(): the input has no header.\n");
+		free(lines);
+		free(buffer);
+		return CALC_ESYNTAX;
+	}
+
+	/* The header: a comma separated list of single letter column names. The
+	 * order of the names is the order of the fields in every row.
+	 */
+	int8_t order[CALC_VARS] = {REF_INACTIVE};
+	uint8_t n_cols = REF_INACTIVE;
+	uint8_t status = CALC_OK;
+	for (char *name = lines[0]; (status == CALC_OK) && (name != NULL); )
+	{
+		char *name_end = strchr(name, ',');
+		char *next = (name_end != NULL)? name_end + 1 : NULL;
+		if (name_end == NULL) name_end = name + strlen(name);
+		while ((name < name_end) && isspace((unsigned char)*name)) name++;
+		while ((name_end > name) && isspace((unsigned char)name_end[-1])) name_end--;
+		if ((name_end - name != 1) || !islower((unsigned char)*name) ||
+			(table->columns[*name - 'a'] != NULL))
+		{
+			fprintf(stderr, "col_readcsv(): column names have to be distinct letters from 'a' to 'z'.\n");
+			status = CALC_ESYNTAX;
+			break;
+		}
+		order[n_cols++] = *name - 'a';
+		table->columns[*name - 'a'] = malloc(n_lines * sizeof(calc_value_t));
+		if (table->columns[*name - 'a'] == NULL) status = CALC_ENOMEM;
+		name = next;
+	}
+	table->n_rows = n_lines - 1;
+	table->status = malloc(n_lines);
+	if (table->status == NULL) status = CALC_ENOMEM;
+	if (status != CALC_OK)
+	{
+		table->n_rows = REF_INACTIVE;
+		col_free(table);
+		free(lines);
+		free(buffer);
+		return status;
+	}
+
+	for (size_t row = 0; row < table->n_rows; row++)
+	{
+		char *field = lines[row + 1];
+		uint8_t row_status = CALC_OK;
+		for (uint8_t col = 0; col < n_cols; col++)
+		{
+			calc_value_t *value = &table->columns[order[col]][row];
+			*value = VALUE_INT(REF_INACTIVE);
+			if (field == NULL)
+			{
+				if (row_status == CALC_OK) row_status = CALC_ESYNTAX;	//too few fields
+				continue;
+			}
+			char *field_end = strchr(field, ',');
+			if (field_end == NULL) field_end = field + strlen(field);
+			if (row_status == CALC_OK) row_status = field_parse(field, field_end, value);
+			field = (*field_end == ',')? field_end + 1 : NULL;
+		}
+		if ((row_status == CALC_OK) && (field != NULL))
+		{
+			row_status = CALC_ESYNTAX;	//too many fields
+		}
+		table->status[row] = row_status;
+	} //end for-loop over rows
+	free(lines);
+	free(buffer);
+	return CALC_OK;
+} //end uint8_t col_readcsv()
@@ -0,0 +1,149 @@
+# include "../src/claytor.h"
+
+static uint8_t is_binary(const char *path)
+{
+	/* Whether a file of column mode is binary: only files ending in ".bin"
+	 * are, everything else (stdout included) is CSV.
+	 */
+	size_t len = (path != NULL)? strlen(path) : 0;
+	return (len > 4) && (strcmp(path + len - 4, ".bin") == 0);
+}
+
+static double elapsed(const struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)(now.tv_sec - start->tv_sec) + ((double)(now.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+int col_run(const claytor_opts_t *opts)
+{
+	/* This function drives column mode, which evaluates one expression over
+	 * every row of a table of inputs. The expression is parsed, folded and
+	 * compiled once, and its variables are bound to the columns of the
+	 * input: by the header of a CSV file, or by position in a binary file
+	 * (see col_readcsv() and col_readbin()). col_eval() then evaluates it a
+	 * block of rows at a time (or, with "-J", a row at a time through native
+	 * code from jit_compile()), and col_write() writes one result per row to
+	 * the output file, or to stdout. Once done, the number of rows and how
+	 * long their evaluation took (both on its own and including reading and
+	 * writing the files) are reported on stderr, so throughput can be
+	 * compared across numeric modes and compiler flags.
+	 */
+	if (opts->column_expr == NULL)
+	{
+		fprintf(stderr, "col_run(): column mode requires an expression (\"-e\").\n");
+		return EXIT_FAILURE;
+	}
+	if (VALUE_OWNS_MEMORY && is_binary(opts->output_path))
+	{
+		fprintf(stderr, "col_run(): binary output isn't supported in bignum or rational mode.\n");
+		return EXIT_FAILURE;
+	}
+	struct timespec start_total;
+	clock_gettime(CLOCK_MONOTONIC, &start_total);
+
+	calc_ast_t ast = {NULL, 0, 0, 0};
+	calc_prog_t prog = {NULL, 0, 0};
+	uint8_t status = ast_parse(opts->column_expr, &ast);
+	if (status != CALC_OK)
+	{
+		fprintf(stderr, "col_run(): Error parsing \"%s\" at character %zu: %s.\n",
+			opts->column_expr, ast.error_offset + 1, calc_strerror(status));
+		return EXIT_FAILURE;
+	}
+	ast_fold(&ast);
+	status = prog_compile(&ast, &prog);
+	ast_free(&ast);
+	if (status != CALC_OK)
+	{
+		fprintf(stderr, "col_run(): Error compiling \"%s\": %s.\n", opts->column_expr, calc_strerror(status));
+		return EXIT_FAILURE;
+	}
+	uint8_t n_used = REF_INACTIVE;	//one past the highest variable the expression uses
+	for (uint32_t index = 0; index < prog.len; index++)
+	{
+		if (prog.code[index].opcode != INSTR_VAR) continue;
+		uint8_t var = (uint8_t)VALUE_AS_INT(prog.code[index].value) + 1;
+		if (var > n_used) n_used = var;
+	}
+
+	FILE *src_file = stdin;
+	if (strcmp(opts->column_path, "-") != 0)
+	{
+		src_file = fopen(opts->column_path, (is_binary(opts->column_path))? "rb" : "r");
+		if (src_file == NULL)
+		{
+			fprintf(stderr, "col_run(): Error accessing column source \"%s\".\n", opts->column_path);
+			prog_free(&prog);
+			return EXIT_FAILURE;
+		}
+	}
+	col_table_t table = {{NULL}, NULL, 0};
+	status = (is_binary(opts->column_path))? col_readbin(src_file, n_used, &table) : col_readcsv(src_file, &table);
+	if (src_file != stdin) fclose(src_file);
+	if (status != CALC_OK)
+	{
+		fprintf(stderr, "col_run(): Error reading column source \"%s\".\n", opts->column_path);
+		prog_free(&prog);
+		return EXIT_FAILURE;
+	}
+	for (uint32_t index = 0; (status == CALC_OK) && (index < prog.len); index++)
+	{
+		if ((prog.code[index].opcode == INSTR_VAR) && (table.columns[VALUE_AS_INT(prog.code[index].value)] == NULL))
+		{
+			status = CALC_EUNBOUND;	//the input has no column for this variable
+		}
+	}
+	calc_value_t *results = (status == CALC_OK)? malloc((table.n_rows + 1) * sizeof(calc_value_t)) : NULL;
+	if ((status == CALC_OK) && (results == NULL)) status = CALC_ENOMEM;
+
+	calc_jit_t jit = {NULL, NULL, 0};
+	if ((status == CALC_OK) && opts->u_jit && (jit_compile(&prog, &jit) != CALC_OK))
+	{
+		fprintf(stderr, "col_run(): \"%s\" can't be translated into native code, interpreting it instead.\n", opts->column_expr);
+	}
+
+	struct timespec start_eval;
+	clock_gettime(CLOCK_MONOTONIC, &start_eval);
+	if (status == CALC_OK) status = col_eval(&prog, &jit, &table, results);
+	double eval_seconds = elapsed(&start_eval);
+	jit_free(&jit);
+	prog_free(&prog);
+	if (status != CALC_OK)
+	{
+		fprintf(stderr, "col_run(): Error evaluating \"%s\": %s.\n", opts->column_expr, calc_strerror(status));
+		free(results);
+		col_free(&table);
+		return EXIT_FAILURE;
+	}
+
+	FILE *dest_file = stdout;
+	if ((opts->output_path != NULL) && (strcmp(opts->output_path, "-") != 0))
+	{
+		dest_file = fopen(opts->output_path, (is_binary(opts->output_path))? "wb" : "w");
+		if (dest_file == NULL)
+		{
+			fprintf(stderr, "col_run(): Error accessing column output \"%s\".\n", opts->output_path);
+			dest_file = stdout;
+			status = CALC_ESYNTAX;
+		}
+	}
+	if (status == CALC_OK) col_write(dest_file, is_binary(opts->output_path), &table, results);
+	if (dest_file != stdout) fclose(dest_file);
+	else fflush(stdout);
+
+	size_t failed = REF_INACTIVE;
+	for (size_t row = 0; row < table.n_rows; row++)
+	{
+		if (table.status[row] != CALC_OK) failed++;
+		value_release(&results[row]);
+	}
+	double total_seconds = elapsed(&start_total);
+	fprintf(stderr, "column mode: %zu rows (%zu failed) evaluated in %.6f s, %.0f rows/s (%.0f rows/s including I/O.)\n",
+		table.n_rows, failed, eval_seconds, (eval_seconds > 0)? table.n_rows / eval_seconds : 0,
+		(total_seconds > 0)? table.n_rows / total_seconds : 0);
+	free(results);
+	col_free(&table);
+	return (status == CALC_OK)? EXIT_SUCCESS : EXIT_FAILURE;
+} //end int col_run()
@@ -0,0 +1,40 @@
+# include "../src/claytor.h"
+
+void col_write(FILE *dest_file, uint8_t binary, const col_table_t *table, const calc_value_t *results)
+{
+	/* This function writes the results of column mode out, one per input row
+	 * and in input order. As text, every result is written on a line of its
+	 * own, and rows that failed are written as "error: " and the reason, like
+	 * batch mode does. In binary, the results are written as an array of the
+	 * compiled-in numeric type in native byte order, which a binary input can
+	 * be lined up with row for row; rows that failed are written as 0, so
+	 * their count (which col_run() reports) is the only trace of them.
+	 */
+	if (binary)
+	{
+		calc_value_t block[COL_BLOCK];
+		for (size_t first = 0; first < table->n_rows; first += COL_BLOCK)
+		{
+			size_t count = table->n_rows - first;
+			if (count > COL_BLOCK) count = COL_BLOCK;
+			for (size_t row = 0; row < count; row++)
+			{
+				block[row] = (table->status[first + row] == CALC_OK)? results[first + row] : VALUE_INT(REF_INACTIVE);
+			}
+			fwrite(block, sizeof(calc_value_t), count, dest_file);
+		}
+		return;
+	}
+	char scratch[RESULT_SIZE] = {REF_INACTIVE};
+	for (size_t row = 0; row < table->n_rows; row++)
+	{
+		if (table->status[row] != CALC_OK)
+		{
+			fprintf(dest_file, "error: %s\n", calc_strerror(table->status[row]));
+			continue;
+		}
+		char *formatted = value_string(results[row], scratch, RESULT_SIZE);
+		fprintf(dest_file, "%s\n", (formatted != NULL)? formatted : "error");
+		if (formatted != scratch) free(formatted);
+	}
+} //end void col_write()
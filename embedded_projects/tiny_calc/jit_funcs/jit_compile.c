@@ -0,0 +1,313 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_INT64) && defined(__x86_64__)
+/* x86-64 register numbers as they are encoded into instructions. Registers
+ * 8 to 15 need the matching REX prefix bit set.
+ */
+# define REG_RAX	0
+# define REG_RCX	1
+# define REG_RDX	2
+# define REG_RBX	3
+# define REG_R8		8
+# define REG_R11	11
+
+/* The registers that hold the operand stack, bottom first: the caller-saved
+ * ones that aren't used for anything else first, then the callee-saved ones,
+ * which the prologue has to save. rax and rdx belong to idiv, rdi and rsi hold
+ * the columns and the row, and r11 holds the result pointer.
+ */
+static const uint8_t stack_regs[JIT_REGS] = {REG_RCX, REG_R8, 9, 10, REG_RBX, 12, 13, 14, 15};
+# define JIT_SAVED_FROM	4	//stack_regs from this index on are callee-saved
+
+typedef struct jit_buf
+{
+	uint8_t *code;
+	size_t len;
+} jit_buf_t;
+
+static void emit(jit_buf_t *buf, uint8_t byte)
+{
+	buf->code[buf->len++] = byte;
+}
+
+static void emit32(jit_buf_t *buf, uint32_t word)
+{
+	memcpy(buf->code + buf->len, &word, sizeof(word));
+	buf->len += sizeof(word);
+}
+
+static void emit_rr(jit_buf_t *buf, uint8_t opcode, uint8_t dst, uint8_t src)
+{
+	/* A 64 bit register to register instruction of the "op r/m64, r64" form
+	 * (add, sub, mov, test, cmp), which computes dst = dst op src.
+	 */
+	emit(buf, 0x48 | ((src >= 8)? 0x04 : 0) | ((dst >= 8)? 0x01 : 0));
+	emit(buf, opcode);
+	emit(buf, 0xC0 | ((src & 7) << 3) | (dst & 7));
+}
+
+static void emit_unary(jit_buf_t *buf, uint8_t opcode, uint8_t ext, uint8_t reg)
+{
+	/* A 64 bit instruction that takes a single register and an opcode
+	 * extension in the reg field of its ModRM byte (neg, idiv, cmp with an
+	 * immediate byte.)
+	 */
+	emit(buf, 0x48 | ((reg >= 8)? 0x01 : 0));
+	emit(buf, opcode);
+	emit(buf, 0xC0 | (ext << 3) | (reg & 7));
+}
+
+static void emit_0f(jit_buf_t *buf, uint8_t opcode, uint8_t dst, uint8_t src)
+{
+	/* A 64 bit two-byte instruction of the "op r64, r/m64" form (imul,
+	 * cmovcc), which has its operands the other way around: dst is the reg
+	 * field of the ModRM byte.
+	 */
+	emit(buf, 0x48 | ((dst >= 8)? 0x04 : 0) | ((src >= 8)? 0x01 : 0));
+	emit(buf, 0x0F);
+	emit(buf, opcode);
+	emit(buf, 0xC0 | ((dst & 7) << 3) | (src & 7));
+}
+
+static size_t emit_jump(jit_buf_t *buf, uint8_t condition)
+{
+	/* A jump with a 32 bit displacement that is patched in later: either a
+	 * conditional jump (0x80 to 0x8F) or, for a condition of 0, a plain jmp.
+	 * Returns where the displacement has to go.
+	 */
+	if (condition)
+	{
+		emit(buf, 0x0F);
+		emit(buf, condition);
+	}
+	else emit(buf, 0xE9);
+	emit32(buf, 0);
+	return buf->len - 4;
+}
+
+static void patch_jump(jit_buf_t *buf, size_t at, size_t target)
+{
+	uint32_t rel = (uint32_t)(target - (at + 4));
+	memcpy(buf->code + at, &rel, sizeof(rel));
+}
+
+static void emit_push_const(jit_buf_t *buf, uint8_t reg, int64_t value)
+{
+	if ((value >= INT32_MIN) && (value <= INT32_MAX))
+	{
+		emit_unary(buf, 0xC7, 0, reg);	//mov r64, imm32 (sign extended)
+		emit32(buf, (uint32_t)value);
+		return;
+	}
+	emit(buf, 0x48 | ((reg >= 8)? 0x01 : 0));	//mov r64, imm64
+	emit(buf, 0xB8 + (reg & 7));
+	emit32(buf, (uint32_t)((uint64_t)value & 0xFFFFFFFFu));
+	emit32(buf, (uint32_t)((uint64_t)value >> 32));
+}
+
+static void emit_push_var(jit_buf_t *buf, uint8_t reg, uint8_t var)
+{
+	emit(buf, 0x48);	//mov rax, [rdi + var * 8]: the column
+	emit(buf, 0x8B);
+	emit(buf, 0x87);
+	emit32(buf, (uint32_t)var * sizeof(calc_value_t *));
+	emit(buf, 0x48 | ((reg >= 8)? 0x04 : 0));	//mov r64, [rax + rsi * 8]: the row
+	emit(buf, 0x8B);
+	emit(buf, 0x04 | ((reg & 7) << 3));
+	emit(buf, 0xF0);
+}
+# endif
+
+uint8_t jit_compile(const calc_prog_t *prog, calc_jit_t *jit)
+{
+	/* This function translates a compiled (and ideally folded) program into
+	 * x86-64 machine code, so that an expression evaluated millions of times
+	 * runs without an interpreter loop at all. The generated function is
+	 * called as jit->fn(columns, row, &result) with the same columns as a
+	 * col_table_t, and returns a calc status just like prog_eval(). Since the
+	 * depth of the operand stack is known at every instruction, the operand
+	 * stack needs no memory: stack slot n simply is register stack_regs[n],
+	 * so a push is a single mov into the next register and most operators
+	 * are a single instruction on the top one or two registers. Overflows are
+	 * caught with jo after add, sub, imul and neg (the flag the checked
+	 * builtins test too), and division checks for a zero divisor and for -1
+	 * (where it negates instead, which overflows exactly for the most
+	 * negative value) before it idivs. abs(), min() and max() are a compare
+	 * and a conditional move, so they never branch on the data. Every check
+	 * jumps to a stub at the end that returns the error; the result is only
+	 * stored if every op succeeded.
+	 * The code is written into an anonymous mapping that is made executable
+	 * (and read-only) once it is complete, so no page is ever writable and
+	 * executable at the same time. Only INT64 mode on x86-64 is supported,
+	 * and only programs whose operand stack fits into the JIT_REGS stack
+	 * registers, and only the arithmetic operators, abs(), min() and max() are
+	 * translated ('^', for one, is a loop rather than an instruction): for
+	 * anything else (or if the mapping fails) CALC_EUNSUPPORTED
+	 * is returned and the caller falls back to the interpreter.
+	 */
+	jit->fn = NULL;
+	jit->code = NULL;
+	jit->size = REF_INACTIVE;
+# if defined(CALC_MODE_INT64) && defined(__x86_64__)
+	if ((prog->depth == 0) || (prog->depth > JIT_REGS))
+	{
+		return CALC_EUNSUPPORTED;
+	}
+	/* Every instruction is at most 44 bytes (a division), the prologue and
+	 * the epilogue at most 16 each and the two error stubs 10 each.
+	 */
+	long page = sysconf(_SC_PAGESIZE);
+	size_t size = ((size_t)prog->len * 48) + 64;
+	if (page > 0) size = ((size + page - 1) / page) * page;
+	void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	size_t *overflow_jumps = malloc(((size_t)prog->len + 1) * sizeof(size_t));
+	size_t *divzero_jumps = malloc(((size_t)prog->len + 1) * sizeof(size_t));
+	if ((mapping == MAP_FAILED) || (overflow_jumps == NULL) || (divzero_jumps == NULL))
+	{
+		if (mapping != MAP_FAILED) munmap(mapping, size);
+		free(overflow_jumps);
+		free(divzero_jumps);
+		return CALC_EUNSUPPORTED;
+	}
+	jit_buf_t buf = {mapping, 0};
+	size_t n_overflow = REF_INACTIVE;
+	size_t n_divzero = REF_INACTIVE;
+
+	for (uint32_t slot = JIT_SAVED_FROM; slot < prog->depth; slot++)	//push the callee-saved registers used
+	{
+		if (stack_regs[slot] >= 8) emit(&buf, 0x41);
+		emit(&buf, 0x50 + (stack_regs[slot] & 7));
+	}
+	emit_rr(&buf, 0x89, REG_R11, REG_RDX);	//mov r11, rdx: keep the result pointer away from idiv
+
+	uint32_t top = REF_INACTIVE;
+	for (uint32_t index = 0; index < prog->len; index++)
+	{
+		const calc_instr_t *instr = &prog->code[index];
+		if (instr->opcode == INSTR_PUSH)
+		{
+			emit_push_const(&buf, stack_regs[top++], instr->value);
+			continue;
+		}
+		if (instr->opcode == INSTR_VAR)
+		{
+			emit_push_var(&buf, stack_regs[top++], (uint8_t)instr->value);
+			continue;
+		}
+		uint8_t arity = OP_ARITY(instr->opcode);
+		uint8_t dst = stack_regs[top - arity];
+		uint8_t src = stack_regs[top - 1];
+		top -= arity - 1;
+		switch (instr->opcode)
+		{
+			case OP_ADD:
+			{
+				emit_rr(&buf, 0x01, dst, src);
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);	//jo
+				break;
+			}
+			case OP_SUB:
+			{
+				emit_rr(&buf, 0x29, dst, src);
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);
+				break;
+			}
+			case OP_MUL:
+			{
+				emit_0f(&buf, 0xAF, dst, src);	//imul dst, src
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);
+				break;
+			}
+			case OP_DIV:
+			{
+				emit_rr(&buf, 0x85, src, src);	//test src, src
+				divzero_jumps[n_divzero++] = emit_jump(&buf, 0x84);	//jz
+				emit_unary(&buf, 0x83, 7, src);	//cmp src, -1
+				emit(&buf, 0xFF);
+				size_t to_idiv = emit_jump(&buf, 0x85);	//jne
+				emit_unary(&buf, 0xF7, 3, dst);	//neg dst
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);
+				size_t to_done = emit_jump(&buf, 0);
+				patch_jump(&buf, to_idiv, buf.len);
+				emit_rr(&buf, 0x89, REG_RAX, dst);	//mov rax, dst
+				emit(&buf, 0x48);	//cqo
+				emit(&buf, 0x99);
+				emit_unary(&buf, 0xF7, 7, src);	//idiv src
+				emit_rr(&buf, 0x89, dst, REG_RAX);	//mov dst, rax
+				patch_jump(&buf, to_done, buf.len);
+				break;
+			}
+			case OP_NEG:
+			{
+				emit_unary(&buf, 0xF7, 3, dst);	//neg dst
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);
+				break;
+			}
+			case OP_ABS:
+			{
+				emit_rr(&buf, 0x89, REG_RAX, dst);	//mov rax, dst
+				emit_unary(&buf, 0xF7, 3, REG_RAX);	//neg rax
+				overflow_jumps[n_overflow++] = emit_jump(&buf, 0x80);
+				emit_0f(&buf, 0x49, dst, REG_RAX);	//cmovns dst, rax: -dst wasn't negative
+				break;
+			}
+			case OP_MIN:
+			case OP_MAX:
+			{
+				emit_rr(&buf, 0x39, dst, src);	//cmp dst, src
+				emit_0f(&buf, (instr->opcode == OP_MIN)? 0x4F : 0x4C, dst, src);	//cmovg or cmovl dst, src
+				break;
+			}
+			default:
+			{
+				munmap(mapping, size);
+				free(overflow_jumps);
+				free(divzero_jumps);
+				return CALC_EUNSUPPORTED;
+			}
+		} //end switch (instr->opcode)
+	} //end for-loop over instructions
+
+	emit(&buf, 0x49);	//mov [r11], rcx: the bottom of the stack is the result
+	emit(&buf, 0x89);
+	emit(&buf, 0x0B);
+	emit(&buf, 0x31);	//xor eax, eax: CALC_OK
+	emit(&buf, 0xC0);
+	size_t epilogue = buf.len;
+	for (uint32_t slot = prog->depth; slot > JIT_SAVED_FROM; slot--)
+	{
+		if (stack_regs[slot - 1] >= 8) emit(&buf, 0x41);
+		emit(&buf, 0x58 + (stack_regs[slot - 1] & 7));
+	}
+	emit(&buf, 0xC3);	//ret
+
+	size_t overflow_stub = buf.len;
+	emit(&buf, 0xB8);	//mov eax, CALC_EOVERFLOW
+	emit32(&buf, CALC_EOVERFLOW);
+	patch_jump(&buf, emit_jump(&buf, 0), epilogue);
+	size_t divzero_stub = buf.len;
+	emit(&buf, 0xB8);	//mov eax, CALC_EDIVZERO
+	emit32(&buf, CALC_EDIVZERO);
+	patch_jump(&buf, emit_jump(&buf, 0), epilogue);
+	for (size_t jump = 0; jump < n_overflow; jump++) patch_jump(&buf, overflow_jumps[jump], overflow_stub);
+	for (size_t jump = 0; jump < n_divzero; jump++) patch_jump(&buf, divzero_jumps[jump], divzero_stub);
+	free(overflow_jumps);
+	free(divzero_jumps);
+
+	if (mprotect(mapping, size, PROT_READ | PROT_EXEC) != 0)
+	{
+		munmap(mapping, size);
+		return CALC_EUNSUPPORTED;
+	}
+	jit->code = mapping;
+	jit->size = size;
+	/* ISO C has no conversion from an object pointer to a function pointer,
+	 * POSIX (which dlsym() relies on) does, so the pointer is copied over.
+	 */
+	memcpy(&jit->fn, &mapping, sizeof(jit->fn));
+	return CALC_OK;
+# else
+	(void)prog;
+	return CALC_EUNSUPPORTED;
+# endif
+} //end uint8_t jit_compile()
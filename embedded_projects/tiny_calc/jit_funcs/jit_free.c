@@ -0,0 +1,13 @@
+# include "../src/claytor.h"
+
+void jit_free(calc_jit_t *jit)
+{
+	/* This function releases the native code of a program translated by
+	 * jit_compile(). The translation is left empty, so freeing it twice (or
+	 * freeing one that jit_compile() declined) is harmless.
+	 */
+	if (jit->code != NULL) munmap(jit->code, jit->size);
+	jit->fn = NULL;
+	jit->code = NULL;
+	jit->size = REF_INACTIVE;
+} //end void jit_free()
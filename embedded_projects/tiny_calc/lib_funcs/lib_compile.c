@@ -0,0 +1,38 @@
+# include "../src/claytor.h"
+
+uint8_t claytor_compile(const char *src_array, claytor_expr_t **expr, size_t *error_offset)
+{
+	/* This function is the library's way into the calculator: it parses the
+	 * expression in src_array, folds it and compiles it into a program, just
+	 * like column mode does, and hands back the result through expr, to be
+	 * evaluated by claytor_eval() and eventually released by claytor_free().
+	 * If the expression is malformed, its status is returned, expr is set to
+	 * NULL and error_offset (unless NULL) is where in src_array the problem
+	 * was found. Nothing but the expression is allocated, and src_array is
+	 * only ever read.
+	 */
+	*expr = NULL;
+	calc_ast_t ast;
+	uint8_t status = ast_parse(src_array, &ast);
+	if (status != CALC_OK)
+	{
+		if (error_offset != NULL) *error_offset = ast.error_offset;
+		return status;
+	}
+	claytor_expr_t *compiled = malloc(sizeof(claytor_expr_t));
+	if (compiled == NULL)
+	{
+		ast_free(&ast);
+		return CALC_ENOMEM;
+	}
+	ast_fold(&ast);
+	status = prog_compile(&ast, &compiled->prog);
+	ast_free(&ast);
+	if (status != CALC_OK)
+	{
+		free(compiled);
+		return status;
+	}
+	*expr = compiled;
+	return CALC_OK;
+} //end uint8_t claytor_compile()
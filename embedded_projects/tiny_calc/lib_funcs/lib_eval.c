@@ -0,0 +1,14 @@
+# include "../src/claytor.h"
+
+uint8_t claytor_eval(const claytor_expr_t *expr, const calc_value_t *vars, calc_value_t *result)
+{
+	/* This function evaluates an expression compiled by claytor_compile()
+	 * with its variables bound to vars, indexed 0 for 'a' to CALC_VARS - 1
+	 * for 'z' (vars can be NULL for an expression without variables, which
+	 * otherwise fails with CALC_EUNBOUND.) The result belongs to the caller,
+	 * who has to claytor_release() it in bignum mode. The expression is only
+	 * read, and evaluation keeps its operand stack on the caller's stack, so
+	 * any number of threads can evaluate the same expression at once.
+	 */
+	return prog_eval(&expr->prog, vars, result);
+} //end uint8_t claytor_eval()
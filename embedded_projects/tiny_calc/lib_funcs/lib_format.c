@@ -0,0 +1,11 @@
+# include "../src/claytor.h"
+
+int claytor_format(calc_value_t value, char *dest_array, size_t size)
+{
+	/* This function writes a value into dest_array as text, following the
+	 * conventions of snprintf(): the text is truncated to fit size, and the
+	 * length it needed is returned (negative if it couldn't be formatted), so
+	 * a caller can retry with a buffer of the right size.
+	 */
+	return value_format(value, dest_array, size);
+} //end int claytor_format()
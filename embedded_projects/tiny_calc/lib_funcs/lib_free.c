@@ -0,0 +1,14 @@
+# include "../src/claytor.h"
+
+void claytor_free(claytor_expr_t *expr)
+{
+	/* This function releases an expression compiled by claytor_compile().
+	 * Like free(), it accepts NULL.
+	 */
+	if (expr == NULL)
+	{
+		return;
+	}
+	prog_free(&expr->prog);
+	free(expr);
+} //end void claytor_free()
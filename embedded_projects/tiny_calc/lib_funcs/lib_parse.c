@@ -0,0 +1,41 @@
+# include "../src/claytor.h"
+
+uint8_t claytor_parse(const char *src_array, calc_value_t *value)
+{
+	/* This function converts a whole string (say, a field read from a file)
+	 * into a value to bind a variable to, which is the only way to come by a
+	 * number too long for 64 bits in bignum mode. An optional leading minus
+	 * is allowed, as is surrounding whitespace; anything else that isn't part
+	 * of the number is CALC_ESYNTAX.
+	 */
+	const char *reader = src_array;
+	while (isspace((unsigned char)*reader)) reader++;
+	uint8_t negative = (*reader == 0x2D);	//'-'
+	if (negative) reader++;
+	if (!isdigit((unsigned char)*reader) && (*reader != 0x2E))	//'.'
+	{
+		return CALC_ESYNTAX;
+	}
+	char *end = NULL;
+	calc_value_t parsed = VALUE_INT(REF_INACTIVE);
+	uint8_t status = value_parse(reader, &end, &parsed);
+	while ((status == CALC_OK) && isspace((unsigned char)*end)) end++;
+	if ((status == CALC_OK) && (*end != '\0'))
+	{
+		status = CALC_ESYNTAX;
+	}
+	if ((status == CALC_OK) && negative)
+	{
+		calc_value_t negated = VALUE_INT(REF_INACTIVE);
+		status = op_neg(parsed, &negated);
+		value_release(&parsed);
+		parsed = negated;
+	}
+	if (status != CALC_OK)
+	{
+		value_release(&parsed);
+		return status;
+	}
+	*value = parsed;
+	return CALC_OK;
+} //end uint8_t claytor_parse()
@@ -0,0 +1,10 @@
+# include "../src/claytor.h"
+
+void claytor_release(calc_value_t *value)
+{
+	/* This function releases a value returned by claytor_eval() or
+	 * claytor_parse(). Only bignums own memory, so in every other mode it
+	 * does nothing, but calling it keeps a program portable between modes.
+	 */
+	value_release(value);
+} //end void claytor_release()
@@ -0,0 +1,10 @@
+# include "../src/claytor.h"
+
+const char *claytor_strerror(uint8_t status)
+{
+	/* This function describes a status returned by any other library
+	 * function. The descriptions are string literals, so they never have to
+	 * be freed and are safe to use from any thread.
+	 */
+	return calc_strerror(status);
+} //end const char *claytor_strerror()
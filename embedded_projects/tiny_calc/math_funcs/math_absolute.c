@@ -0,0 +1,19 @@
+# include "../src/claytor.h"
+
+uint8_t op_abs(calc_value_t operand, calc_value_t *absolute)
+{
+	/* Absolute value function used by the calculator for abs(). Negative
+	 * operands are negated through op_neg(), so abs() of the most negative
+	 * integer overflows; anything else is copied as it is.
+	 */
+# if defined(CALC_MODE_DOUBLE)
+	*absolute = fabs(operand);
+	return CALC_OK;
+# else
+	if (value_cmp(operand, VALUE_INT(REF_INACTIVE)) < 0)
+	{
+		return op_neg(operand, absolute);
+	}
+	return value_copy(operand, absolute);
+# endif
+} //end uint8_t op_abs()
@@ -1,10 +1,31 @@
 # include "../src/claytor.h"
 
-int32_t op_add(int32_t augend, int32_t addend)
+uint8_t op_add(calc_value_t augend, calc_value_t addend, calc_value_t *sum)
 {
 	/* Addition function used by the calculator. It adds operand_2 (the addend)
-	 * to operand_1 (the augend.)
+	 * to operand_1 (the augend.) In the integer modes the compiler's checked
+	 * builtin performs the addition, so a sum that doesn't fit is reported as
+	 * an overflow instead of silently wrapping (which is undefined behaviour
+	 * for signed integers anyway.) In double mode an infinite sum is reported
+	 * as an overflow instead. In bignum mode two small operands take the same
+	 * checked path, and only a sum that overflows it (or a big operand) goes
+	 * through the limb arithmetic of bignum_addsub(). Rational mode adds
+	 * fractions through rational_addsub(), which is exact.
 	 */
-	int32_t sum = augend + addend;
-	return (sum);
-} //end int16_t addition()
+# if defined(CALC_MODE_RATIONAL)
+	return rational_addsub(augend, addend, REF_INACTIVE, sum);
+# elif defined(CALC_MODE_BIGNUM)
+	if ((augend.big == NULL) && (addend.big == NULL) &&
+		!__builtin_add_overflow(augend.small, addend.small, &sum->small))
+	{
+		sum->big = NULL;
+		return CALC_OK;
+	}
+	return bignum_addsub(augend, addend, REF_INACTIVE, sum);
+# elif defined(CALC_MODE_DOUBLE)
+	*sum = augend + addend;
+	return isfinite(*sum)? CALC_OK : CALC_EOVERFLOW;
+# else
+	return __builtin_add_overflow(augend, addend, sum)? CALC_EOVERFLOW : CALC_OK;
+# endif
+} //end uint8_t op_add()
@@ -0,0 +1,17 @@
+# include "../src/claytor.h"
+
+uint8_t op_apply(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	/* This function applies the op an opcode stands for to its operands, so
+	 * that every evaluator (ast_eval(), prog_eval(), ast_fold() and column
+	 * mode's fallback) shares one mapping from opcodes onto math functions:
+	 * the kernels of the operator registry, calc_ops[], which the opcode
+	 * indexes directly. Unary ops ignore rhs. CALC_ESYNTAX is returned for an
+	 * opcode that isn't an operator.
+	 */
+	if ((opcode >= OP_COUNT) || (calc_ops[opcode].kernel == NULL))
+	{
+		return CALC_ESYNTAX;
+	}
+	return calc_ops[opcode].kernel(lhs, rhs, result);
+} //end uint8_t op_apply()
@@ -0,0 +1,86 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_DOUBLE) || defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+static uint8_t to_bits(calc_value_t value, int64_t *bits)
+{
+	/* The two's complement bits of a value. Only integers have any, and
+	 * only those that fit into 64 bits are handled.
+	 */
+#  if defined(CALC_MODE_DOUBLE)
+	if (value != trunc(value))
+	{
+		return CALC_EDOMAIN;
+	}
+	if ((value < -0x1p63) || (value >= 0x1p63))
+	{
+		return CALC_EOVERFLOW;
+	}
+	*bits = (int64_t)value;
+#  elif defined(CALC_MODE_RATIONAL)
+	if (!INTEGER_IS(value.den, 1))
+	{
+		return CALC_EDOMAIN;
+	}
+	if (value.num.big != NULL)
+	{
+		return CALC_EOVERFLOW;
+	}
+	*bits = value.num.small;
+#  else
+	if (value.big != NULL)
+	{
+		return CALC_EOVERFLOW;
+	}
+	*bits = value.small;
+#  endif
+	return CALC_OK;
+}
+# endif
+
+uint8_t op_bitwise(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	/* Bitwise function used by the calculator for '&', '|', '~' and xor(),
+	 * which opcode chooses between ('~' ignores rhs.) The operands are seen
+	 * as two's complement integers of infinite width, so ~x is -x-1 and the
+	 * result never overflows in the integer modes. Double mode only has bits
+	 * for integral operands (anything else is a domain error) that fit into
+	 * 64 bits, and the result has to convert back exactly; bignum mode
+	 * handles operands that fit into 64 bits and reports larger ones as an
+	 * overflow. Rational mode treats its operands like double mode does,
+	 * integers only, and like bignum mode, up to 64 bits.
+	 */
+# if defined(CALC_MODE_DOUBLE) || defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+	int64_t bits_1 = REF_INACTIVE;
+	int64_t bits_2 = REF_INACTIVE;
+	uint8_t status = to_bits(lhs, &bits_1);
+	if ((status == CALC_OK) && (opcode != OP_NOT)) status = to_bits(rhs, &bits_2);
+	if (status != CALC_OK)
+	{
+		return status;
+	}
+	int64_t bits = REF_INACTIVE;
+# else
+	calc_value_t bits_1 = lhs;
+	calc_value_t bits_2 = rhs;
+	calc_value_t bits = REF_INACTIVE;
+# endif
+	switch (opcode)
+	{
+		case OP_AND: bits = bits_1 & bits_2; break;
+		case OP_OR: bits = bits_1 | bits_2; break;
+		case OP_XOR: bits = bits_1 ^ bits_2; break;
+		case OP_NOT: bits = ~bits_1; break;
+		default: return CALC_ESYNTAX;
+	}
+# if defined(CALC_MODE_DOUBLE)
+	*result = (double)bits;
+	if ((*result >= 0x1p63) || ((int64_t)*result != bits))
+	{
+		return CALC_EOVERFLOW;	//more significant bits than a double holds
+	}
+	return CALC_OK;
+# else
+	*result = VALUE_INT(bits);
+	return CALC_OK;
+# endif
+} //end uint8_t op_bitwise()
@@ -0,0 +1,72 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+static int integer_cmp(calc_integer_t integer_1, calc_integer_t integer_2)
+{
+	/* Compares two bignum integers. Two small ones are compared directly;
+	 * otherwise both are viewed as a sign and a magnitude, and the magnitudes
+	 * are only compared if the signs agree.
+	 */
+	if ((integer_1.big == NULL) && (integer_2.big == NULL))
+	{
+		return (integer_1.small > integer_2.small) - (integer_1.small < integer_2.small);
+	}
+	uint32_t scratch_1[2], scratch_2[2];
+	const uint32_t *limbs_1, *limbs_2;
+	uint32_t len_1, len_2;
+	uint8_t negative_1, negative_2;
+	bignum_view(&integer_1, scratch_1, &limbs_1, &len_1, &negative_1);
+	bignum_view(&integer_2, scratch_2, &limbs_2, &len_2, &negative_2);
+	if (negative_1 != negative_2)
+	{
+		return (negative_1)? -1 : 1;
+	}
+	int magnitude = bignum_cmp(limbs_1, len_1, limbs_2, len_2);
+	return (negative_1)? -magnitude : magnitude;
+}
+# endif
+
+int value_cmp(calc_value_t operand_1, calc_value_t operand_2)
+{
+	/* This function compares two values the way strcmp() compares strings:
+	 * the result is negative, zero or positive as operand_1 is less than,
+	 * equal to or greater than operand_2. Bignum mode compares sign and
+	 * magnitude (see integer_cmp()). Rational mode compares a/b with c/d as
+	 * a*d with c*b, which keeps the order since denominators are positive:
+	 * fractions with the same denominator compare their numerators, parts
+	 * that fit into 64 bits have their cross products compared in 128 bits,
+	 * and only big ones multiply through bignum_mul(). If that runs out of
+	 * memory the two are reported as equal, as nothing better can be said.
+	 */
+# if defined(CALC_MODE_RATIONAL)
+	if (integer_cmp(operand_1.den, operand_2.den) == 0)
+	{
+		return integer_cmp(operand_1.num, operand_2.num);
+	}
+	if ((operand_1.num.big == NULL) && (operand_1.den.big == NULL) && (operand_2.num.big == NULL) && (operand_2.den.big == NULL))
+	{
+		__extension__ __int128 cross_1 = (__int128)operand_1.num.small * operand_2.den.small;
+		__extension__ __int128 cross_2 = (__int128)operand_2.num.small * operand_1.den.small;
+		return (cross_1 > cross_2) - (cross_1 < cross_2);
+	}
+	if (INTEGER_NEGATIVE(operand_1.num) != INTEGER_NEGATIVE(operand_2.num))
+	{
+		return (INTEGER_NEGATIVE(operand_1.num))? -1 : 1;
+	}
+	calc_integer_t cross_1 = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t cross_2 = INTEGER_INT(REF_INACTIVE);
+	int order = 0;
+	if ((bignum_mul(operand_1.num, operand_2.den, &cross_1) == CALC_OK)
+		&& (bignum_mul(operand_2.num, operand_1.den, &cross_2) == CALC_OK))
+	{
+		order = integer_cmp(cross_1, cross_2);
+	}
+	bignum_release(&cross_1);
+	bignum_release(&cross_2);
+	return order;
+# elif defined(CALC_MODE_BIGNUM)
+	return integer_cmp(operand_1, operand_2);
+# else
+	return (operand_1 > operand_2) - (operand_1 < operand_2);
+# endif
+} //end int value_cmp()
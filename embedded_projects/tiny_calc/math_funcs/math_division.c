@@ -1,10 +1,43 @@
 # include "../src/claytor.h"
 
-int32_t op_div(int32_t dividend, int32_t divisor)
+uint8_t op_div(calc_value_t dividend, calc_value_t divisor, calc_value_t *ratio)
 {
 	/* Division function used by the calculator. It divides operand_1 (the
-	 * dividend) by operand_2 (the divisor.)
+	 * dividend) by operand_2 (the divisor.) A zero divisor is reported in every
+	 * mode rather than trapping (integers) or producing infinity (doubles.) In
+	 * the integer modes there is exactly one other quotient that can't be
+	 * represented: the most negative value divided by -1, which is caught by
+	 * negating the dividend through the checked builtin first. In bignum mode
+	 * that quotient is simply promoted, like every other big operand. Rational
+	 * mode is the one mode whose division doesn't round at all: the quotient
+	 * is the exact fraction, computed by rational_muldiv(), so 1/3*3 is 1.
 	 */
-	int32_t ratio = dividend / divisor;
-	return ratio;
-} //end int16_t division()
+# if defined(CALC_MODE_RATIONAL)
+	return rational_muldiv(dividend, divisor, REF_ACTIVATE, ratio);
+# elif defined(CALC_MODE_BIGNUM)
+	if ((dividend.big == NULL) && (divisor.big == NULL) && (divisor.small != 0) &&
+		!((divisor.small == -1) && (dividend.small == INT64_MIN)))
+	{
+		*ratio = VALUE_INT(dividend.small / divisor.small);
+		return CALC_OK;
+	}
+	return bignum_divmod(dividend, divisor, ratio, NULL);
+# else
+	if (divisor == 0)
+	{
+		return CALC_EDIVZERO;
+	}
+#  if defined(CALC_MODE_DOUBLE)
+	*ratio = dividend / divisor;
+	return isfinite(*ratio)? CALC_OK : CALC_EOVERFLOW;
+#  else
+	calc_value_t negated = VALUE_INT(REF_INACTIVE);
+	if ((divisor == -1) && __builtin_sub_overflow((calc_value_t)0, dividend, &negated))
+	{
+		return CALC_EOVERFLOW;
+	}
+	*ratio = dividend / divisor;
+	return CALC_OK;
+#  endif
+# endif
+} //end uint8_t op_div()
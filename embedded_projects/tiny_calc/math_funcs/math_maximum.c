@@ -0,0 +1,9 @@
+# include "../src/claytor.h"
+
+uint8_t op_max(calc_value_t operand_1, calc_value_t operand_2, calc_value_t *maximum)
+{
+	/* Maximum function used by the calculator for max(): the greater of the
+	 * two operands (the first one if they are equal), copied.
+	 */
+	return value_copy((value_cmp(operand_1, operand_2) >= 0)? operand_1 : operand_2, maximum);
+} //end uint8_t op_max()
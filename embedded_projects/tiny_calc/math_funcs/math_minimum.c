@@ -0,0 +1,9 @@
+# include "../src/claytor.h"
+
+uint8_t op_min(calc_value_t operand_1, calc_value_t operand_2, calc_value_t *minimum)
+{
+	/* Minimum function used by the calculator for min(): the lesser of the
+	 * two operands (the first one if they are equal), copied.
+	 */
+	return value_copy((value_cmp(operand_1, operand_2) <= 0)? operand_1 : operand_2, minimum);
+} //end uint8_t op_min()
@@ -1,10 +1,28 @@
 # include "../src/claytor.h"
 
-int32_t op_mul(int32_t multiplicand, int32_t multiplier)
+uint8_t op_mul(calc_value_t multiplicand, calc_value_t multiplier, calc_value_t *prod)
 {
 	/* Multiplication function used by the calculator. It multiplies operand_1
-	 * (the multiplicand) by operand_2 (the multiplier.)
+	 * (the multiplicand) by operand_2 (the multiplier.) As with op_add(), the
+	 * integer modes use the checked builtin and double mode checks for
+	 * infinity, and bignum mode only leaves the checked path once it
+	 * overflows (multiplying the limbs with Karatsuba once they are long.)
+	 * Rational mode multiplies fractions through rational_muldiv().
 	 */
-	int32_t prod = multiplicand * multiplier;
-	return prod;
-} //end int16_t multiplication()
+# if defined(CALC_MODE_RATIONAL)
+	return rational_muldiv(multiplicand, multiplier, REF_INACTIVE, prod);
+# elif defined(CALC_MODE_BIGNUM)
+	if ((multiplicand.big == NULL) && (multiplier.big == NULL) &&
+		!__builtin_mul_overflow(multiplicand.small, multiplier.small, &prod->small))
+	{
+		prod->big = NULL;
+		return CALC_OK;
+	}
+	return bignum_mul(multiplicand, multiplier, prod);
+# elif defined(CALC_MODE_DOUBLE)
+	*prod = multiplicand * multiplier;
+	return isfinite(*prod)? CALC_OK : CALC_EOVERFLOW;
+# else
+	return __builtin_mul_overflow(multiplicand, multiplier, prod)? CALC_EOVERFLOW : CALC_OK;
+# endif
+} //end uint8_t op_mul()
@@ -0,0 +1,30 @@
+# include "../src/claytor.h"
+
+uint8_t op_neg(calc_value_t operand, calc_value_t *negated)
+{
+	/* Negation function used by the calculator for a unary minus. The integer
+	 * modes subtract the operand from 0, which overflows exactly for the most
+	 * negative value, while double mode flips the sign directly so that -0
+	 * stays a negative zero. Rational mode negates the numerator the same way
+	 * and keeps the denominator.
+	 */
+# if defined(CALC_MODE_RATIONAL)
+	calc_value_t result = VALUE_INT(REF_INACTIVE);
+	uint8_t status = CALC_OK;
+	if ((operand.num.big == NULL) && (operand.num.small != INT64_MIN)) result.num = INTEGER_INT(-operand.num.small);
+	else status = bignum_addsub(INTEGER_INT(REF_INACTIVE), operand.num, REF_ACTIVATE, &result.num);
+	if (status == CALC_OK) status = bignum_copy(operand.den, &result.den);
+	if (status != CALC_OK)
+	{
+		value_release(&result);
+		return status;
+	}
+	*negated = result;
+	return CALC_OK;
+# elif defined(CALC_MODE_DOUBLE)
+	*negated = -operand;
+	return CALC_OK;
+# else
+	return op_sub(VALUE_INT(REF_INACTIVE), operand, negated);
+# endif
+} //end uint8_t op_neg()
@@ -0,0 +1,140 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+static uint64_t magnitude_bits(calc_integer_t integer)
+{
+	/* The number of bits of a (nonzero) bignum integer's magnitude.
+	 */
+	uint32_t scratch[2];
+	const uint32_t *limbs;
+	uint32_t len;
+	uint8_t negative;
+	bignum_view(&integer, scratch, &limbs, &len, &negative);
+	return ((uint64_t)(len - 1) * LIMB_BITS) + (LIMB_BITS - __builtin_clz(limbs[len - 1]));
+}
+# endif
+
+uint8_t op_pow(calc_value_t base, calc_value_t exponent, calc_value_t *power)
+{
+	/* Exponentiation function used by the calculator for '^' and pow(). Double
+	 * mode defers to pow(), reporting 0 to a negative power as a division by
+	 * zero, a result that isn't a number (a negative base to a fractional
+	 * power) as a domain error and an infinite one as an overflow. The
+	 * integer modes square and multiply through op_mul(), so every step is
+	 * checked (and promoted, in bignum mode) like any other multiplication:
+	 * one squaring per bit of the exponent, plus one multiplication per set
+	 * bit. A negative exponent is 1 / base^n, which truncates to 0 unless the
+	 * base is 1 or -1. Bases of 0, 1 and -1 never need the loop, so what's
+	 * left can only succeed for exponents that fit into 64 bits, and larger
+	 * ones are reported as an overflow straight away. Bignums could grow that
+	 * far, but never in reasonable time, so bignum mode reports an overflow
+	 * for any result that would be longer than POW_BITS bits. Rational mode
+	 * only raises to integer powers (anything else is a domain error, as most
+	 * such powers aren't rational), squaring and multiplying fractions the
+	 * same way, and a negative exponent is the reciprocal 1 / base^n; both
+	 * parts of the result are held to POW_BITS bits.
+	 */
+# if defined(CALC_MODE_DOUBLE)
+	if ((base == 0) && (exponent < 0))
+	{
+		return CALC_EDIVZERO;
+	}
+	*power = pow(base, exponent);
+	if (isnan(*power))
+	{
+		return CALC_EDOMAIN;
+	}
+	return isfinite(*power)? CALC_OK : CALC_EOVERFLOW;
+# else
+#  if defined(CALC_MODE_RATIONAL)
+	if (!INTEGER_IS(exponent.den, 1))
+	{
+		return CALC_EDOMAIN;
+	}
+	uint8_t odd = (exponent.num.big != NULL)? (exponent.num.big->limbs[0] & 1) : (exponent.num.small & 1);
+#  elif defined(CALC_MODE_BIGNUM)
+	uint8_t odd = (exponent.big != NULL)? (exponent.big->limbs[0] & 1) : (exponent.small & 1);
+#  else
+	uint8_t odd = (uint8_t)(VALUE_AS_INT(exponent) & 1);
+#  endif
+	uint8_t negative = (value_cmp(exponent, VALUE_INT(REF_INACTIVE)) < 0);
+	if (VALUE_IS(exponent, 0) || VALUE_IS(base, 1))
+	{
+		*power = VALUE_INT(1);
+		return CALC_OK;
+	}
+	if (VALUE_IS(base, -1))
+	{
+		*power = VALUE_INT((odd)? -1 : 1);
+		return CALC_OK;
+	}
+	if (VALUE_IS(base, 0))
+	{
+		*power = VALUE_INT(REF_INACTIVE);
+		return (negative)? CALC_EDIVZERO : CALC_OK;
+	}
+	if (negative)
+	{
+#  if defined(CALC_MODE_RATIONAL)
+		calc_value_t positive = VALUE_INT(REF_INACTIVE);
+		calc_value_t reciprocal = VALUE_INT(REF_INACTIVE);
+		uint8_t status = op_neg(exponent, &positive);
+		if (status == CALC_OK) status = op_pow(base, positive, &reciprocal);
+		if (status == CALC_OK) status = op_div(VALUE_INT(1), reciprocal, power);
+		value_release(&positive);
+		value_release(&reciprocal);
+		return status;
+#  else
+		*power = VALUE_INT(REF_INACTIVE);
+		return CALC_OK;
+#  endif
+	}
+	if (!VALUE_IS(exponent, VALUE_AS_INT(exponent)))
+	{
+		return CALC_EOVERFLOW;
+	}
+#  if defined(CALC_MODE_RATIONAL)
+	uint64_t base_bits = magnitude_bits(base.num);
+	if (magnitude_bits(base.den) > base_bits) base_bits = magnitude_bits(base.den);
+#  elif defined(CALC_MODE_BIGNUM)
+	uint64_t base_bits = magnitude_bits(base);
+#  endif
+#  if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+	if ((uint64_t)VALUE_AS_INT(exponent) > POW_BITS / (base_bits - 1))
+	{
+		return CALC_EOVERFLOW;	//the result would have more than POW_BITS bits
+	}
+#  endif
+
+	uint64_t remaining = (uint64_t)VALUE_AS_INT(exponent);
+	calc_value_t accumulated = VALUE_INT(1);
+	calc_value_t square = VALUE_INT(REF_INACTIVE);
+	uint8_t status = value_copy(base, &square);
+	while ((status == CALC_OK) && (remaining > 0))
+	{
+		calc_value_t next = VALUE_INT(REF_INACTIVE);
+		if (remaining & 1)
+		{
+			status = op_mul(accumulated, square, &next);
+			value_release(&accumulated);
+			accumulated = next;
+		}
+		remaining >>= 1;
+		if ((status == CALC_OK) && (remaining > 0))
+		{
+			next = VALUE_INT(REF_INACTIVE);
+			status = op_mul(square, square, &next);
+			value_release(&square);
+			square = next;
+		}
+	} //end while (remaining > 0)
+	value_release(&square);
+	if (status != CALC_OK)
+	{
+		value_release(&accumulated);
+		return status;
+	}
+	*power = accumulated;
+	return CALC_OK;
+# endif
+} //end uint8_t op_pow()
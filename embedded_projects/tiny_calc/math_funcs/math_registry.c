@@ -0,0 +1,128 @@
+# include "../src/claytor.h"
+
+/* Kernels of the registry entries whose math functions take their operands
+ * differently: unary ones without an rhs, and the families of operators that
+ * share one function and tell their members apart by opcode.
+ */
+static uint8_t neg_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	(void)rhs;
+	return op_neg(lhs, result);
+}
+
+static uint8_t abs_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	(void)rhs;
+	return op_abs(lhs, result);
+}
+
+static uint8_t sqrt_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	(void)rhs;
+	return op_sqrt(lhs, result);
+}
+
+static uint8_t not_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_bitwise(OP_NOT, lhs, rhs, result);
+}
+
+static uint8_t and_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_bitwise(OP_AND, lhs, rhs, result);
+}
+
+static uint8_t or_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_bitwise(OP_OR, lhs, rhs, result);
+}
+
+static uint8_t xor_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_bitwise(OP_XOR, lhs, rhs, result);
+}
+
+static uint8_t shl_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_shift(OP_SHL, lhs, rhs, result);
+}
+
+static uint8_t shr_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_shift(OP_SHR, lhs, rhs, result);
+}
+
+static uint8_t lt_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_LT, lhs, rhs, result);
+}
+
+static uint8_t le_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_LE, lhs, rhs, result);
+}
+
+static uint8_t gt_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_GT, lhs, rhs, result);
+}
+
+static uint8_t ge_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_GE, lhs, rhs, result);
+}
+
+static uint8_t eq_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_EQ, lhs, rhs, result);
+}
+
+static uint8_t ne_kernel(calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	return op_relation(OP_NE, lhs, rhs, result);
+}
+
+/* The operator registry: everything the lexer, the parser, the folder and
+ * the evaluators know about an operator, indexed by its opcode, so that
+ * applying one is a single indexed call (see op_apply()) and adding one is a
+ * new OP_ opcode, a kernel and an entry here. The precedences follow C's
+ * order for the arithmetic, with a few deliberate exceptions taken from
+ * Python: the bitwise operators bind tighter than the comparisons, so that
+ * a & 1 == 1 means (a & 1) == 1, and comparisons all share one level and
+ * simply associate to the left (1 < 2 < 3 is (1 < 2) < 3, that is 1.) A
+ * prefix operator binds looser than '^', so -2^2 is -(2^2) as it is written
+ * on paper. The units of the identities ast_fold() removes are listed
+ * along with them: x+0, 0+x, x-0, x*1, 1*x, x/1 and x^1 (in double mode,
+ * x+0 isn't an identity, since -0.0 + 0 is +0.0.) Opcodes 0 and 1 are the
+ * push instructions, which are not operators and have no entry.
+ */
+const calc_op_t calc_ops[OP_COUNT] = {
+	[OP_EQ] = {"==", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, eq_kernel},
+	[OP_NE] = {"!=", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, ne_kernel},
+	[OP_LT] = {"<", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, lt_kernel},
+	[OP_LE] = {"<=", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, le_kernel},
+	[OP_GT] = {">", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, gt_kernel},
+	[OP_GE] = {">=", NOTATION_INFIX, 2, 10, ASSOC_LEFT, 0, 0, ge_kernel},
+	[OP_OR] = {"|", NOTATION_INFIX, 2, 20, ASSOC_LEFT, 0, 0, or_kernel},
+	[OP_AND] = {"&", NOTATION_INFIX, 2, 30, ASSOC_LEFT, 0, 0, and_kernel},
+	[OP_SHL] = {"<<", NOTATION_INFIX, 2, 40, ASSOC_LEFT, 0, 0, shl_kernel},
+	[OP_SHR] = {">>", NOTATION_INFIX, 2, 40, ASSOC_LEFT, 0, 0, shr_kernel},
+# if defined(CALC_MODE_DOUBLE)
+	[OP_ADD] = {"+", NOTATION_INFIX, 2, 50, ASSOC_LEFT, 0, 0, op_add},
+# else
+	[OP_ADD] = {"+", NOTATION_INFIX, 2, 50, ASSOC_LEFT, IDENTITY_LEFT | IDENTITY_RIGHT, 0, op_add},
+# endif
+	[OP_SUB] = {"-", NOTATION_INFIX, 2, 50, ASSOC_LEFT, IDENTITY_RIGHT, 0, op_sub},
+	[OP_MUL] = {"*", NOTATION_INFIX, 2, 60, ASSOC_LEFT, IDENTITY_LEFT | IDENTITY_RIGHT, 1, op_mul},
+	[OP_DIV] = {"/", NOTATION_INFIX, 2, 60, ASSOC_LEFT, IDENTITY_RIGHT, 1, op_div},
+	[OP_MOD] = {"%", NOTATION_INFIX, 2, 60, ASSOC_LEFT, 0, 0, op_mod},
+	[OP_NEG] = {"-", NOTATION_PREFIX, 1, 70, ASSOC_RIGHT, 0, 0, neg_kernel},
+	[OP_NOT] = {"~", NOTATION_PREFIX, 1, 70, ASSOC_RIGHT, 0, 0, not_kernel},
+	[OP_POW] = {"^", NOTATION_INFIX, 2, 80, ASSOC_RIGHT, IDENTITY_RIGHT, 1, op_pow},
+	[OP_ABS] = {"abs", NOTATION_CALL, 1, 0, ASSOC_LEFT, 0, 0, abs_kernel},
+	[OP_MIN] = {"min", NOTATION_CALL, 2, 0, ASSOC_LEFT, 0, 0, op_min},
+	[OP_MAX] = {"max", NOTATION_CALL, 2, 0, ASSOC_LEFT, 0, 0, op_max},
+	[OP_SQRT] = {"sqrt", NOTATION_CALL, 1, 0, ASSOC_LEFT, 0, 0, sqrt_kernel},
+	[OP_POWCALL] = {"pow", NOTATION_CALL, 2, 0, ASSOC_LEFT, IDENTITY_RIGHT, 1, op_pow},
+	[OP_XOR] = {"xor", NOTATION_CALL, 2, 0, ASSOC_LEFT, 0, 0, xor_kernel},
+}; //end calc_ops[]
@@ -0,0 +1,25 @@
+# include "../src/claytor.h"
+
+uint8_t op_relation(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result)
+{
+	/* Comparison function used by the calculator for '<', '<=', '>', '>=',
+	 * '==' and '!=', which opcode chooses between. The result is 1 if the
+	 * relation holds and 0 if it doesn't, so comparisons can be computed with
+	 * like any other number (a * (a > 0) is a clamped at 0.) Both operands
+	 * are compared by value_cmp(), which never fails.
+	 */
+	int order = value_cmp(lhs, rhs);
+	uint8_t holds = REF_INACTIVE;
+	switch (opcode)
+	{
+		case OP_LT: holds = (order < 0); break;
+		case OP_LE: holds = (order <= 0); break;
+		case OP_GT: holds = (order > 0); break;
+		case OP_GE: holds = (order >= 0); break;
+		case OP_EQ: holds = (order == 0); break;
+		case OP_NE: holds = (order != 0); break;
+		default: return CALC_ESYNTAX;
+	}
+	*result = VALUE_INT(holds);
+	return CALC_OK;
+} //end uint8_t op_relation()
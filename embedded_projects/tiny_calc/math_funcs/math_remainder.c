@@ -0,0 +1,52 @@
+# include "../src/claytor.h"
+
+uint8_t op_mod(calc_value_t dividend, calc_value_t divisor, calc_value_t *remainder)
+{
+	/* Remainder function used by the calculator for '%'. It is the remainder
+	 * of op_div()'s truncating division, as in C: it takes the sign of the
+	 * dividend, so -7 % 2 is -1. A zero divisor is reported in every mode.
+	 * The one quotient op_div() can't represent has a remainder that can:
+	 * anything % -1 is 0, which is answered before the division could trap.
+	 * Double mode defers to fmod(), which is exact, and rational mode takes
+	 * the same remainder of fractions: a - b * trunc(a / b), so 7/2 % 1 is
+	 * 1/2.
+	 */
+# if defined(CALC_MODE_RATIONAL)
+	if (VALUE_IS(divisor, 0))
+	{
+		return CALC_EDIVZERO;
+	}
+	calc_value_t quotient = VALUE_INT(REF_INACTIVE);
+	calc_value_t whole = VALUE_INT(REF_INACTIVE);
+	calc_value_t multiple = VALUE_INT(REF_INACTIVE);
+	uint8_t status = op_div(dividend, divisor, &quotient);
+	if (status == CALC_OK) status = rational_trunc(quotient, REF_INACTIVE, &whole);
+	if (status == CALC_OK) status = op_mul(divisor, whole, &multiple);
+	if (status == CALC_OK) status = op_sub(dividend, multiple, remainder);
+	value_release(&quotient);
+	value_release(&whole);
+	value_release(&multiple);
+	return status;
+# elif defined(CALC_MODE_BIGNUM)
+	if ((dividend.big == NULL) && (divisor.big == NULL) && (divisor.small != 0))
+	{
+		*remainder = VALUE_INT((divisor.small == -1)? 0 : dividend.small % divisor.small);
+		return CALC_OK;
+	}
+	calc_value_t quotient = VALUE_INT(REF_INACTIVE);
+	uint8_t status = bignum_divmod(dividend, divisor, &quotient, remainder);
+	value_release(&quotient);
+	return status;
+# else
+	if (divisor == 0)
+	{
+		return CALC_EDIVZERO;
+	}
+#  if defined(CALC_MODE_DOUBLE)
+	*remainder = fmod(dividend, divisor);
+#  else
+	*remainder = (divisor == -1)? 0 : dividend % divisor;
+#  endif
+	return CALC_OK;
+# endif
+} //end uint8_t op_mod()
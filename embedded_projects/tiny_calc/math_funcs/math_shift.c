@@ -0,0 +1,172 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_BIGNUM)
+static uint8_t big_shift(uint8_t opcode, calc_value_t operand, calc_value_t places, calc_value_t *shifted)
+{
+	/* The slow path of bignum shifts: a multiplication or a division by the
+	 * power of two, both through the arithmetic that promotes. The truncated
+	 * quotient of a negative operand is rounded down if anything was left.
+	 */
+	uint32_t scratch[2];
+	const uint32_t *limbs;
+	uint32_t len;
+	uint8_t negative;
+	bignum_view(&operand, scratch, &limbs, &len, &negative);
+	if (len == 0)
+	{
+		*shifted = VALUE_INT(REF_INACTIVE);
+		return CALC_OK;
+	}
+	uint64_t bits = ((uint64_t)(len - 1) * LIMB_BITS) + (LIMB_BITS - __builtin_clz(limbs[len - 1]));
+	if ((opcode == OP_SHR) && ((places.big != NULL) || ((uint64_t)places.small >= bits)))
+	{
+		*shifted = VALUE_INT((negative)? -1 : 0);	//every bit is shifted out
+		return CALC_OK;
+	}
+	calc_value_t power = VALUE_INT(REF_INACTIVE);
+	uint8_t status = op_pow(VALUE_INT(2), places, &power);
+	if ((status == CALC_OK) && (opcode == OP_SHL))
+	{
+		status = op_mul(operand, power, shifted);
+	}
+	else if (status == CALC_OK)
+	{
+		calc_value_t quotient = VALUE_INT(REF_INACTIVE);
+		calc_value_t remainder = VALUE_INT(REF_INACTIVE);
+		status = bignum_divmod(operand, power, &quotient, &remainder);
+		if ((status == CALC_OK) && negative && !VALUE_IS(remainder, 0))
+		{
+			status = op_sub(quotient, VALUE_INT(1), shifted);
+			value_release(&quotient);
+		}
+		else if (status == CALC_OK)
+		{
+			*shifted = quotient;
+		}
+		value_release(&remainder);
+	}
+	value_release(&power);
+	return status;
+}
+# elif defined(CALC_MODE_RATIONAL)
+static uint8_t fraction_shift(uint8_t opcode, calc_value_t operand, calc_value_t places, calc_value_t *shifted)
+{
+	/* Rational shifts: a multiplication by the power of two, or a division
+	 * by it rounded down to an integer. A fraction is less than 2^n for n
+	 * the bits of its numerator, so shifting that far right leaves 0 or -1.
+	 */
+	uint32_t scratch[2];
+	const uint32_t *limbs;
+	uint32_t len;
+	uint8_t negative;
+	bignum_view(&operand.num, scratch, &limbs, &len, &negative);
+	if (len == 0)
+	{
+		*shifted = VALUE_INT(REF_INACTIVE);
+		return CALC_OK;
+	}
+	uint64_t bits = ((uint64_t)(len - 1) * LIMB_BITS) + (LIMB_BITS - __builtin_clz(limbs[len - 1]));
+	if ((opcode == OP_SHR) && ((places.num.big != NULL) || ((uint64_t)places.num.small >= bits)))
+	{
+		*shifted = VALUE_INT((negative)? -1 : 0);	//every bit is shifted out
+		return CALC_OK;
+	}
+	calc_value_t power = VALUE_INT(REF_INACTIVE);
+	calc_value_t quotient = VALUE_INT(REF_INACTIVE);
+	uint8_t status = op_pow(VALUE_INT(2), places, &power);
+	if ((status == CALC_OK) && (opcode == OP_SHL))
+	{
+		status = op_mul(operand, power, shifted);
+	}
+	else if (status == CALC_OK)
+	{
+		status = op_div(operand, power, &quotient);
+		if (status == CALC_OK) status = rational_trunc(quotient, REF_ACTIVATE, shifted);
+	}
+	value_release(&power);
+	value_release(&quotient);
+	return status;
+}
+# endif
+
+uint8_t op_shift(uint8_t opcode, calc_value_t operand, calc_value_t places, calc_value_t *shifted)
+{
+	/* Shift function used by the calculator for '<<' and '>>', which opcode
+	 * chooses between. Shifts are defined arithmetically rather than by the
+	 * width of the mode: x << n is x * 2^n, checked like any multiplication,
+	 * and x >> n is x / 2^n rounded down, so -5 >> 1 is -3 and shifting
+	 * every bit out leaves 0 or -1. A shift by a negative (or, in double
+	 * mode, fractional) number of places is a domain error. The integer modes
+	 * shift natively, and a left shift overflowed if shifting the result
+	 * back doesn't restore the operand. Double mode scales the exponent
+	 * through ldexp(), and bignum mode takes its small operands through the
+	 * same native shifts before it multiplies or divides big ones. Rational
+	 * mode shifts by integral places only, and always by multiplying or
+	 * dividing (see fraction_shift()), so 1/2 << 1 is 1 and 3/2 >> 1 is 0.
+	 */
+# if defined(CALC_MODE_DOUBLE)
+	if ((places < 0) || (places != trunc(places)))
+	{
+		return CALC_EDOMAIN;
+	}
+	int exponent = (places > 4096)? 4096 : (int)places;	//beyond that, every result is the same
+	*shifted = (opcode == OP_SHL)? ldexp(operand, exponent) : floor(ldexp(operand, -exponent));
+	return isfinite(*shifted)? CALC_OK : CALC_EOVERFLOW;
+# elif defined(CALC_MODE_RATIONAL)
+	if (!INTEGER_IS(places.den, 1) || INTEGER_NEGATIVE(places.num))
+	{
+		return CALC_EDOMAIN;
+	}
+	return fraction_shift(opcode, operand, places, shifted);
+# else
+	if (value_cmp(places, VALUE_INT(REF_INACTIVE)) < 0)
+	{
+		return CALC_EDOMAIN;
+	}
+#  if defined(CALC_MODE_BIGNUM)
+	if ((operand.big != NULL) || (places.big != NULL) || (places.small >= 64))
+	{
+		return big_shift(opcode, operand, places, shifted);
+	}
+	typedef int64_t shift_t;	//the small operands are shifted natively
+	typedef uint64_t bits_t;
+	shift_t value = operand.small;
+	uint8_t count = (uint8_t)places.small;
+#  else
+	typedef calc_value_t shift_t;
+#   if defined(CALC_MODE_INT128)
+	__extension__ typedef unsigned __int128 bits_t;
+#   else
+	typedef uint64_t bits_t;
+#   endif
+	shift_t value = operand;
+	uint8_t width = sizeof(calc_value_t) * 8;
+	if (places >= width)
+	{
+		if ((opcode == OP_SHL) && (value != 0))
+		{
+			return CALC_EOVERFLOW;
+		}
+		*shifted = (value < 0)? -1 : 0;
+		return CALC_OK;
+	}
+	uint8_t count = (uint8_t)places;
+#  endif
+	if (opcode == OP_SHR)
+	{
+		*shifted = VALUE_INT(value >> count);
+		return CALC_OK;
+	}
+	shift_t result = (shift_t)((bits_t)value << count);
+	if ((result >> count) != value)
+	{
+#  if defined(CALC_MODE_BIGNUM)
+		return big_shift(opcode, operand, places, shifted);
+#  else
+		return CALC_EOVERFLOW;
+#  endif
+	}
+	*shifted = VALUE_INT(result);
+	return CALC_OK;
+# endif
+} //end uint8_t op_shift()
@@ -0,0 +1,80 @@
+# include "../src/claytor.h"
+
+# if defined(CALC_MODE_RATIONAL)
+static uint8_t exact_root(calc_integer_t square, calc_integer_t *root)
+{
+	/* The root of an integer if it is a perfect square; a domain error if it
+	 * isn't, since its root then is irrational.
+	 */
+	calc_integer_t squared = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_isqrt(square, root);
+	if (status == CALC_OK) status = bignum_mul(*root, *root, &squared);
+	if (status == CALC_OK)
+	{
+		calc_integer_t diff = INTEGER_INT(REF_INACTIVE);
+		status = bignum_addsub(square, squared, REF_ACTIVATE, &diff);
+		if ((status == CALC_OK) && !INTEGER_IS(diff, 0)) status = CALC_EDOMAIN;
+		bignum_release(&diff);
+		bignum_release(&squared);
+		if (status != CALC_OK) bignum_release(root);
+	}
+	return status;
+}
+# endif
+
+uint8_t op_sqrt(calc_value_t operand, calc_value_t *root)
+{
+	/* Square root function used by the calculator for sqrt(). A negative
+	 * operand is a domain error in every mode. Double mode defers to sqrt(),
+	 * the integer modes compute the integer square root, the largest root
+	 * whose square doesn't exceed the operand (so sqrt(8) is 2, just like
+	 * 8/3 is 2.) That is Newton's iteration x = (x + n/x) / 2 started from a
+	 * power of two no smaller than the root, which only ever decreases and
+	 * stops as soon as it doesn't: a handful of divisions even for 128 bit
+	 * operands. Bignum mode takes the same steps in bignum_isqrt(). Rational
+	 * mode only has exact roots: a fraction in lowest terms has a rational
+	 * root only if both its numerator and its denominator are perfect
+	 * squares (sqrt(9/4) is 3/2), and anything else is a domain error.
+	 */
+# if defined(CALC_MODE_DOUBLE)
+	if (operand < 0)
+	{
+		return CALC_EDOMAIN;
+	}
+	*root = sqrt(operand);
+	return CALC_OK;
+# else
+	if (value_cmp(operand, VALUE_INT(REF_INACTIVE)) < 0)
+	{
+		return CALC_EDOMAIN;
+	}
+#  if defined(CALC_MODE_RATIONAL)
+	uint8_t status = exact_root(operand.num, &root->num);
+	if (status == CALC_OK)
+	{
+		status = exact_root(operand.den, &root->den);
+		if (status != CALC_OK) bignum_release(&root->num);
+	}
+	return status;	//the roots of coprime integers are coprime as well
+#  elif defined(CALC_MODE_BIGNUM)
+	return bignum_isqrt(operand, root);
+#  else
+	if (operand < 2)
+	{
+		*root = operand;
+		return CALC_OK;
+	}
+	uint8_t bits = REF_INACTIVE;
+	for (calc_value_t rest = operand; rest > 0; rest >>= 1) bits++;
+	calc_value_t guess = (calc_value_t)1 << ((bits + 1) / 2);
+	for (;;)
+	{
+		calc_value_t next = (guess + (operand / guess)) / 2;
+		if (next >= guess) break;
+		guess = next;
+	}
+	*root = guess;
+	return CALC_OK;
+#  endif
+# endif
+} //end uint8_t op_sqrt()
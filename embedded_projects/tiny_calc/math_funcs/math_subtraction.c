@@ -1,10 +1,27 @@
 # include "../src/claytor.h"
 
-int32_t op_sub(int32_t subtrahend, int32_t minuend)
+uint8_t op_sub(calc_value_t subtrahend, calc_value_t minuend, calc_value_t *diff)
 {
 	/* Subtraction function used by the calculator. It subtracts operand_2 (the
-	 * minuend) from operand_1 (the subtrahend.)
+	 * minuend) from operand_1 (the subtrahend.) As with op_add(), the integer
+	 * modes use the checked builtin and double mode checks for infinity, and
+	 * bignum mode only leaves the checked path once it overflows. Rational
+	 * mode subtracts through rational_addsub().
 	 */
-	int32_t diff = subtrahend - minuend;
-	return diff;
-} //end int16_t subtraction()
+# if defined(CALC_MODE_RATIONAL)
+	return rational_addsub(subtrahend, minuend, REF_ACTIVATE, diff);
+# elif defined(CALC_MODE_BIGNUM)
+	if ((subtrahend.big == NULL) && (minuend.big == NULL) &&
+		!__builtin_sub_overflow(subtrahend.small, minuend.small, &diff->small))
+	{
+		diff->big = NULL;
+		return CALC_OK;
+	}
+	return bignum_addsub(subtrahend, minuend, REF_ACTIVATE, diff);
+# elif defined(CALC_MODE_DOUBLE)
+	*diff = subtrahend - minuend;
+	return isfinite(*diff)? CALC_OK : CALC_EOVERFLOW;
+# else
+	return __builtin_sub_overflow(subtrahend, minuend, diff)? CALC_EOVERFLOW : CALC_OK;
+# endif
+} //end uint8_t op_sub()
@@ -1,21 +1,27 @@
 # include "../src/claytor.h"
 
-char *get_input(char *dest_array, int n)
+ssize_t get_input(char **line, size_t *cap)
 {
-	/* This function exists as a wrapper to fgets(): setting the input buffer to
-	 * stdin automatically and also parsing out the newline terminator that is
-	 * read in by fgets after the stream from stdin has ended. If for whatever
-	 * reason stdin is inaccessible, it will report an error and exit outright.
+	/* This function exists as a wrapper to getline(): reading a whole line
+	 * from stdin however long it is, into *line (which holds *cap characters
+	 * and is grown as needed, or allocated if it is NULL), and also parsing
+	 * out the newline terminator that is read in along with it. The length
+	 * of the line is returned. Once stdin has no more input -1 is returned,
+	 * so that a script piping expressions in ends the session just like "q"
+	 * does; if for whatever reason stdin is inaccessible (or the line
+	 * couldn't be allocated), it will also report an error.
 	 */
 	setbuf(stdin, NULL);
-	if (fgets(dest_array, n, stdin))
+	errno = 0;
+	ssize_t len = getline(line, cap, stdin);
+	if (len < 0)
 	{
-		dest_array[strcspn(dest_array, "\n")] = 0;
-		return dest_array;
+		if (ferror(stdin) || (errno == ENOMEM)) fprintf(stderr, "get_input(): Error reading from stdin.\n");
+		return -1;
 	}
-	else
+	if ((len > 0) && ((*line)[len - 1] == '\n'))
 	{
-		fprintf(stderr, "get_input(): Error reading from stdin.\n");
-		exit(EXIT_FAILURE);
+		(*line)[--len] = 0;
 	}
-} //end char *get_input()
+	return len;
+} //end ssize_t get_input()
@@ -0,0 +1,108 @@
+# include "../src/claytor.h"
+
+static uint8_t find_op(const char *reader, size_t length, uint8_t notation, size_t *matched)
+{
+	/* Looks an operator up in the registry by how it is written: for a
+	 * function, the name that is exactly length characters long; for an
+	 * operator symbol, the longest one the source continues with, so "<<" is
+	 * a shift rather than two comparisons. Returns the opcode, or 0 (which is
+	 * no operator's) if nothing matches.
+	 */
+	uint8_t found = REF_INACTIVE;
+	size_t found_len = REF_INACTIVE;
+	const char first = reader[0];
+	for (uint8_t opcode = 0; opcode < OP_COUNT; opcode++)
+	{
+		const char *symbol = calc_ops[opcode].symbol;
+		if ((symbol[0] != first) || (calc_ops[opcode].notation != notation)) continue;	//no entry has an empty symbol
+		size_t symbol_len = 1;
+		while ((symbol[symbol_len] != 0) && (symbol[symbol_len] == reader[symbol_len])) symbol_len++;
+		if ((symbol[symbol_len] == 0) && (symbol_len > found_len) &&
+			((notation != NOTATION_CALL) || (symbol_len == length)))
+		{
+			found = opcode;
+			found_len = symbol_len;
+		}
+	}
+	*matched = found_len;
+	return found;
+}
+
+uint8_t lex_next(const char *src_array, size_t *offset, uint8_t prev_kind, calc_token_t *token)
+{
+	/* This function reads the next token of an expression, starting at
+	 * src_array[*offset], and moves *offset past it. Tokens are slices of the
+	 * source: the source is only ever read, never trimmed, copied or
+	 * terminated, and since positions are kept as size_t the input can be as
+	 * long as memory allows. Spaces between tokens are skipped. Numbers are
+	 * converted by value_parse() straight out of the source, which stops on its
+	 * own at the first character that isn't part of the number (in double
+	 * mode that includes fractions and exponents such as "1.5e-3".) Operators
+	 * and functions are looked up in the operator registry, calc_ops[], so a
+	 * new one is lexed without any change here, and the token's value is its
+	 * opcode. Whether a '-' is a binary minus or a unary one depends on the
+	 * token before it, prev_kind: at the very start of the input (TOKEN_END),
+	 * after an operator or after a left parenthesis there's no left operand,
+	 * so only prefix operators are looked for there and only binary ones
+	 * anywhere else. Once the input is exhausted a TOKEN_END token is returned.
+	 * CALC_ESYNTAX is returned for a character that doesn't start any token,
+	 * or the error of value_parse() for a number that doesn't fit.
+	 */
+	while (isspace((unsigned char)src_array[*offset])) (*offset)++;
+	const char *reader = src_array + *offset;
+	token->offset = *offset;
+	token->length = 1;
+	token->value = VALUE_INT(*reader);
+	uint8_t status = CALC_OK;
+	if (*reader == 0)
+	{
+		token->kind = TOKEN_END;
+		token->length = 0;
+		return CALC_OK;
+	}
+# if defined(CALC_MODE_DOUBLE) || defined(CALC_MODE_RATIONAL)
+	if (isdigit((unsigned char)*reader) || ((*reader == '.') && isdigit((unsigned char)reader[1])))
+# else
+	if (isdigit((unsigned char)*reader))
+# endif
+	{
+		char *number_end = NULL;
+		token->kind = TOKEN_NUMBER;
+		status = value_parse(reader, &number_end, &token->value);
+		token->length = number_end - reader;
+	}
+	else if (islower((unsigned char)*reader))
+	{
+		while (islower((unsigned char)reader[token->length])) token->length++;
+		token->kind = (token->length == 1)? TOKEN_VARIABLE : TOKEN_FUNCTION;
+		token->value = VALUE_INT(*reader - 'a');
+		if (token->kind == TOKEN_FUNCTION)
+		{
+			size_t matched = REF_INACTIVE;
+			token->value = VALUE_INT(find_op(reader, token->length, NOTATION_CALL, &matched));
+			status = (matched != 0)? CALC_OK : CALC_ESYNTAX;
+		}
+	}
+	else
+	{
+		switch (*reader)
+		{
+			case 0x28: token->kind = TOKEN_LPAREN; break;	//'('
+			case 0x29: token->kind = TOKEN_RPAREN; break;	//')'
+			case 0x2C: token->kind = TOKEN_COMMA; break;	//','
+			default:
+			{
+				uint8_t prefix = (prev_kind == TOKEN_END) || (prev_kind == TOKEN_OPERATOR) ||
+					(prev_kind == TOKEN_PREFIX) || (prev_kind == TOKEN_LPAREN) || (prev_kind == TOKEN_COMMA);
+				size_t matched = REF_INACTIVE;
+				token->kind = (prefix)? TOKEN_PREFIX : TOKEN_OPERATOR;
+				token->value = VALUE_INT(find_op(reader, 0, (prefix)? NOTATION_PREFIX : NOTATION_INFIX, &matched));
+				token->length = (matched != 0)? matched : 1;
+				status = (matched != 0)? CALC_OK : CALC_ESYNTAX;
+				break;
+			}
+		}
+	} //end else (not a number, a variable or a function)
+	*offset += token->length;
+	return status;
+} //end uint8_t lex_next()
@@ -0,0 +1,100 @@
+# include "../src/claytor.h"
+
+void parse_args(int argc, char **argv)
+{
+	/* This function parses any arguments passed to the program during launch
+	 * into claytor_opts_g. The flags supported are "-b" to evaluate a file of
+	 * expressions in batch mode (one expression per line, "-" reads them from
+	 * stdin), "-t" to set the number of batch worker threads, "-c", "-e" and
+	 * "-o" to evaluate one expression over every row of a file in column mode
+	 * (its input, expression and output respectively), "-J" to evaluate that
+	 * expression through native code, "-m" to set how many expressions the
+	 * interactive cache remembers, "-s" to serve expressions over a Unix
+	 * domain socket and "-h" to print the usage section. Every
+	 * flag is expected to be given separately, and the flags that take a
+	 * value expect it as the very next argument. If an argument can't be
+	 * understood the usage section is printed, which exits the program.
+	 */
+	for (int argv_x = 1; argv_x < argc; argv_x++)
+	{
+		if ((argv[argv_x][0] != '-') || (strlen(argv[argv_x]) != 2))
+		{
+			fprintf(stderr, "parse_args(): unrecognised argument \"%s\".\n", argv[argv_x]);
+			usage();
+		}
+		switch (argv[argv_x][1])
+		{
+			case 0x62:	//"-b", batch mode
+			{
+				if (argv_x + 1 >= argc)
+				{
+					fprintf(stderr, "parse_args(): \"-b\" requires a file (or \"-\").\n");
+					usage();
+				}
+				claytor_opts_g.batch_path = argv[++argv_x];
+				break;
+			}
+			case 0x63:	//"-c", column mode input
+			case 0x65:	//"-e", column mode expression
+			case 0x6F:	//"-o", column mode output
+			{
+				if (argv_x + 1 >= argc)
+				{
+					fprintf(stderr, "parse_args(): \"%s\" requires an argument.\n", argv[argv_x]);
+					usage();
+				}
+				char **dest = (argv[argv_x][1] == 0x63)? &claytor_opts_g.column_path :
+					(argv[argv_x][1] == 0x65)? &claytor_opts_g.column_expr : &claytor_opts_g.output_path;
+				*dest = argv[++argv_x];
+				break;
+			}
+			case 0x73:	//"-s", server mode
+			{
+				if (argv_x + 1 >= argc)
+				{
+					fprintf(stderr, "parse_args(): \"-s\" requires a socket path.\n");
+					usage();
+				}
+				claytor_opts_g.socket_path = argv[++argv_x];
+				break;
+			}
+			case 0x74:	//"-t", batch worker threads
+			{
+				long threads = (argv_x + 1 < argc)? strtol(argv[++argv_x], NULL, BASE) : 0;
+				if ((threads < 1) || (threads > BATCH_THREADS))
+				{
+					fprintf(stderr, "parse_args(): \"-t\" expects 1 to %d threads.\n", BATCH_THREADS);
+					usage();
+				}
+				claytor_opts_g.u_threads = threads;
+				break;
+			}
+			case 0x6D:	//"-m", interactive cache size
+			{
+				long entries = (argv_x + 1 < argc)? strtol(argv[++argv_x], NULL, BASE) : -1;
+				if ((entries < 0) || (entries > CACHE_MAX))
+				{
+					fprintf(stderr, "parse_args(): \"-m\" expects 0 to %u cached expressions.\n", CACHE_MAX);
+					usage();
+				}
+				claytor_opts_g.u_cache = entries;
+				break;
+			}
+			case 0x4A:	//"-J", column mode through native code
+			{
+				claytor_opts_g.u_jit = REF_ACTIVATE;
+				break;
+			}
+			case 0x68:	//"-h", help
+			{
+				usage();
+				break;
+			}
+			default:
+			{
+				fprintf(stderr, "parse_args(): unrecognised argument \"%s\".\n", argv[argv_x]);
+				usage();
+			}
+		} //end switch (argv[argv_x][1])
+	} //end for-loop parsing argv_x
+} //end void parse_args()
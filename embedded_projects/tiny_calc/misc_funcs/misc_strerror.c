@@ -0,0 +1,20 @@
+# include "../src/claytor.h"
+
+const char *calc_strerror(uint8_t status)
+{
+	/* This function maps a status returned by the math functions onto a short
+	 * human-readable description, like strerror() does for errno values.
+	 */
+	switch (status)
+	{
+		case CALC_OK:			return "ok";
+		case CALC_EOVERFLOW:	return "overflow";
+		case CALC_EDIVZERO:		return "division by zero";
+		case CALC_ENOMEM:		return "out of memory";
+		case CALC_ESYNTAX:		return "malformed expression";
+		case CALC_EUNBOUND:		return "unbound variable";
+		case CALC_EDOMAIN:		return "domain error";
+		case CALC_ECYCLE:		return "circular reference";
+		default:				return "unknown error";
+	}
+} //end const char *calc_strerror()
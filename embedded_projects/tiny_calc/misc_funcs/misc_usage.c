@@ -0,0 +1,30 @@
+# include "../src/claytor.h"
+
+void usage(void)
+{
+	printf("claytor CLA usage:\n");
+	printf("\"-b\" [filename.ext]: evaluate every line of a file as an expression.\n");
+	printf("\tUse \"-\" to read the expressions from stdin instead.\n");
+	printf("\tIf unused, the program will launch interactively.\n");
+	printf("\"-t\" [threads]: number of batch worker threads (default: online cores.)\n");
+	printf("\"-c\" [filename.csv|filename.bin]: evaluate the expression given by \"-e\" over every row of a file.\n");
+	printf("\tCSV files start with a header naming their columns \"a\" to \"z\"; binary files\n");
+	printf("\thold rows of native numbers, bound to the variables \"a\", \"b\", ... in order.\n");
+	printf("\"-e\" [expression]: the column mode expression, with variables \"a\" to \"z\".\n");
+	printf("\"-o\" [filename.csv|filename.bin]: where to write column mode results (default: stdout.)\n");
+	printf("\"-J\": translate the column mode expression into native x86-64 code (INT64 mode only.)\n");
+	printf("\"-m\" [entries]: number of expressions the interactive mode caches (default: %d, 0 disables the cache.)\n", CACHE_SIZE);
+	printf("\"-s\" [socket path]: serve expressions to clients over a Unix domain socket, one per line.\n");
+	printf("\"-h\": print this help section.\n");
+	putchar('\n');
+	printf("[*] Expressions use +, -, *, /, %% (remainder) and ^ (exponentiation), parentheses and abs(), min(), max(), sqrt() and pow().\n");
+	printf("[*] Integers also have &, |, ~, << and >> and xor(); comparisons (<, <=, >, >=, ==, !=) are 1 or 0.\n");
+	printf("[*] In rational mode (make MODE=RATIONAL), results are exact fractions such as 1/3, and 0.1 is 1/10.\n");
+	printf("[*] Batch results are written to stdout in input order, one per line.\n");
+	printf("[*] Lines that fail to parse or evaluate produce \"error\" in place of a result.\n");
+	printf("[*] Column mode reports its throughput in rows per second on stderr.\n");
+	printf("[*] Server mode answers every line with a line formatted like batch output, stopping on SIGINT or SIGTERM.\n");
+	printf("[*] Interactively, \"c = a + b\" assigns c a formula; assigning a new one to a or b updates c.\n");
+	printf("[*] Interactive mode reports the hit rate of its cache on stderr when it exits.\n");
+	exit(EXIT_SUCCESS);
+} //end void usage()
@@ -0,0 +1,33 @@
+# include "../src/claytor.h"
+
+int value_format(calc_value_t value, char *dest_array, size_t size)
+{
+	/* This function formats a value of the compiled numeric mode into a char
+	 * array, returning the number of characters written like snprintf() does.
+	 * printf() has no conversion for 128 bit integers, so in INT128 mode the
+	 * digits are produced back to front into a scratch buffer (working with
+	 * the magnitude as unsigned so that the most negative value survives) and
+	 * then copied over with the sign. Bignums are formatted by bignum_format()
+	 * and fractions by rational_format().
+	 */
+# if defined(CALC_MODE_RATIONAL)
+	return rational_format(value, dest_array, size);
+# elif defined(CALC_MODE_BIGNUM)
+	return bignum_format(value, dest_array, size);
+# elif defined(CALC_MODE_INT128)
+	__extension__ unsigned __int128 magnitude = (value < 0)? -(unsigned __int128)value : (unsigned __int128)value;
+	char digits[RESULT_SIZE] = {REF_INACTIVE};
+	char *writer = digits + RESULT_SIZE - 1;
+	do
+	{
+		*--writer = '0' + (char)(magnitude % BASE);
+		magnitude /= BASE;
+	} while (magnitude != 0);
+	if (value < 0) *--writer = '-';
+	return snprintf(dest_array, size, "%s", writer);
+# elif defined(CALC_MODE_DOUBLE)
+	return snprintf(dest_array, size, "%.15g", value);
+# else
+	return snprintf(dest_array, size, "%lld", (long long)value);
+# endif
+} //end int value_format()
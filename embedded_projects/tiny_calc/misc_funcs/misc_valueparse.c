@@ -0,0 +1,43 @@
+# include "../src/claytor.h"
+
+uint8_t value_parse(const char *src_array, char **end_ptr, calc_value_t *value)
+{
+	/* This function converts the number at the start of src_array into the
+	 * numeric mode that was compiled in, much like strtol() does: end_ptr is
+	 * set to the first character that wasn't consumed. INT64 and DOUBLE modes
+	 * defer to strtoll() and strtod() and report ERANGE as an overflow. There
+	 * is no standard conversion for 128 bit integers, so in INT128 mode the
+	 * digits are accumulated one at a time through the checked builtins, and
+	 * bignum mode accumulates them into limbs through bignum_parse(). Rational
+	 * mode reads decimals as exact fractions through rational_parse().
+	 */
+# if defined(CALC_MODE_RATIONAL)
+	return rational_parse(src_array, end_ptr, value);
+# elif defined(CALC_MODE_BIGNUM)
+	return bignum_parse(src_array, end_ptr, value);
+# elif defined(CALC_MODE_INT128)
+	const char *reader = src_array;
+	calc_value_t accumulated = REF_INACTIVE;
+	uint8_t status = CALC_OK;
+	while (isdigit((unsigned char)*reader))
+	{
+		if (__builtin_mul_overflow(accumulated, BASE, &accumulated) ||
+			__builtin_add_overflow(accumulated, *reader - '0', &accumulated))
+		{
+			status = CALC_EOVERFLOW;
+		}
+		reader++;
+	}
+	*end_ptr = (char *)reader;
+	*value = accumulated;
+	return status;
+# else
+	errno = REF_INACTIVE;
+#  if defined(CALC_MODE_DOUBLE)
+	*value = strtod(src_array, end_ptr);
+#  else
+	*value = strtoll(src_array, end_ptr, BASE);
+#  endif
+	return (errno == ERANGE)? CALC_EOVERFLOW : CALC_OK;
+# endif
+} //end uint8_t value_parse()
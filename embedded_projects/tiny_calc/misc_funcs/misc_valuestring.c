@@ -0,0 +1,28 @@
+# include "../src/claytor.h"
+
+char *value_string(calc_value_t value, char *scratch, size_t size)
+{
+	/* This function formats a value for printing. Almost every value fits into
+	 * the caller's scratch buffer, which is then what gets returned. Bignums
+	 * can run to thousands of digits though, so if value_format() reports that
+	 * it needed more room, a buffer of exactly the right size is allocated and
+	 * returned instead; the caller has to free() whatever comes back if it
+	 * isn't scratch. NULL is returned if the value couldn't be formatted.
+	 */
+	int written = value_format(value, scratch, size);
+	if (written < 0)
+	{
+		return NULL;
+	}
+	if ((size_t)written < size)
+	{
+		return scratch;
+	}
+	char *text = malloc((size_t)written + 1);
+	if (text == NULL)
+	{
+		return NULL;
+	}
+	value_format(value, text, (size_t)written + 1);
+	return text;
+} //end char *value_string()
@@ -0,0 +1,57 @@
+# include "../src/claytor.h"
+
+uint8_t prog_compile(const calc_ast_t *ast, calc_prog_t *prog)
+{
+	/* This function compiles an AST (ideally folded by ast_fold() first)
+	 * into a program that can be evaluated any number of times by
+	 * prog_eval(), translated by jit_compile() or run over blocks of rows by
+	 * col_eval(). The arena of an AST already is the expression in POSTFIX
+	 * order, so compiling is a single pass that turns every live node into
+	 * one instruction: numbers into INSTR_PUSH (the program gets a copy of
+	 * its own), variables into INSTR_VAR and operators into their opcode.
+	 * The AST is left as it was. The deepest the operand stack gets is worked
+	 * out along the way: every push adds an operand, and every operator takes
+	 * its operands off and puts one back.
+	 */
+	prog->code = malloc(((size_t)ast->len + 1) * sizeof(calc_instr_t));
+	prog->len = REF_INACTIVE;
+	prog->depth = REF_INACTIVE;
+	if (prog->code == NULL)
+	{
+		return CALC_ENOMEM;
+	}
+	uint8_t status = (ast->len > 0)? CALC_OK : CALC_ESYNTAX;
+	uint32_t depth = REF_INACTIVE;
+	for (uint32_t index = 0; (index < ast->len) && (status == CALC_OK); index++)
+	{
+		const calc_node_t *node = &ast->nodes[index];
+		calc_instr_t *instr = &prog->code[prog->len];
+		instr->value = VALUE_INT(REF_INACTIVE);
+		switch (node->kind)
+		{
+			case NODE_NUMBER:
+			{
+				instr->opcode = INSTR_PUSH;
+				status = value_copy(node->value, &instr->value);
+				break;
+			}
+			case NODE_VARIABLE:
+			{
+				instr->opcode = INSTR_VAR;
+				instr->value = node->value;
+				break;
+			}
+			case NODE_OP: instr->opcode = node->opcode; break;
+			default: continue;	//folded away
+		}
+		if (status != CALC_OK) break;
+		prog->len++;
+		depth += INSTR_OPERAND(instr->opcode)? 1 : 1 - OP_ARITY(instr->opcode);
+		if (depth > prog->depth) prog->depth = depth;
+	} //end for-loop over nodes
+	if (status != CALC_OK)
+	{
+		prog_free(prog);
+	}
+	return status;
+} //end uint8_t prog_compile()
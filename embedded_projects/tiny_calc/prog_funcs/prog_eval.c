@@ -0,0 +1,96 @@
+# include "../src/claytor.h"
+
+uint8_t prog_eval(const calc_prog_t *prog, const calc_value_t *vars, calc_value_t *result)
+{
+	/* This function evaluates a compiled expression. Being in POSTFIX order,
+	 * that is a single pass over the instructions: constants are pushed onto
+	 * an operand stack and operators replace the operands they take (one or
+	 * two, see OP_ARITY()) with their result, so once the pass is done the
+	 * one operand left is the result. The stack lives in a local array unless
+	 * the program is unusually deep, so evaluation normally doesn't allocate
+	 * at all. The program itself is not modified and can be evaluated again.
+	 * Variables take their values from vars, indexed 0 for 'a' to 25 for 'z';
+	 * if vars is NULL (as it is interactively) a program that uses one fails
+	 * with CALC_EUNBOUND. Constants and variables are only borrowed, so in
+	 * bignum mode the owned flags keep track of which operands are
+	 * intermediate results that have to be released once an op consumes them
+	 * (the compiler drops all of this in the other modes.)
+	 */
+	calc_value_t local_stack[PROG_STACK];
+	uint8_t local_owned[PROG_STACK];
+	calc_value_t *stack = local_stack;
+	uint8_t *owned = local_owned;
+	if (prog->depth > PROG_STACK)
+	{
+		stack = malloc((size_t)prog->depth * sizeof(calc_value_t));
+		owned = malloc(prog->depth);
+		if ((stack == NULL) || (owned == NULL))
+		{
+			free(stack);
+			free(owned);
+			return CALC_ENOMEM;
+		}
+	}
+
+	uint32_t top = REF_INACTIVE;	//number of operands on the stack
+	uint8_t status = CALC_OK;
+	for (uint32_t index = 0; (index < prog->len) && (status == CALC_OK); index++)
+	{
+		const calc_instr_t *instr = &prog->code[index];
+		if (instr->opcode == INSTR_PUSH)
+		{
+			stack[top] = instr->value;
+			owned[top++] = REF_INACTIVE;
+			continue;
+		}
+		if (instr->opcode == INSTR_VAR)
+		{
+			if (vars == NULL)
+			{
+				status = CALC_EUNBOUND;
+				continue;
+			}
+			stack[top] = vars[VALUE_AS_INT(instr->value)];
+			owned[top++] = REF_INACTIVE;
+			continue;
+		}
+		uint8_t arity = OP_ARITY(instr->opcode);
+		calc_value_t op_result = VALUE_INT(REF_INACTIVE);
+		calc_value_t *operand_1 = &stack[top - arity];
+		calc_value_t *operand_2 = &stack[top - 1];	//the same as operand_1 for unary ops
+		status = op_apply(instr->opcode, *operand_1, (arity == 2)? *operand_2 : VALUE_INT(REF_INACTIVE), &op_result);
+		if (VALUE_OWNS_MEMORY)
+		{
+			if ((arity == 2) && owned[top - 1]) value_release(operand_2);
+			if (owned[top - arity]) value_release(operand_1);
+		}
+		top -= arity - 1;
+		stack[top - 1] = op_result;
+		owned[top - 1] = (status == CALC_OK);
+	} //end for-loop over instructions
+
+	if ((status == CALC_OK) && (top != 1))
+	{
+		status = CALC_ESYNTAX;
+	}
+	if (status == CALC_OK)
+	{
+		/* Hand the result over to the caller. If the whole program was just a
+		 * constant or a variable, the result is still borrowed, so it is copied.
+		 */
+		status = (owned[0])? (*result = stack[0], CALC_OK) : value_copy(stack[0], result);
+	}
+	else if (VALUE_OWNS_MEMORY)
+	{
+		for (uint32_t index = 0; index < top; index++)
+		{
+			if (owned[index]) value_release(&stack[index]);
+		}
+	}
+	if (stack != local_stack)
+	{
+		free(stack);
+		free(owned);
+	}
+	return status;
+} //end uint8_t prog_eval()
@@ -0,0 +1,17 @@
+# include "../src/claytor.h"
+
+void prog_free(calc_prog_t *prog)
+{
+	/* This function releases a compiled expression: the constants it owns and
+	 * then its instructions. The program is left empty, so freeing it twice
+	 * is harmless.
+	 */
+	for (uint32_t index = 0; index < prog->len; index++)
+	{
+		if (prog->code[index].opcode == INSTR_PUSH) value_release(&prog->code[index].value);
+	}
+	free(prog->code);
+	prog->code = NULL;
+	prog->len = REF_INACTIVE;
+	prog->depth = REF_INACTIVE;
+} //end void prog_free()
@@ -0,0 +1,17 @@
+# include "../src/claytor.h"
+
+uint32_t prog_reads(const calc_prog_t *prog)
+{
+	/* This function returns the set of variables a compiled expression
+	 * reads, one bit per variable (see VAR_BIT()), so 0 for an expression
+	 * whose value never changes. The sheet keeps track of which formulas
+	 * depend on which through it, and the interactive cache only remembers
+	 * expressions that read nothing.
+	 */
+	uint32_t reads = REF_INACTIVE;
+	for (uint32_t index = 0; index < prog->len; index++)
+	{
+		if (prog->code[index].opcode == INSTR_VAR) reads |= VAR_BIT(VALUE_AS_INT(prog->code[index].value));
+	}
+	return reads;
+} //end uint32_t prog_reads()
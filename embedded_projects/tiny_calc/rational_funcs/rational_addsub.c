@@ -0,0 +1,61 @@
+# include "../src/claytor.h"
+
+uint8_t rational_addsub(calc_value_t augend, calc_value_t addend, uint8_t negate_addend, calc_value_t *sum)
+{
+	/* This function adds two fractions, or subtracts the addend if
+	 * negate_addend is set: a/b + c/d is (a*d + c*b) / (b*d), reduced by
+	 * rational_make(). Fractions over the same denominator (integers above
+	 * all) just add their numerators, and since that sum shares no factor
+	 * with a denominator of 1, integer results need no reduction at all.
+	 * As long as every part fits into 64 bits and no product or sum
+	 * overflows, everything is computed through the checked builtins, as in
+	 * INT64 mode; the first overflow promotes the whole computation to
+	 * bignums.
+	 */
+	if ((augend.num.big == NULL) && (augend.den.big == NULL) && (addend.num.big == NULL) && (addend.den.big == NULL))
+	{
+		int64_t num = REF_INACTIVE;
+		int64_t den = augend.den.small;
+		uint8_t overflow = REF_INACTIVE;
+		if (augend.den.small == addend.den.small)
+		{
+			overflow = (negate_addend)? __builtin_sub_overflow(augend.num.small, addend.num.small, &num) :
+				__builtin_add_overflow(augend.num.small, addend.num.small, &num);
+			if (!overflow && (den == 1))
+			{
+				*sum = VALUE_INT(num);
+				return CALC_OK;
+			}
+		}
+		else
+		{
+			int64_t cross_1 = REF_INACTIVE;
+			int64_t cross_2 = REF_INACTIVE;
+			overflow = __builtin_mul_overflow(augend.num.small, addend.den.small, &cross_1) ||
+				__builtin_mul_overflow(addend.num.small, augend.den.small, &cross_2) ||
+				__builtin_mul_overflow(augend.den.small, addend.den.small, &den) ||
+				((negate_addend)? __builtin_sub_overflow(cross_1, cross_2, &num) : __builtin_add_overflow(cross_1, cross_2, &num));
+		}
+		if (!overflow)
+		{
+			return rational_make(INTEGER_INT(num), INTEGER_INT(den), sum);
+		}
+	}
+	calc_integer_t cross_1 = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t cross_2 = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t num = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t den = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_mul(augend.num, addend.den, &cross_1);
+	if (status == CALC_OK) status = bignum_mul(addend.num, augend.den, &cross_2);
+	if (status == CALC_OK) status = bignum_addsub(cross_1, cross_2, negate_addend, &num);
+	if (status == CALC_OK) status = bignum_mul(augend.den, addend.den, &den);
+	bignum_release(&cross_1);
+	bignum_release(&cross_2);
+	if (status != CALC_OK)
+	{
+		bignum_release(&num);
+		bignum_release(&den);
+		return status;
+	}
+	return rational_make(num, den, sum);
+} //end uint8_t rational_addsub()
@@ -0,0 +1,24 @@
+# include "../src/claytor.h"
+
+uint8_t value_copy(calc_value_t src, calc_value_t *dest)
+{
+	/* This function makes an independent copy of a rational value, so that
+	 * both the source and the copy can be released separately. A fraction
+	 * whose parts are both small is simply assigned.
+	 */
+	if ((src.num.big == NULL) && (src.den.big == NULL))
+	{
+		*dest = src;
+		return CALC_OK;
+	}
+	calc_value_t copy = VALUE_INT(REF_INACTIVE);
+	uint8_t status = bignum_copy(src.num, &copy.num);
+	if (status == CALC_OK) status = bignum_copy(src.den, &copy.den);
+	if (status != CALC_OK)
+	{
+		value_release(&copy);
+		return status;
+	}
+	*dest = copy;
+	return CALC_OK;
+} //end uint8_t value_copy()
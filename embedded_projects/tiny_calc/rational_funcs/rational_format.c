@@ -0,0 +1,30 @@
+# include "../src/claytor.h"
+
+int rational_format(calc_value_t value, char *dest_array, size_t size)
+{
+	/* This function is value_format() for rational mode: integers are
+	 * formatted as they are in bignum mode, and anything else as its
+	 * fraction in lowest terms, such as "-5/4". Like snprintf(), it returns
+	 * the full length of the text even if only part of it fit into
+	 * dest_array, and -1 if bignum_format() failed.
+	 */
+	int num_len = bignum_format(value.num, dest_array, size);
+	if ((num_len < 0) || INTEGER_IS(value.den, 1))
+	{
+		return num_len;
+	}
+	size_t used = (size == 0)? 0 : (((size_t)num_len < size - 1)? (size_t)num_len : size - 1);
+	char *writer = dest_array + used;
+	size_t room = size - used;
+	if (room > 1)
+	{
+		*writer++ = 0x2F;	//'/'
+		room--;
+	}
+	int den_len = bignum_format(value.den, writer, room);
+	if (den_len < 0)
+	{
+		return den_len;
+	}
+	return num_len + 1 + den_len;
+} //end int rational_format()
@@ -0,0 +1,31 @@
+# include "../src/claytor.h"
+
+uint64_t rational_gcd(uint64_t magnitude_1, uint64_t magnitude_2)
+{
+	/* This function computes the greatest common divisor of two 64 bit
+	 * magnitudes, which is what keeps every fraction whose parts fit into
+	 * 64 bits in lowest terms. It is Stein's binary GCD: the powers of two
+	 * both share are set aside, and then the smaller odd magnitude is
+	 * repeatedly subtracted from the larger one and the result stripped of
+	 * its trailing zero bits, all with shifts, subtractions and
+	 * count-trailing-zeros instructions rather than divisions.
+	 */
+	if ((magnitude_1 == 0) || (magnitude_2 == 0))
+	{
+		return magnitude_1 | magnitude_2;
+	}
+	int shared = __builtin_ctzll(magnitude_1 | magnitude_2);
+	magnitude_1 >>= __builtin_ctzll(magnitude_1);
+	do
+	{
+		magnitude_2 >>= __builtin_ctzll(magnitude_2);
+		if (magnitude_1 > magnitude_2)
+		{
+			uint64_t swap = magnitude_1;
+			magnitude_1 = magnitude_2;
+			magnitude_2 = swap;
+		}
+		magnitude_2 -= magnitude_1;
+	} while (magnitude_2 != 0);
+	return magnitude_1 << shared;
+} //end uint64_t rational_gcd()
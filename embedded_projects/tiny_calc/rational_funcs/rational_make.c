@@ -0,0 +1,49 @@
+# include "../src/claytor.h"
+
+uint8_t rational_make(calc_integer_t num, calc_integer_t den, calc_value_t *value)
+{
+	/* This function turns a numerator and a denominator into a value, taking
+	 * ownership of both: the fraction is reduced to lowest terms by their
+	 * greatest common divisor and its sign is moved into the numerator. A
+	 * zero denominator is reported as a division by zero. Parts that fit
+	 * into 64 bits are reduced natively through rational_gcd(), and only big
+	 * ones (or the most negative 64 bit integer, whose magnitude doesn't fit)
+	 * go through bignum_gcd() and bignum_divmod().
+	 */
+	if (INTEGER_IS(den, 0))
+	{
+		bignum_release(&num);
+		return CALC_EDIVZERO;
+	}
+	if ((num.big == NULL) && (den.big == NULL) && (num.small != INT64_MIN) && (den.small != INT64_MIN))
+	{
+		int64_t gcd = (int64_t)rational_gcd((num.small < 0)? -num.small : num.small, (den.small < 0)? -den.small : den.small);
+		int64_t sign = (den.small < 0)? -1 : 1;
+		*value = (calc_value_t){INTEGER_INT(sign * (num.small / gcd)), INTEGER_INT(sign * (den.small / gcd))};
+		return CALC_OK;
+	}
+	calc_integer_t gcd = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t reduced_num = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t reduced_den = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_gcd(num, den, &gcd);
+	if (INTEGER_NEGATIVE(den) && (status == CALC_OK))
+	{
+		calc_integer_t negated = INTEGER_INT(REF_INACTIVE);
+		status = bignum_addsub(INTEGER_INT(REF_INACTIVE), gcd, REF_ACTIVATE, &negated);
+		bignum_release(&gcd);
+		gcd = negated;	//dividing by -gcd makes the denominator positive
+	}
+	if (status == CALC_OK) status = bignum_divmod(num, gcd, &reduced_num, NULL);
+	if (status == CALC_OK) status = bignum_divmod(den, gcd, &reduced_den, NULL);
+	bignum_release(&gcd);
+	bignum_release(&num);
+	bignum_release(&den);
+	if (status != CALC_OK)
+	{
+		bignum_release(&reduced_num);
+		bignum_release(&reduced_den);
+		return status;
+	}
+	*value = (calc_value_t){reduced_num, reduced_den};
+	return CALC_OK;
+} //end uint8_t rational_make()
@@ -0,0 +1,50 @@
+# include "../src/claytor.h"
+
+uint8_t rational_muldiv(calc_value_t multiplicand, calc_value_t multiplier, uint8_t invert_multiplier, calc_value_t *prod)
+{
+	/* This function multiplies two fractions, or divides by the multiplier
+	 * if invert_multiplier is set (a/b / (c/d) is a/b * d/c, and dividing by
+	 * 0 is reported as a division by zero.) Both fractions are in lowest
+	 * terms, so the only factors the product can be reduced by are those
+	 * a numerator shares with the other fraction's denominator: cancelling
+	 * them first (a/b * c/d is (a/g1 * c/g2) / (b/g2 * d/g1), g1 = gcd(a, d)
+	 * and g2 = gcd(c, b)) keeps the products small and leaves a result that
+	 * is already in lowest terms. That's done natively as long as every part
+	 * fits into 64 bits and no product overflows, and through bignums (with
+	 * a reduction by rational_make() at the end) from then on.
+	 */
+	calc_integer_t num = (invert_multiplier)? multiplier.den : multiplier.num;
+	calc_integer_t den = (invert_multiplier)? multiplier.num : multiplier.den;
+	if (INTEGER_IS(den, 0))
+	{
+		return CALC_EDIVZERO;
+	}
+	if ((multiplicand.num.big == NULL) && (multiplicand.den.big == NULL) && (num.big == NULL) && (den.big == NULL) &&
+		(multiplicand.num.small != INT64_MIN) && (num.small != INT64_MIN) && (den.small != INT64_MIN))
+	{
+		int64_t gcd_1 = (int64_t)rational_gcd((multiplicand.num.small < 0)? -multiplicand.num.small : multiplicand.num.small,
+			(den.small < 0)? -den.small : den.small);
+		int64_t gcd_2 = (int64_t)rational_gcd((num.small < 0)? -num.small : num.small, multiplicand.den.small);
+		int64_t sign = (den.small < 0)? -1 : 1;	//only a divisor's numerator can be negative
+		//neither GCD can be 0, since den and multiplicand.den aren't
+		int64_t prod_num = REF_INACTIVE;
+		int64_t prod_den = REF_INACTIVE;
+		if (!__builtin_mul_overflow(multiplicand.num.small / gcd_1, sign * (num.small / gcd_2), &prod_num) &&
+			!__builtin_mul_overflow(multiplicand.den.small / gcd_2, sign * (den.small / gcd_1), &prod_den))
+		{
+			*prod = (calc_value_t){INTEGER_INT(prod_num), INTEGER_INT(prod_den)};
+			return CALC_OK;
+		}
+	}
+	calc_integer_t prod_num = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t prod_den = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_mul(multiplicand.num, num, &prod_num);
+	if (status == CALC_OK) status = bignum_mul(multiplicand.den, den, &prod_den);
+	if (status != CALC_OK)
+	{
+		bignum_release(&prod_num);
+		bignum_release(&prod_den);
+		return status;
+	}
+	return rational_make(prod_num, prod_den, prod);
+} //end uint8_t rational_muldiv()
@@ -0,0 +1,48 @@
+# include "../src/claytor.h"
+
+uint8_t rational_parse(const char *src_array, char **end_ptr, calc_value_t *value)
+{
+	/* This function is value_parse() for rational mode. Integers are read by
+	 * bignum_parse(), and so is the fraction of a number with a decimal
+	 * point, which is exact in this mode: 1.25 is 125/100, that is 5/4, and
+	 * 0.1 is exactly 1/10, which no binary floating point number is. A
+	 * number can start with its decimal point (.5) but not end with it, as
+	 * in double mode.
+	 */
+	calc_integer_t whole = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_parse(src_array, end_ptr, &whole);
+	if ((status != CALC_OK) || (**end_ptr != 0x2E) || !isdigit((unsigned char)(*end_ptr)[1]))	//'.'
+	{
+		*value = (calc_value_t){whole, INTEGER_INT(1)};
+		return status;
+	}
+	const char *digits = *end_ptr + 1;
+	calc_integer_t fraction = INTEGER_INT(REF_INACTIVE);
+	calc_value_t scale = VALUE_INT(REF_INACTIVE);
+	calc_integer_t shifted = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t num = INTEGER_INT(REF_INACTIVE);
+	status = bignum_parse(digits, end_ptr, &fraction);
+	if (status == CALC_OK) status = op_pow(VALUE_INT(BASE), VALUE_INT(*end_ptr - digits), &scale);
+	int64_t small = REF_INACTIVE;
+	if ((status == CALC_OK) && (whole.big == NULL) && (fraction.big == NULL) && (scale.num.big == NULL)
+		&& !__builtin_mul_overflow(whole.small, scale.num.small, &small)
+		&& !__builtin_add_overflow(small, fraction.small, &small))
+	{
+		num = INTEGER_INT(small);	//the usual short decimals never allocate
+	}
+	else if (status == CALC_OK)
+	{
+		status = bignum_mul(whole, scale.num, &shifted);
+		if (status == CALC_OK) status = bignum_addsub(shifted, fraction, REF_INACTIVE, &num);
+	}
+	bignum_release(&whole);
+	bignum_release(&fraction);
+	bignum_release(&shifted);
+	if (status != CALC_OK)
+	{
+		value_release(&scale);
+		bignum_release(&num);
+		return status;
+	}
+	return rational_make(num, scale.num, value);
+} //end uint8_t rational_parse()
@@ -0,0 +1,11 @@
+# include "../src/claytor.h"
+
+void value_release(calc_value_t *value)
+{
+	/* This function frees the bignums owned by a rational value, if it has
+	 * any, and leaves the value as 0 (that is 0/1.)
+	 */
+	bignum_release(&value->num);
+	bignum_release(&value->den);
+	value->den.small = 1;
+} //end void value_release()
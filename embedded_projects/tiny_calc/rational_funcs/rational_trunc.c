@@ -0,0 +1,40 @@
+# include "../src/claytor.h"
+
+uint8_t rational_trunc(calc_value_t value, uint8_t round_down, calc_value_t *integer)
+{
+	/* This function rounds a fraction to an integer: towards zero, as the
+	 * integer modes divide, or down if round_down is set (-7/2 is -3 or -4.)
+	 * Integers are simply copied. The quotient of the numerator by the
+	 * denominator is computed natively if both fit into 64 bits, and by
+	 * bignum_divmod() otherwise.
+	 */
+	if (INTEGER_IS(value.den, 1))
+	{
+		return value_copy(value, integer);
+	}
+	if ((value.num.big == NULL) && (value.den.big == NULL))
+	{
+		int64_t quotient = value.num.small / value.den.small;	//the denominator is at least 2
+		if (round_down && (value.num.small < 0) && (quotient * value.den.small != value.num.small)) quotient--;
+		*integer = VALUE_INT(quotient);
+		return CALC_OK;
+	}
+	calc_integer_t quotient = INTEGER_INT(REF_INACTIVE);
+	calc_integer_t remainder = INTEGER_INT(REF_INACTIVE);
+	uint8_t status = bignum_divmod(value.num, value.den, &quotient, &remainder);
+	if ((status == CALC_OK) && round_down && INTEGER_NEGATIVE(value.num) && !INTEGER_IS(remainder, 0))
+	{
+		calc_integer_t lower = INTEGER_INT(REF_INACTIVE);
+		status = bignum_addsub(quotient, INTEGER_INT(1), REF_ACTIVATE, &lower);
+		bignum_release(&quotient);
+		quotient = lower;
+	}
+	bignum_release(&remainder);
+	if (status != CALC_OK)
+	{
+		bignum_release(&quotient);
+		return status;
+	}
+	*integer = (calc_value_t){quotient, INTEGER_INT(1)};
+	return CALC_OK;
+} //end uint8_t rational_trunc()
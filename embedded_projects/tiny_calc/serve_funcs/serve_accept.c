@@ -0,0 +1,47 @@
+# define _GNU_SOURCE	//accept4()
+# include "../src/claytor.h"
+
+void serve_accept(serve_ctx_t *server)
+{
+	/* This function accepts every client waiting on the listening socket.
+	 * Each one gets a serve_conn_t of its own, is registered with epoll for
+	 * reading and linked into the server's list of connections. A client that
+	 * can't be set up is simply disconnected again, which is all the server
+	 * can tell it; the server itself carries on.
+	 */
+	for (;;)
+	{
+		int conn_fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (conn_fd < 0)
+		{
+			if ((errno == EINTR) || (errno == ECONNABORTED)) continue;
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			{
+				fprintf(stderr, "serve_accept(): accept4() failure: %s.\n", strerror(errno));
+			}
+			return;
+		}
+		serve_conn_t *conn = malloc(sizeof(serve_conn_t));	//the buffers need no clearing
+		struct epoll_event event = {EPOLLIN, {.ptr = conn}};
+		if ((conn == NULL) || (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, conn_fd, &event) < 0))
+		{
+			fprintf(stderr, "serve_accept(): Error setting up a connection, dropping it.\n");
+			free(conn);
+			close(conn_fd);
+			continue;
+		}
+		conn->fd = conn_fd;
+		conn->closing = REF_INACTIVE;
+		conn->discarding = REF_INACTIVE;
+		conn->events = EPOLLIN;
+		conn->in_len = REF_INACTIVE;
+		conn->out_head = conn->out_tail = REF_INACTIVE;
+		conn->big = NULL;
+		conn->big_len = conn->big_sent = REF_INACTIVE;
+		conn->prev = NULL;
+		conn->next = server->conns;
+		if (server->conns != NULL) server->conns->prev = conn;
+		server->conns = conn;
+		server->n_accepted++;
+	} //end for-loop over waiting clients
+} //end void serve_accept()
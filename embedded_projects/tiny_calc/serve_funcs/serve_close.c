@@ -0,0 +1,15 @@
+# include "../src/claytor.h"
+
+void serve_close(serve_ctx_t *server, serve_conn_t *conn)
+{
+	/* This function disconnects a client: it is unlinked from the server's
+	 * list, its socket is closed (which also removes it from epoll) and
+	 * everything it held is freed, responses that weren't sent included.
+	 */
+	if (conn->prev != NULL) conn->prev->next = conn->next;
+	else server->conns = conn->next;
+	if (conn->next != NULL) conn->next->prev = conn->prev;
+	close(conn->fd);
+	free(conn->big);
+	free(conn);
+} //end void serve_close()
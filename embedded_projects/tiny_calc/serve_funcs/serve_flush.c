@@ -0,0 +1,43 @@
+# include "../src/claytor.h"
+
+int serve_flush(serve_conn_t *conn)
+{
+	/* This function sends a connection's queued responses, however many
+	 * requests they answer, with a single writev() for as long as the socket
+	 * takes them: the ring is gathered as one slice, or two if it wraps
+	 * around its end, followed by the response held in big, if any, so a
+	 * pipelining client gets its answers in as few system calls as there
+	 * are socket buffers to fill. Whatever didn't fit stays queued until
+	 * epoll reports the socket writable again. Returns 0, or -1 if the
+	 * client can't be written to anymore.
+	 */
+	while ((conn->out_head != conn->out_tail) || (conn->big != NULL))
+	{
+		struct iovec parts[3];
+		int n_parts = REF_INACTIVE;
+		size_t queued = conn->out_head - conn->out_tail;
+		size_t start = conn->out_tail % SERVE_RING;
+		size_t first = (queued < SERVE_RING - start)? queued : SERVE_RING - start;
+		if (first > 0) parts[n_parts++] = (struct iovec){conn->out + start, first};
+		if (queued > first) parts[n_parts++] = (struct iovec){conn->out, queued - first};
+		if (conn->big != NULL) parts[n_parts++] = (struct iovec){conn->big + conn->big_sent, conn->big_len - conn->big_sent};
+		ssize_t sent = writev(conn->fd, parts, n_parts);
+		if (sent < 0)
+		{
+			if (errno == EINTR) continue;
+			return ((errno == EAGAIN) || (errno == EWOULDBLOCK))? 0 : -1;
+		}
+		size_t from_ring = ((size_t)sent < queued)? (size_t)sent : queued;
+		conn->out_tail += from_ring;
+		if (conn->big != NULL)
+		{
+			conn->big_sent += (size_t)sent - from_ring;
+			if (conn->big_sent == conn->big_len)
+			{
+				free(conn->big);
+				conn->big = NULL;
+			}
+		}
+	} //end while (responses are queued)
+	return 0;
+} //end int serve_flush()
@@ -0,0 +1,109 @@
+# include "../src/claytor.h"
+
+static uint8_t has_room(const serve_conn_t *conn)
+{
+	/* Whether another response is guaranteed to fit (see serve_respond()). */
+	return (conn->big == NULL) && ((SERVE_RING - (conn->out_head - conn->out_tail)) >= RESULT_SIZE);
+}
+
+static uint8_t has_request(const serve_conn_t *conn)
+{
+	/* Whether the input holds a request that can be answered: a complete
+	 * line, or whatever the client sent last without a newline.
+	 */
+	return (memchr(conn->in, '\n', conn->in_len) != NULL) || (conn->closing && (conn->in_len > 0));
+}
+
+static void answer(serve_ctx_t *server, serve_conn_t *conn)
+{
+	/* Answers the requests in the input, in order, for as long as their
+	 * responses fit, and moves whatever is left to the front of the input.
+	 * A line that fills the whole input without ending is answered with
+	 * "error", and everything up to its newline is skipped.
+	 */
+	size_t start = REF_INACTIVE;
+	while (has_room(conn) && (start < conn->in_len))
+	{
+		char *line = conn->in + start;
+		char *newline = memchr(line, '\n', conn->in_len - start);
+		if (newline == NULL)
+		{
+			if (conn->discarding)
+			{
+				start = conn->in_len;
+			}
+			else if (conn->in_len - start == SERVE_INPUT)
+			{
+				serve_respond(server, conn, NULL);
+				conn->discarding = REF_ACTIVATE;
+				start = conn->in_len;
+			}
+			else if (conn->closing)
+			{
+				conn->in[conn->in_len] = '\0';	//never full here, see above
+				serve_respond(server, conn, line);
+				start = conn->in_len;
+			}
+			break;
+		}
+		*newline = '\0';
+		if (conn->discarding) conn->discarding = REF_INACTIVE;	//the end of an overlong line
+		else serve_respond(server, conn, line);
+		start = (size_t)(newline + 1 - conn->in);
+	} //end while (responses fit)
+	memmove(conn->in, conn->in + start, conn->in_len - start);
+	conn->in_len -= start;
+}
+
+uint8_t serve_handle(serve_ctx_t *server, serve_conn_t *conn, uint32_t events)
+{
+	/* This function does whatever a client's socket is ready for: requests
+	 * are read, answered and flushed in turns, so a client that pipelines
+	 * many requests has them all answered in a handful of reads and writes.
+	 * Reading stops once the responses no longer fit the ring, which leaves
+	 * the rest of the requests in the socket until the client has read its
+	 * answers; a client that never reads can't make the server buffer
+	 * without bound. A connection is read at most SERVE_BURST times per
+	 * wakeup, so one busy client can't hold up the others, and epoll is told
+	 * whether the connection waits to read, to write or both. Returns
+	 * REF_ACTIVATE once the connection should be closed: the client left and
+	 * every answer was sent, or the socket failed.
+	 */
+	if (events & EPOLLERR)
+	{
+		return REF_ACTIVATE;
+	}
+	uint8_t u_reads = REF_INACTIVE;
+	for (;;)
+	{
+		answer(server, conn);
+		if (serve_flush(conn) < 0)
+		{
+			return REF_ACTIVATE;
+		}
+		if (has_room(conn) && has_request(conn)) continue;	//flushing made room for more answers
+		if (!has_room(conn) || conn->closing || (u_reads++ == SERVE_BURST)) break;
+		ssize_t got = read(conn->fd, conn->in + conn->in_len, SERVE_INPUT - conn->in_len);
+		if (got > 0) conn->in_len += (size_t)got;
+		else if (got == 0) conn->closing = REF_ACTIVATE;
+		else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+		else if (errno != EINTR) return REF_ACTIVATE;
+	} //end for-loop over reads
+
+	uint8_t pending = (conn->out_head != conn->out_tail) || (conn->big != NULL);
+	if (conn->closing && !pending && (conn->in_len == 0))
+	{
+		return REF_ACTIVATE;
+	}
+	uint32_t wanted = ((pending)? EPOLLOUT : 0) | ((has_room(conn) && !conn->closing)? EPOLLIN : 0);
+	if (wanted != conn->events)
+	{
+		struct epoll_event event = {wanted, {.ptr = conn}};
+		if (epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) < 0)
+		{
+			return REF_ACTIVATE;
+		}
+		conn->events = wanted;
+	}
+	return REF_INACTIVE;
+} //end uint8_t serve_handle()
@@ -0,0 +1,50 @@
+# include "../src/claytor.h"
+
+int serve_listen(const char *socket_path)
+{
+	/* This function creates the server's listening socket, bound to
+	 * socket_path and non-blocking, like every other descriptor the epoll
+	 * loop handles. A socket file that is already there is only replaced if
+	 * nothing is listening on it anymore (a server that didn't shut down
+	 * cleanly leaves one behind), which connecting to it tells: a live server
+	 * is never taken over. Returns the socket, or -1 after reporting why
+	 * there isn't one.
+	 */
+	struct sockaddr_un address = {0};
+	address.sun_family = AF_UNIX;
+	if (strlen(socket_path) >= sizeof(address.sun_path))
+	{
+		fprintf(stderr, "serve_listen(): the socket path \"%s\" is too long.\n", socket_path);
+		return -1;
+	}
+	memcpy(address.sun_path, socket_path, strlen(socket_path) + 1);
+	int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listen_fd < 0)
+	{
+		fprintf(stderr, "serve_listen(): socket() failure: %s.\n", strerror(errno));
+		return -1;
+	}
+	int bound = bind(listen_fd, (struct sockaddr *)&address, sizeof(address));
+	if ((bound < 0) && (errno == EADDRINUSE))
+	{
+		int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		uint8_t stale = (probe_fd >= 0) && (connect(probe_fd, (struct sockaddr *)&address, sizeof(address)) < 0) &&
+			(errno == ECONNREFUSED);
+		if (probe_fd >= 0) close(probe_fd);
+		if (stale && (unlink(socket_path) == 0))
+		{
+			bound = bind(listen_fd, (struct sockaddr *)&address, sizeof(address));
+		}
+		else
+		{
+			errno = EADDRINUSE;
+		}
+	}
+	if ((bound < 0) || (listen(listen_fd, SOMAXCONN) < 0))
+	{
+		fprintf(stderr, "serve_listen(): Error listening on \"%s\": %s.\n", socket_path, strerror(errno));
+		close(listen_fd);
+		return -1;
+	}
+	return listen_fd;
+} //end int serve_listen()
@@ -0,0 +1,63 @@
+# include "../src/claytor.h"
+
+static void queue(serve_conn_t *conn, const char *text, size_t len)
+{
+	/* Copies a response into the ring, wrapping around its end. The caller
+	 * has made sure that it fits.
+	 */
+	size_t start = conn->out_head % SERVE_RING;
+	size_t first = (len < SERVE_RING - start)? len : SERVE_RING - start;
+	memcpy(conn->out + start, text, first);
+	memcpy(conn->out, text + first, len - first);
+	conn->out_head += len;
+}
+
+void serve_respond(serve_ctx_t *server, serve_conn_t *conn, char *line)
+{
+	/* This function answers one request: the expression in line is parsed
+	 * and evaluated exactly as batch mode would, and its result (or "error",
+	 * or "error: " and the reason evaluation failed) is queued as one line
+	 * of output. A NULL line is a request that couldn't be read at all (it
+	 * was longer than SERVE_INPUT), which is answered with "error" as well.
+	 * The caller makes sure there are at least RESULT_SIZE bytes free in the
+	 * ring and that nothing is held in big, so every response but a very
+	 * long bignum fits the ring; such a result is held in big as it comes
+	 * from value_string(), its terminating NUL replaced by the newline.
+	 */
+	char scratch[RESULT_SIZE] = {REF_INACTIVE};
+	calc_ast_t ast = {NULL, 0, 0, 0};
+	server->n_requests++;
+	if ((line == NULL) || (ast_parse(line, &ast) != CALC_OK))
+	{
+		queue(conn, "error\n", strlen("error\n"));
+		return;
+	}
+	calc_value_t result = VALUE_INT(REF_INACTIVE);
+	uint8_t status = ast_eval(&ast, NULL, &result);
+	ast_free(&ast);
+	if (status != CALC_OK)
+	{
+		int written = snprintf(scratch, RESULT_SIZE, "error: %s\n", calc_strerror(status));
+		queue(conn, scratch, written);
+		return;
+	}
+	char *formatted = value_string(result, scratch, RESULT_SIZE - 1);	//leaves room for the newline
+	value_release(&result);
+	if (formatted == NULL)
+	{
+		queue(conn, "error\n", strlen("error\n"));
+	}
+	else if (formatted == scratch)
+	{
+		size_t len = strlen(scratch);
+		scratch[len] = '\n';
+		queue(conn, scratch, len + 1);
+	}
+	else
+	{
+		conn->big = formatted;
+		conn->big_len = strlen(formatted);
+		formatted[conn->big_len++] = '\n';
+		conn->big_sent = REF_INACTIVE;
+	}
+} //end void serve_respond()
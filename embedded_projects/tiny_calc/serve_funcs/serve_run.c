@@ -0,0 +1,77 @@
+# include "../src/claytor.h"
+
+int serve_run(const char *socket_path)
+{
+	/* This function drives server mode: expressions are served to any
+	 * number of clients over a Unix domain socket at socket_path, from a
+	 * single thread and a single epoll loop. Clients send one expression per
+	 * line and get one line back per expression, in order, formatted like
+	 * batch mode's output; they can pipeline as many requests as they like
+	 * without waiting for the answers (see serve_handle()). Every socket is
+	 * non-blocking and epoll is level-triggered, so a connection that is
+	 * left with work simply comes up again on the next wakeup. SIGINT and
+	 * SIGTERM are received through a signalfd in the same loop, so the
+	 * server shuts down between requests rather than in the middle of one:
+	 * every connection is closed, the socket file is removed and the number
+	 * of connections and requests served is reported on stderr. SIGPIPE is
+	 * ignored, so a client that leaves without reading its answers is just a
+	 * failed write.
+	 */
+	serve_ctx_t server = {-1, -1, -1, NULL, 0, 0};
+	sigset_t stop_signals;
+	sigemptyset(&stop_signals);
+	sigaddset(&stop_signals, SIGINT);
+	sigaddset(&stop_signals, SIGTERM);
+	signal(SIGPIPE, SIG_IGN);
+	server.listen_fd = serve_listen(socket_path);
+	if (server.listen_fd < 0)
+	{
+		return EXIT_FAILURE;
+	}
+	struct epoll_event listen_event = {EPOLLIN, {.ptr = &server.listen_fd}};
+	struct epoll_event signal_event = {EPOLLIN, {.ptr = &server.signal_fd}};
+	int status = EXIT_SUCCESS;
+	if ((sigprocmask(SIG_BLOCK, &stop_signals, NULL) < 0) ||
+		((server.signal_fd = signalfd(-1, &stop_signals, SFD_NONBLOCK | SFD_CLOEXEC)) < 0) ||
+		((server.epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0) ||
+		(epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listen_event) < 0) ||
+		(epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.signal_fd, &signal_event) < 0))
+	{
+		fprintf(stderr, "serve_run(): Error setting up the event loop: %s.\n", strerror(errno));
+		status = EXIT_FAILURE;
+	}
+	else
+	{
+		fprintf(stderr, "server: listening on \"%s\".\n", socket_path);
+	}
+
+	struct epoll_event events[SERVE_EVENTS];
+	uint8_t running = (status == EXIT_SUCCESS);
+	while (running)
+	{
+		int n_events = epoll_wait(server.epoll_fd, events, SERVE_EVENTS, -1);
+		if (n_events < 0)
+		{
+			if (errno == EINTR) continue;
+			fprintf(stderr, "serve_run(): epoll_wait() failure: %s.\n", strerror(errno));
+			status = EXIT_FAILURE;
+			break;
+		}
+		for (int event = 0; event < n_events; event++)
+		{
+			void *source = events[event].data.ptr;
+			if (source == &server.listen_fd) serve_accept(&server);
+			else if (source == &server.signal_fd) running = REF_INACTIVE;
+			else if (serve_handle(&server, source, events[event].events)) serve_close(&server, source);
+		}
+	} //end while (running)
+
+	while (server.conns != NULL) serve_close(&server, server.conns);
+	if (server.epoll_fd >= 0) close(server.epoll_fd);
+	if (server.signal_fd >= 0) close(server.signal_fd);
+	close(server.listen_fd);
+	unlink(socket_path);
+	fprintf(stderr, "server: %llu connections, %llu requests served.\n",
+		(unsigned long long)server.n_accepted, (unsigned long long)server.n_requests);
+	return status;
+} //end int serve_run()
@@ -0,0 +1,48 @@
+# include "../src/claytor.h"
+
+uint8_t sheet_define(calc_sheet_t *sheet, uint8_t var, const char *src_array, size_t *error_offset)
+{
+	/* This function assigns the formula src_array to the variable var,
+	 * replacing the formula it had. The formula is parsed, folded and
+	 * compiled once, here, and from then on only its program is evaluated.
+	 * If it doesn't parse, CALC_ESYNTAX (or the lexer's error) is returned
+	 * with error_offset set like ast_parse() sets it. If it would make the
+	 * formulas read each other in a circle (see sheet_order()), CALC_ECYCLE
+	 * is returned. Either way the sheet is left as it was. Otherwise the
+	 * variable is marked dirty, and the caller has sheet_recalc() bring
+	 * everything that depends on it up to date.
+	 */
+	calc_ast_t ast = {NULL, 0, 0, 0};
+	calc_prog_t prog = {NULL, 0, 0};
+	uint8_t status = ast_parse(src_array, &ast);
+	*error_offset = ast.error_offset;
+	if (status != CALC_OK)
+	{
+		return status;
+	}
+	ast_fold(&ast);
+	status = prog_compile(&ast, &prog);
+	ast_free(&ast);
+	if (status != CALC_OK)
+	{
+		return status;
+	}
+
+	uint32_t old_reads = sheet->reads[var];
+	uint32_t old_defined = sheet->defined;
+	sheet->reads[var] = prog_reads(&prog);
+	sheet->defined |= VAR_BIT(var);
+	status = sheet_order(sheet);
+	if (status != CALC_OK)
+	{
+		sheet->reads[var] = old_reads;
+		sheet->defined = old_defined;
+		sheet_order(sheet);	//the old formulas were in order
+		prog_free(&prog);
+		return status;
+	}
+	prog_free(&sheet->formulas[var]);
+	sheet->formulas[var] = prog;
+	sheet->dirty |= VAR_BIT(var);
+	return CALC_OK;
+} //end uint8_t sheet_define()
@@ -0,0 +1,21 @@
+# include "../src/claytor.h"
+
+uint8_t sheet_eval(const calc_sheet_t *sheet, const calc_prog_t *prog, uint32_t reads, calc_value_t *result)
+{
+	/* This function evaluates a compiled expression with its variables
+	 * bound to the values of the sheet's formulas; reads is the set of
+	 * variables it reads (see prog_reads()). An expression reading a
+	 * variable without a formula fails with CALC_EUNBOUND, and one reading a
+	 * formula that failed fails the same way that formula did, so errors
+	 * carry through every formula that depends on them.
+	 */
+	if (reads & ~sheet->defined)
+	{
+		return CALC_EUNBOUND;
+	}
+	for (uint8_t var = 0; reads != 0; var++, reads >>= 1)
+	{
+		if ((reads & 1) && (sheet->status[var] != CALC_OK)) return sheet->status[var];
+	}
+	return prog_eval(prog, sheet->values, result);
+} //end uint8_t sheet_eval()
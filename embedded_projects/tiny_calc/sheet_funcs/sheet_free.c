@@ -0,0 +1,15 @@
+# include "../src/claytor.h"
+
+void sheet_free(calc_sheet_t *sheet)
+{
+	/* This function releases every formula of a sheet and the value it last
+	 * evaluated to. The sheet is left empty (see sheet_init()), so freeing it
+	 * twice is harmless.
+	 */
+	for (uint8_t var = 0; var < CALC_VARS; var++)
+	{
+		prog_free(&sheet->formulas[var]);
+		value_release(&sheet->values[var]);
+	}
+	sheet_init(sheet);
+} //end void sheet_free()
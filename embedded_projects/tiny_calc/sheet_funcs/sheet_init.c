@@ -0,0 +1,20 @@
+# include "../src/claytor.h"
+
+void sheet_init(calc_sheet_t *sheet)
+{
+	/* This function sets up an empty sheet: no variable has a formula yet,
+	 * so every one of them is unbound.
+	 */
+	for (uint8_t var = 0; var < CALC_VARS; var++)
+	{
+		sheet->formulas[var] = (calc_prog_t){NULL, 0, 0};
+		sheet->values[var] = VALUE_INT(REF_INACTIVE);
+		sheet->status[var] = CALC_EUNBOUND;
+		sheet->reads[var] = REF_INACTIVE;
+		sheet->users[var] = REF_INACTIVE;
+	}
+	sheet->n_order = REF_INACTIVE;
+	sheet->defined = REF_INACTIVE;
+	sheet->dirty = REF_INACTIVE;
+	sheet->evaluations = REF_INACTIVE;
+} //end void sheet_init()
@@ -0,0 +1,42 @@
+# include "../src/claytor.h"
+
+uint8_t sheet_order(calc_sheet_t *sheet)
+{
+	/* This function sorts the formulas of a sheet topologically, so that
+	 * sheet_recalc() can evaluate them in one pass with every formula after
+	 * those it reads, and works out which formulas read every variable.
+	 * Sets of variables being bitmasks, the sort (Kahn's algorithm) is a few
+	 * passes over at most CALC_VARS formulas: every pass places each formula
+	 * whose defined inputs have all been placed. Variables without a formula
+	 * don't hold anything up, since they are simply unbound. If a pass places
+	 * nothing while formulas are left, those formulas read each other in a
+	 * circle (a formula reading itself included), and CALC_ECYCLE is
+	 * returned with the order incomplete.
+	 */
+	uint32_t placed = REF_INACTIVE;
+	sheet->n_order = REF_INACTIVE;
+	for (uint8_t var = 0; var < CALC_VARS; var++)
+	{
+		sheet->users[var] = REF_INACTIVE;
+		for (uint8_t user = 0; user < CALC_VARS; user++)
+		{
+			if (sheet->reads[user] & VAR_BIT(var)) sheet->users[var] |= VAR_BIT(user);
+		}
+	}
+	while (placed != sheet->defined)
+	{
+		uint32_t ready = REF_INACTIVE;
+		for (uint8_t var = 0; var < CALC_VARS; var++)
+		{
+			if (!(sheet->defined & ~placed & VAR_BIT(var)) || (sheet->reads[var] & sheet->defined & ~placed)) continue;
+			sheet->order[sheet->n_order++] = var;
+			ready |= VAR_BIT(var);
+		}
+		if (ready == 0)
+		{
+			return CALC_ECYCLE;
+		}
+		placed |= ready;
+	}
+	return CALC_OK;
+} //end uint8_t sheet_order()
@@ -0,0 +1,59 @@
+# include "../src/claytor.h"
+
+static uint8_t same(uint8_t status_1, calc_value_t value_1, uint8_t status_2, calc_value_t value_2)
+{
+	/* Whether a formula's outcome is the one it had before: the same status
+	 * and, if that is CALC_OK, the same value (in double mode down to the
+	 * bit, so that 0 turning into -0 still reaches the formulas reading it.)
+	 */
+	if (status_1 != status_2)
+	{
+		return REF_INACTIVE;
+	}
+	if (status_1 != CALC_OK)
+	{
+		return REF_ACTIVATE;
+	}
+# if defined(CALC_MODE_DOUBLE)
+	return memcmp(&value_1, &value_2, sizeof(calc_value_t)) == 0;
+# else
+	return value_cmp(value_1, value_2) == 0;
+# endif
+}
+
+uint32_t sheet_recalc(calc_sheet_t *sheet)
+{
+	/* This function brings a sheet up to date after formulas were assigned,
+	 * evaluating only the dirty formulas and whatever depends on them rather
+	 * than every formula. It makes a single pass over the formulas in
+	 * topological order (see sheet_order()), so every formula is evaluated
+	 * at most once and only after every formula it reads is up to date. A
+	 * formula's outcome changing marks the formulas reading it dirty in
+	 * turn, which are all further down the order; an outcome that stays the
+	 * same stops the propagation there, so assigning a variable the value it
+	 * already had evaluates nothing else. Returns the set of variables whose
+	 * outcome changed (see VAR_BIT()), and leaves nothing dirty.
+	 */
+	uint32_t changed = REF_INACTIVE;
+	for (uint8_t index = 0; (index < sheet->n_order) && (sheet->dirty != 0); index++)
+	{
+		uint8_t var = sheet->order[index];
+		if (!(sheet->dirty & VAR_BIT(var))) continue;
+		sheet->dirty &= ~VAR_BIT(var);
+		calc_value_t value = VALUE_INT(REF_INACTIVE);
+		uint8_t status = sheet_eval(sheet, &sheet->formulas[var], sheet->reads[var], &value);
+		sheet->evaluations++;
+		if (same(status, value, sheet->status[var], sheet->values[var]))
+		{
+			value_release(&value);
+			continue;
+		}
+		value_release(&sheet->values[var]);
+		sheet->values[var] = value;
+		sheet->status[var] = status;
+		sheet->dirty |= sheet->users[var];
+		changed |= VAR_BIT(var);
+	} //end for-loop over formulas
+	sheet->dirty = REF_INACTIVE;
+	return changed;
+} //end uint32_t sheet_recalc()
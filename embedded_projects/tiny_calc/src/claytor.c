@@ -1,28 +1,68 @@
-/* This is a basic calculator program written in C which uses PREFIX notation
- * to achieve results instead of chaining (which more common calculators use.)
- * This method also equips it with the awareness of operator precedence as well
- * as parentheses priority when evaluating an expression. Interestingly enough,
- * POSTFIX notation (aka Reverse Polish notation) is PREFIX notation but read
- * backwards (which is the same for POSTFIX to PREFIX.) INFIX notation is the
- * human-readable 5 + (6 * 7), which is much more computationally intensive.
+/* This is a basic calculator program written in C which parses expressions
+ * into a syntax tree to achieve results instead of chaining (which more common
+ * calculators use.) This method also equips it with the awareness of operator
+ * precedence and associativity as well as parentheses priority when evaluating
+ * an expression. The tree is stored in POSTFIX notation (aka Reverse Polish
+ * notation), in which every operator follows its operands, rather than in the
+ * human-readable INFIX notation 5 + (6 * 7), which is much more
+ * computationally intensive to evaluate.
  * A detailed explanation is included in the description of every function, but
  * an overview of the logic implemented is:
  * 1) retrieve an input expression from the user,
- * 2) trim the input string of any spaces and begin traversing it backwards,
- * 3) all numbers are stored on an output stack while operators are stored on an
- * operator stack (this preserves heirarchy),
- * 4) both stacks are merged into one output stack,
- * 5) the output stack is parsed using the pattern "operator-operand-operand",
- * which gives a mathematical result,
- * 6) the result is pushed onto the output stack at a position where it replaces
- * the operator and operands consumed to get it,
- * 7) the output stack is iterated through until it only contains a single item,
- * which is the final result.
+ * 2) split the input string into tokens (skipping any spaces) in a single
+ * forward pass,
+ * 3) parse the tokens into an AST as they arrive, every operand being claimed
+ * by whichever neighbouring operator binds tighter (this preserves hierarchy),
+ * 4) evaluate the AST node by node, every node after its children, so that
+ * the value of the last node, the root, is the final result.
+ * An expression evaluated many times over (as in column mode) is instead
+ * folded first, which evaluates its constant sub-expressions and drops
+ * identities such as x*1, and then compiled into a POSTFIX program that is
+ * evaluated in a single pass with an operand stack. Interactively, every
+ * expression is compiled as well and kept in a cache along with its result,
+ * so an expression that is entered again (even spaced differently) is
+ * answered straight from the cache. The least recently used expressions make
+ * way for new ones once the cache is full ("-m"), and its hit rate is
+ * reported on exit. A variable can also be assigned a formula ("c = a + b"),
+ * which is kept like a spreadsheet cell: assigning another formula to a
+ * variable re-evaluates only the formulas that depend on it, in dependency
+ * order, and formulas that would depend on themselves are refused.
  *
- * Note: a few caveats to the calculator in its current form: root extraction is
- * 		unsupported as of yet as is exponentiation; most importantly floats are
- * 		not supported. These caveats will be addressed in coming versions, even
- * 		set functionality that will use row-matrix mathematical operations.
+ * Besides the interactive mode, a batch mode ("-b") evaluates a whole file of
+ * expressions, one per line. Since every line is independent of the others, the
+ * lines are split into chunks and evaluated by a pool of worker threads, with
+ * the results written out in input order once every worker is done. Column
+ * mode ("-c") instead evaluates a single expression with variables ('a' to
+ * 'z') over every row of a CSV or binary file, running every operator of the
+ * compiled program over blocks of rows at a time. With "-J" the program is
+ * translated into native x86-64 code instead, which keeps its operand stack
+ * in registers. Server mode ("-s") answers expressions sent over a Unix
+ * domain socket, one per line, to many clients at once from a single epoll
+ * loop; clients can pipeline as many requests as they like.
+ *
+ * The calculator is also available as a library ("make libclaytor"), whose
+ * interface is described in libclaytor.h: it compiles and evaluates
+ * expressions in-process, without any global state, so that programs (and
+ * their threads) can use it without running claytor at all. "make bench"
+ * times every stage of evaluation over random expressions, and "make fuzz"
+ * checks every evaluation path against the plain AST interpreter.
+ *
+ * The numeric type everything is computed in is chosen at compile time: 64 bit
+ * integers by default, or 128 bit integers, IEEE doubles, arbitrary-precision
+ * integers (bignums) or exact fractions of bignums (rationals) through the MODE
+ * variable of the Makefile. Overflows and divisions by zero are reported as
+ * errors rather than wrapping around or trapping.
+ *
+ * Besides +, -, * and /, expressions can use '^' for exponentiation, '%' for
+ * remainders, the bitwise operators &, |, ~, << and >>, the comparisons <, <=,
+ * >, >=, == and != (which are 1 or 0), and call abs(), min(), max(), sqrt(),
+ * pow() and xor(). All of them are entries of one operator registry (see
+ * math_registry.c), which the lexer, the parser and every evaluator share.
+ *
+ * Note: a few caveats to the calculator in its current form: roots other than
+ * 		square roots are unsupported as of yet. These caveats will be addressed
+ * 		in coming versions, even set functionality that will use row-matrix
+ * 		mathematical operations.
  * 
  * Author: Rahul Singh
  * Date: 15 Jun 2022
@@ -30,46 +70,202 @@
 
 # include "claytor.h"
 
-int main(void)
+/* GLOBAL VARIABLES */
+claytor_opts_t claytor_opts_g = {NULL, NULL, NULL, NULL, NULL, 1, REF_INACTIVE, CACHE_SIZE};
+
+static void print_result(uint8_t status, calc_value_t result, char *scratch)
+{
+	/* Prints the outcome of evaluating one interactive expression: either
+	 * its result or why there isn't one.
+	 */
+	if (status != CALC_OK)
+	{
+		printf("Error: %s.\n", calc_strerror(status));
+		return;
+	}
+	char *formatted = value_string(result, scratch, RESULT_SIZE);
+	printf("= %s\n", (formatted != NULL)? formatted : "?");
+	if (formatted != scratch) free(formatted);
+}
+
+static uint8_t assigned_var(const char *input, const char **formula)
 {
-	char input[INPUT_SIZE] = {REF_INACTIVE};
+	/* Whether the input assigns a formula to a variable ("c = a + b"), in
+	 * which case the variable's index is returned and formula is set to what
+	 * follows the '='. CALC_VARS is returned for anything else, comparisons
+	 * such as "c == 1" and function calls included.
+	 */
+	while (isspace((unsigned char)*input)) input++;
+	if (!islower((unsigned char)input[0]) || islower((unsigned char)input[1]))
+	{
+		return CALC_VARS;
+	}
+	const char *reader = input + 1;
+	while (isspace((unsigned char)*reader)) reader++;
+	if ((reader[0] != 0x3D) || (reader[1] == 0x3D))	//'=', but not "=="
+	{
+		return CALC_VARS;
+	}
+	*formula = reader + 1;
+	return (uint8_t)(input[0] - 'a');
+}
+
+static void print_changes(const calc_sheet_t *sheet, uint32_t changed, char *scratch)
+{
+	/* Prints the outcome of every formula an assignment changed, in the
+	 * order they were evaluated in.
+	 */
+	for (uint8_t index = 0; index < sheet->n_order; index++)
+	{
+		uint8_t var = sheet->order[index];
+		if (!(changed & VAR_BIT(var))) continue;
+		printf((sheet->status[var] != CALC_OK)? "%c: " : "%c ", 'a' + var);
+		print_result(sheet->status[var], sheet->values[var], scratch);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	long online_cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (online_cores > BATCH_THREADS) online_cores = BATCH_THREADS;
+	claytor_opts_g.u_threads = (online_cores > 0)? online_cores : 1;
+	parse_args(argc, argv);
+	if (claytor_opts_g.column_path != NULL)
+	{
+		return col_run(&claytor_opts_g);
+	}
+	if (claytor_opts_g.batch_path != NULL)
+	{
+		return batch_run(claytor_opts_g.batch_path, claytor_opts_g.u_threads);
+	}
+	if (claytor_opts_g.socket_path != NULL)
+	{
+		return serve_run(claytor_opts_g.socket_path);
+	}
+
+	calc_sheet_t sheet;
+	sheet_init(&sheet);
+	calc_cache_t cache;
+	if (cache_init(&cache, claytor_opts_g.u_cache) != CALC_OK)
+	{
+		fprintf(stderr, "main(): Error allocating the expression cache, continuing without it.\n");
+	}
+	char *input = NULL;	//grown by get_input() to fit every line
+	size_t input_cap = 0;
+	char *normalized = NULL;	//kept as long as input, see cache_normalize()
+	size_t normalized_cap = 0;
+	char scratch[RESULT_SIZE] = {REF_INACTIVE};
 	uint8_t exit_lock = NO_EXIT;
 	printf(".:Welcome to Claytor:."); //calculator -> calc-lator -> claytor
 	while (exit_lock != ALLOW_EXIT)
 	{
 		printf("\n> ");
-		get_input(input, INPUT_SIZE);
-		if (strncmp(input, "q", strlen("q")) == 0)
+		const char *formula = NULL;
+		uint8_t var = CALC_VARS;
+		ssize_t input_len = get_input(&input, &input_cap);
+		if ((input_len < 0) ||
+			((strncmp(input, "q", strlen("q")) == 0) && ((var = assigned_var(input, &formula)) == CALC_VARS)))
 		{
-			/* Only "q" will allow the program to exit, any other character will
-			 * be ignored and instead passed as calculator input for processing.
+			/* Only "q" (or the end of the input) will allow the program to
+			 * exit, any other character will be ignored and instead passed as
+			 * calculator input for processing. Assigning a formula to q
+			 * doesn't count.
 			 */
 			exit_lock = ALLOW_EXIT;
 			continue;
 		}
-		calc_stack_t *parsed_input = parse_array(input);
-		if (parsed_input == NULL)
+		if (var == CALC_VARS) var = assigned_var(input, &formula);
+		if (var < CALC_VARS)
+		{
+			/* The variable is (re)assigned a formula, and only the formulas
+			 * it changes the outcome of are evaluated again. The variable
+			 * itself is always printed, and after it every other formula
+			 * whose value changed because of it.
+			 */
+			size_t error_offset = REF_INACTIVE;
+			uint8_t status = sheet_define(&sheet, var, formula, &error_offset);
+			if (status == CALC_ESYNTAX)
+			{
+				printf("Some errors parsing input at character %zu. (Use \"q\" to quit.)\n", (size_t)(formula - input) + error_offset + 1);
+				continue;
+			}
+			if (status != CALC_OK)
+			{
+				printf("Error: %s.\n", calc_strerror(status));
+				continue;
+			}
+			print_changes(&sheet, sheet_recalc(&sheet) | VAR_BIT(var), scratch);
+			continue;
+		}
+		if ((size_t)input_len >= normalized_cap)
+		{
+			char *grown = realloc(normalized, (size_t)input_len + 1);
+			if (grown == NULL)
+			{
+				fprintf(stderr, "realloc() failure, exiting.\n");
+				exit(EXIT_FAILURE);
+			}
+			normalized = grown;
+			normalized_cap = (size_t)input_len + 1;
+		}
+		cache_normalize(input, normalized);
+		const cache_entry_t *cached = cache_lookup(&cache, normalized);
+		if (cached != NULL)
 		{
-			/* If at all the user entered unintelligible characters that can not
-			 * be recognised by the array parser, the parsed_input will be NULL.
-			 * In this case, inform the user about it, suggest one method to
-			 * exit, and restart. (Of course, Ctrl+C can also be used.)
+			/* The same expression (give or take its spacing) was entered
+			 * before and is still cached, so its result is simply printed
+			 * again without parsing or evaluating anything.
 			 */
-			printf("Some errors parsing input. (Use \"q\" to quit.)\n");
+			print_result(cached->status, cached->result, scratch);
+			continue;
 		}
-		else
+		calc_ast_t ast = {NULL, 0, 0, 0};
+		uint8_t status = ast_parse(input, &ast);
+		if (status != CALC_OK)
 		{
-			/* By the time the result is retrieved, the output, operator and the
-			 * secondary stack from get_result() should have been freed off the
-			 * heap. Whenever the get_result or parse_array functions are called
-			 * again, the pointers will be reinitialised to NULL. Note that the
-			 * type_check function in get_result() is only a pointer to a stack,
-			 * nothing is actually pushed onto it so there isn't a need to free
-			 * it.
+			/* If at all the user entered unintelligible characters or an
+			 * expression that doesn't add up, ast_parse() reports where it
+			 * gave up. In this case, inform the user about it, suggest one
+			 * method to exit, and restart. (Of course, Ctrl+C can also be used.)
 			 */
-			int32_t result = get_result(parsed_input);
-			printf("= %d\n", result);
+			printf("Some errors parsing input at character %zu. (Use \"q\" to quit.)\n", ast.error_offset + 1);
+			continue;
 		}
+		/* The AST is folded and compiled, and the program is evaluated and
+		 * handed over to the cache along with its result (errors included,
+		 * since evaluating the same expression again fails the same way.)
+		 * Running out of memory is the exception, as it might not happen
+		 * again, and so are expressions that read variables, whose result
+		 * changes along with the sheet. By the time the result is printed,
+		 * the AST should have been freed off the heap.
+		 */
+		calc_prog_t prog = {NULL, 0, 0};
+		calc_value_t result = VALUE_INT(REF_INACTIVE);
+		ast_fold(&ast);
+		status = prog_compile(&ast, &prog);
+		ast_free(&ast);
+		uint32_t reads = prog_reads(&prog);
+		if (status == CALC_OK) status = sheet_eval(&sheet, &prog, reads, &result);
+		print_result(status, result, scratch);
+		if ((prog.code != NULL) && (status != CALC_ENOMEM) && (reads == 0)) cache_insert(&cache, normalized, &prog, status, &result);
+		prog_free(&prog);
+		value_release(&result);
 	}	//end while (exit_lock != ALLOW_EXIT)
+	if (cache.capacity > 0)
+	{
+		uint64_t lookups = cache.hits + cache.misses;
+		fprintf(stderr, "cache: %llu hits, %llu misses (%.1f%% hit rate), %u of %u entries used.\n",
+			(unsigned long long)cache.hits, (unsigned long long)cache.misses,
+			(lookups > 0)? (100.0 * cache.hits) / lookups : 0.0, cache.len, cache.capacity);
+	}
+	if (sheet.defined != 0)
+	{
+		fprintf(stderr, "sheet: %d formulas, %llu evaluations.\n", __builtin_popcount(sheet.defined),
+			(unsigned long long)sheet.evaluations);
+	}
+	free(input);
+	free(normalized);
+	cache_free(&cache);
+	sheet_free(&sheet);
 	return 0;
 }
@@ -7,60 +7,541 @@
 # include <string.h>	//strcspn()
 # include <stdlib.h>	//exit()
 # include <stdint.h>	//uints
+# include <unistd.h>	//sysconf()
+# include <pthread.h>	//pthread_create(), pthread_join()
+# include <stdatomic.h>	//atomic_size_t
+# include <errno.h>		//errno, ERANGE
+# include <math.h>		//isfinite()
+# include <time.h>		//clock_gettime()
+# include <sys/mman.h>	//mmap(), mprotect()
+# include <signal.h>		//sigset_t, SIGPIPE
+# include <sys/epoll.h>	//epoll_create1(), epoll_wait()
+# include <sys/signalfd.h>	//signalfd()
+# include <sys/socket.h>	//socket(), accept4()
+# include <sys/uio.h>	//writev()
+# include <sys/un.h>		//struct sockaddr_un
+# include "libclaytor.h"	//the numeric mode, status codes and library interface
 
-# define INPUT_SIZE		128	//used by get_input() to limit the length of user input
 # define NO_EXIT		100	//used to set the program's interactive loop
 # define ALLOW_EXIT		99	//used to exit the program's interactive loop
 # define BASE			10	//used by strtol() to parse decimal digits
-
-# define LEFT_PAREN		6	//left parenthesis operator hierarchy '('
-# define MULTIPLY		5	//multiplication operator hierarchy '*'
-# define DIVISION		4	//division operator hierarchy '/'
-# define ADDITION		3	//addition operator hierarchy '+'
-# define SUBTRACT		2	//subraction operator hierarchy '-'
+# define RESULT_SIZE	64	//used by value_format() callers to format a single result
+# define BATCH_CHUNK	256	//number of input lines a batch worker claims at a time
+# define BATCH_THREADS	64	//upper limit of batch worker threads
+# define COL_BLOCK		1024	//rows column mode runs every operator over at a time
+# define CACHE_SIZE		256	//default number of expressions the interactive cache remembers
+# define CACHE_MAX		(1u << 20)	//upper limit of the interactive cache size
+# define CACHE_NONE		UINT32_MAX	//an empty link between cache entries
+# define SERVE_INPUT		4096	//longest request line the server accepts, newline included
+# define SERVE_RING		(1u << 16)	//bytes of responses a connection queues before it stops reading
+# define SERVE_EVENTS	64	//epoll events the server handles per wakeup
+# define SERVE_BURST		16	//reads per connection and wakeup, so that no client starves the others
+# define VAR_BIT(var)	(1u << (var))	//a variable's bit in a set of variables, 'a' being bit 0
 
 # define REF_ACTIVATE	1
-# define RIGHT_PAREN	REF_ACTIVATE	//right parenthesis operator hierarchy ')'
-# define OPERAND		REF_ACTIVATE	//used by type_flag to notify that the current stack item is an operand
-
 # define REF_INACTIVE	0
-# define OPERATOR		REF_INACTIVE	//used by type_flag to notify that the current stack item is an operator
 
-# define STACK_EMPTY	(-1)	//used by pop() to indicate a stack is empty
+# define INSTR_PUSH		0	//opcode of a compiled instruction that pushes a constant
+# define INSTR_VAR		1	//opcode of a compiled instruction that pushes a variable
+# define INSTR_OPERAND(op)	((op) <= INSTR_VAR)	//whether an opcode pushes rather than operates
+# define OP_ADD			2	//opcodes of the operators, indices into calc_ops[] (see math_registry.c)
+# define OP_SUB			3
+# define OP_MUL			4
+# define OP_DIV			5
+# define OP_MOD			6
+# define OP_POW			7	//'^'
+# define OP_NEG			8	//unary minus
+# define OP_NOT			9	//'~'
+# define OP_AND			10
+# define OP_OR			11
+# define OP_SHL			12
+# define OP_SHR			13
+# define OP_LT			14
+# define OP_LE			15
+# define OP_GT			16
+# define OP_GE			17
+# define OP_EQ			18
+# define OP_NE			19
+# define OP_ABS			20	//abs(x)
+# define OP_MIN			21	//min(x, y)
+# define OP_MAX			22	//max(x, y)
+# define OP_SQRT		23	//sqrt(x)
+# define OP_POWCALL		24	//pow(x, y), the same op as '^'
+# define OP_XOR			25	//xor(x, y), since '^' already is exponentiation
+# define OP_COUNT		26	//one past the last opcode
+# define OP_SYMBOL		6	//longest operator symbol or function name, with its NUL
+# define OP_ARITY(op)	(calc_ops[(op)].arity)	//operands an opcode takes
+# define NOTATION_INFIX		1	//how an operator is written: between its operands
+# define NOTATION_PREFIX	2	//in front of its operand
+# define NOTATION_CALL		3	//as a function call, its symbol the function's name
+# define ASSOC_LEFT		0	//a-b-c is (a-b)-c
+# define ASSOC_RIGHT	1	//a^b^c is a^(b^c)
+# define IDENTITY_LEFT	1	//the operator's unit is an identity on its left: 1*x
+# define IDENTITY_RIGHT	2	//and on its right: x*1
+# define PROG_STACK		64	//operand stack depth prog_eval() handles without allocating
+# define JIT_REGS		9	//operand stack depth jit_compile() can keep in registers
+
+# define TOKEN_END		0	//token kinds produced by lex_next(): the end of the input
+# define TOKEN_NUMBER	1	//a number, its value converted into the numeric mode
+# define TOKEN_VARIABLE	2	//a variable 'a' to 'z', its value the variable index
+# define TOKEN_OPERATOR	3	//a binary operator, its value the operator's opcode
+# define TOKEN_PREFIX	4	//a prefix operator such as a unary minus, its value the operator's opcode
+# define TOKEN_LPAREN	5	//a left parenthesis
+# define TOKEN_RPAREN	6	//a right parenthesis
+# define TOKEN_FUNCTION	7	//a function name such as "abs", its value the function's opcode
+# define TOKEN_COMMA	8	//a comma between function arguments
+
+# define NODE_DEAD		0	//AST node kinds: a node that ast_fold() merged into its parent
+# define NODE_NUMBER	1	//a constant, its value the number
+# define NODE_VARIABLE	2	//a variable, its value the variable index
+# define NODE_OP		3	//an operator or function applied to the nodes lhs (and rhs)
+# define PARSE_DEPTH	256	//deepest nesting of parentheses, calls, prefix operators and '^' chains ast_parse() accepts
+
+# define KARATSUBA_LIMBS	32	//operands shorter than this are multiplied the schoolbook way
+# define LIMB_BITS			32	//bits per bignum limb
+# define LIMB_DECIMAL		1000000000u	//largest power of 10 that fits one limb
+# define LIMB_DIGITS		9	//decimal digits of LIMB_DECIMAL
+# define POW_BITS			(1u << 20)	//largest result op_pow() computes in bignum mode, in bits
+
+/* NUMERIC MODE
+ * The type every operand is computed in is chosen at compile time and defined
+ * in libclaytor.h, since programs using the library work with it too.
+ * Variable indices and opcodes share the value field of AST nodes and tokens
+ * with the numbers, so VALUE_INT() and VALUE_AS_INT() convert between plain
+ * integers and whichever type was chosen.
+ */
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+# define INTEGER_INT(x)		((calc_integer_t){(int64_t)(x), NULL})
+# define INTEGER_IS(i, x)	(((i).big == NULL) && ((i).small == (x)))
+# define INTEGER_NEGATIVE(i)	(((i).big != NULL)? (i).big->negative : ((i).small < 0))
+# define VALUE_OWNS_MEMORY	REF_ACTIVATE
+# endif
+# if defined(CALC_MODE_RATIONAL)
+# define VALUE_INT(x)		((calc_value_t){INTEGER_INT(x), INTEGER_INT(1)})
+# define VALUE_AS_INT(v)	((v).num.small)
+# define VALUE_IS(v, x)		(INTEGER_IS((v).den, 1) && INTEGER_IS((v).num, (x)))
+# elif defined(CALC_MODE_BIGNUM)
+# define VALUE_INT(x)		INTEGER_INT(x)
+# define VALUE_AS_INT(v)	((v).small)
+# define VALUE_IS(v, x)		INTEGER_IS((v), (x))
+# define value_release(v)	bignum_release(v)	//a value is a single integer
+# define value_copy(src, dest)	bignum_copy((src), (dest))
+# else
+# define VALUE_INT(x)		((calc_value_t)(x))
+# define VALUE_AS_INT(v)	((int64_t)(v))
+# define VALUE_IS(v, x)		((v) == (x))
+# define VALUE_OWNS_MEMORY	REF_INACTIVE
+# define value_release(v)	((void)(v))	//only bignums own memory
+# define value_copy(src, dest)	((*(dest) = (src)), CALC_OK)
+# endif
 
 /* STRUCTS */
-typedef struct calc_stack
+typedef struct calc_token
+{
+	/* One token of an expression, as produced by lex_next(): what kind of
+	 * token it is, which slice of the source it was read from (offset and
+	 * length, the source itself is never copied or modified) and its value.
+	 * A number token owns its value (which matters for bignums) until the
+	 * value is moved into an AST node.
+	 */
+	uint8_t kind;
+	size_t offset;
+	size_t length;
+	calc_value_t value;
+} calc_token_t;
+
+typedef struct calc_node
+{
+	/* One node of an expression's AST: a NODE_NUMBER or NODE_VARIABLE leaf,
+	 * or a NODE_OP that applies opcode (one of the OP_ opcodes of the
+	 * operators and functions) to the node lhs and, if the opcode takes
+	 * two operands, rhs. Children are indices into the same arena rather
+	 * than pointers. A number node owns its value.
+	 */
+	uint8_t kind;
+	uint8_t opcode;
+	uint32_t lhs;
+	uint32_t rhs;
+	calc_value_t value;
+} calc_node_t;
+
+typedef struct calc_ast
+{
+	/* An expression parsed by ast_parse(): its nodes in one contiguous
+	 * arena, every node stored after its children, so the root is always the
+	 * last node and the arena read front to back is the expression in
+	 * POSTFIX order. error_offset is where in the source parsing failed.
+	 * ASTs are released with ast_free().
+	 */
+	calc_node_t *nodes;
+	uint32_t len;
+	uint32_t cap;
+	size_t error_offset;
+} calc_ast_t;
+
+//an operator's function: unary operators ignore rhs
+typedef uint8_t (*calc_kernel_t)(calc_value_t lhs, calc_value_t rhs, calc_value_t *result);
+
+typedef struct calc_op
+{
+	/* One entry of the operator registry, calc_ops[], indexed by opcode: how
+	 * the operator is written (its symbol or function name and NOTATION_),
+	 * how many operands it takes, how tightly it binds them (precedence, the
+	 * higher the tighter) and which way it associates, which of its sides
+	 * unit is an identity on (IDENTITY_ flags, used by ast_fold()) and the
+	 * kernel that computes it.
+	 */
+	char symbol[OP_SYMBOL];
+	uint8_t notation;
+	uint8_t arity;
+	uint8_t precedence;
+	uint8_t assoc;
+	uint8_t identity;
+	int8_t unit;
+	calc_kernel_t kernel;
+} calc_op_t;
+
+typedef struct claytor_opts
+{
+	/* The runtime options of the program, set by parse_args() from whatever
+	 * arguments were passed to main(). A NULL batch_path means the calculator
+	 * runs interactively, otherwise every line of the named file (or of stdin
+	 * if the path is "-") is evaluated as its own expression by u_threads
+	 * batch workers. If column_path is set, column_expr is instead evaluated
+	 * once for every row of that file, and the results are written to
+	 * output_path (stdout if NULL), through native code if u_jit is set.
+	 * Interactively, up to u_cache expressions are remembered along with
+	 * their results (0 turns the cache off.) If socket_path is set, the
+	 * program instead serves expressions over a Unix domain socket.
+	 */
+	char *batch_path;
+	char *column_path;
+	char *column_expr;
+	char *output_path;
+	char *socket_path;
+	uint16_t u_threads;
+	uint8_t u_jit;
+	uint32_t u_cache;
+} claytor_opts_t;
+
+typedef struct calc_instr
+{
+	/* One instruction of a compiled expression: either INSTR_PUSH, which
+	 * pushes its constant onto the operand stack, INSTR_VAR, which pushes the
+	 * variable its value indexes, or the opcode of an operator or function,
+	 * which replaces the top one or two operands (see OP_ARITY()) with its
+	 * result.
+	 */
+	uint8_t opcode;
+	calc_value_t value;
+} calc_instr_t;
+
+typedef struct calc_prog
+{
+	/* A compiled expression: its instructions in POSTFIX order, so evaluating
+	 * it is a single forward pass with an operand stack, plus the deepest that
+	 * stack ever gets. Programs own their constants (which matters for
+	 * bignums) and are released with prog_free().
+	 */
+	calc_instr_t *code;
+	uint32_t len;
+	uint32_t depth;
+} calc_prog_t;
+
+struct claytor_expr
+{
+	/* An expression compiled by claytor_compile(), which programs using the
+	 * library only ever see as an opaque claytor_expr_t. It is just the
+	 * program, but keeping it behind a pointer leaves room to add to it.
+	 */
+	calc_prog_t prog;
+};
+
+typedef uint8_t (*calc_jit_fn_t)(calc_value_t *const *columns, size_t row, calc_value_t *result);
+
+typedef struct calc_jit
+{
+	/* A program translated into native code by jit_compile(): fn evaluates it
+	 * for one row of a set of columns (see col_table_t) and returns a status
+	 * like prog_eval() does. code and size describe the executable mapping
+	 * fn lives in, which jit_free() unmaps.
+	 */
+	calc_jit_fn_t fn;
+	void *code;
+	size_t size;
+} calc_jit_t;
+
+typedef struct cache_entry
+{
+	/* One expression remembered by the interactive cache: its normalized
+	 * text (see cache_normalize()) and that text's hash, the program it
+	 * compiled into, and the status and result of evaluating it. prev and
+	 * next link the entries from the most to the least recently used, chain
+	 * links the entries that share a hash bucket. A NULL key marks an unused
+	 * entry.
+	 */
+	char *key;
+	uint64_t hash;
+	uint32_t prev;
+	uint32_t next;
+	uint32_t chain;
+	calc_prog_t prog;
+	uint8_t status;
+	calc_value_t result;
+} cache_entry_t;
+
+typedef struct calc_cache
+{
+	/* The interactive cache, a hash table of at most capacity entries. The
+	 * entries live in one array allocated up front, so the cache never
+	 * allocates anything but the keys once it is running; buckets holds the
+	 * first entry of every hash chain (n_buckets is a power of two.) head and
+	 * tail are the most and the least recently used entries, the one evicted
+	 * once the cache is full. hits and misses count every lookup.
+	 */
+	cache_entry_t *entries;
+	uint32_t *buckets;
+	uint32_t n_buckets;
+	uint32_t capacity;
+	uint32_t len;
+	uint32_t head;
+	uint32_t tail;
+	uint64_t hits;
+	uint64_t misses;
+} calc_cache_t;
+
+typedef struct calc_sheet
+{
+	/* The formulas of the interactive mode, one per variable that was
+	 * assigned one (a = 2, c = a + b), stored variable by variable like the
+	 * columns of col_table_t, so that values is exactly the vars array
+	 * prog_eval() expects. Sets of variables are bitmasks (see VAR_BIT()):
+	 * reads holds the variables every formula reads and users the formulas
+	 * reading every variable, defined the variables that have a formula and
+	 * dirty the formulas that have to be evaluated again. order lists the
+	 * n_order formulas so that every one comes after the formulas it reads,
+	 * and status and values hold the outcome of their last evaluation.
+	 * evaluations counts every formula ever evaluated.
+	 */
+	calc_prog_t formulas[CALC_VARS];
+	calc_value_t values[CALC_VARS];
+	uint8_t status[CALC_VARS];
+	uint32_t reads[CALC_VARS];
+	uint32_t users[CALC_VARS];
+	uint8_t order[CALC_VARS];
+	uint8_t n_order;
+	uint32_t defined;
+	uint32_t dirty;
+	uint64_t evaluations;
+} calc_sheet_t;
+
+typedef struct batch_chunk
+{
+	/* One chunk of a batch run: a growable text arena that a single worker
+	 * formats the results of its lines into. Every chunk covers BATCH_CHUNK
+	 * consecutive input lines, so writing the chunks out one after the other
+	 * reproduces the input order regardless of which worker finished first.
+	 */
+	char *text;
+	size_t len;
+	size_t cap;
+} batch_chunk_t;
+
+typedef struct batch_ctx
+{
+	/* The state shared between batch workers. Lines are read in once and are
+	 * only ever read by the workers; chunks are only ever written by the one
+	 * worker that claimed them through next_chunk, so the atomic counter is
+	 * the only point of contention between threads.
+	 */
+	char **lines;
+	size_t n_lines;
+	batch_chunk_t *chunks;
+	size_t n_chunks;
+	atomic_size_t next_chunk;
+} batch_ctx_t;
+
+typedef struct col_table
+{
+	/* The input of column mode, stored column by column so that every block
+	 * of rows is a contiguous slice of each column. columns is indexed by
+	 * variable and is NULL for variables the input doesn't have. status holds
+	 * one entry per row: CALC_OK, or the reason the row couldn't be read
+	 * (which then sticks, since an evaluation only ever records its first
+	 * error.)
+	 */
+	calc_value_t *columns[CALC_VARS];
+	uint8_t *status;
+	size_t n_rows;
+} col_table_t;
+
+typedef struct serve_conn
+{
+	/* One client of the server. Requests are read into in, which holds
+	 * in_len bytes of lines that haven't been answered yet. Responses are
+	 * queued in the ring out: out_head counts every byte ever queued and
+	 * out_tail every byte sent, so the ring holds out_head - out_tail bytes
+	 * starting at out_tail % SERVE_RING. A response too long for the ring (a
+	 * bignum) is held in big instead, and goes out after everything queued
+	 * before it. closing is set once the client has finished sending,
+	 * discarding while the rest of an overlong line is skipped, and events
+	 * is what the connection is registered for with epoll. Every open
+	 * connection is linked into the server's list.
+	 */
+	int fd;
+	uint8_t closing;
+	uint8_t discarding;
+	uint32_t events;
+	size_t in_len;
+	uint64_t out_head;
+	uint64_t out_tail;
+	char *big;
+	size_t big_len;
+	size_t big_sent;
+	struct serve_conn *prev;
+	struct serve_conn *next;
+	char in[SERVE_INPUT];
+	char out[SERVE_RING];
+} serve_conn_t;
+
+typedef struct serve_ctx
 {
-	/* Every element of our calculator stack is intended to hold a value, either
-	 * an operand or an operator with the type_flag being set appropriately, a
-	 * precedence value for operators (which affects calculation order) and a
-	 * pointer to the next element on the stack (which reinforces calculation
-	 * order.)
+	/* The state of the server: its epoll instance, the listening socket,
+	 * the signalfd that reports SIGINT and SIGTERM, and the list of open
+	 * connections. The counters are reported when the server shuts down.
 	 */
-	enum {f_operator, f_operand} type_flag;
-	int32_t value;
-	int16_t precedence;
-	struct calc_stack *next;
-} calc_stack_t;
+	int epoll_fd;
+	int listen_fd;
+	int signal_fd;
+	serve_conn_t *conns;
+	uint64_t n_accepted;
+	uint64_t n_requests;
+} serve_ctx_t;
+
+/* GLOBAL VARIABLES */
+//defined in claytor.c
+extern claytor_opts_t claytor_opts_g;
+//defined in math_registry.c
+extern const calc_op_t calc_ops[OP_COUNT];
 
 /* USERDEF FUNCTION PROTOTYPES */
 //misc functions
-calc_stack_t *parse_array(char *src_array);
-char *get_input(char *dest_array, int n);
-char *trim(char *src_array);
+uint8_t lex_next(const char *src_array, size_t *offset, uint8_t prev_kind, calc_token_t *token);
+ssize_t get_input(char **line, size_t *cap);
+uint8_t value_parse(const char *src_array, char **end_ptr, calc_value_t *value);
+int value_format(calc_value_t value, char *dest_array, size_t size);
+const char *calc_strerror(uint8_t status);
+char *value_string(calc_value_t value, char *scratch, size_t size);
+void parse_args(int argc, char **argv);
+void usage(void);
 
 //math functions
-int32_t op_add(int32_t augend, int32_t addend);
-int32_t op_sub(int32_t minuend, int32_t subtrahend);
-int32_t op_mul(int32_t multiplier, int32_t multiplicand);
-int32_t op_div(int32_t dividend, int32_t divisor);
-int32_t get_result(calc_stack_t *stack_head);
-uint8_t u_isoperator(char test_var);
-
-//stack functions
-void stack_print(calc_stack_t *stack_head);
-void stack_destroy(calc_stack_t *stack_head);
-calc_stack_t *push(calc_stack_t *stack_head, int32_t value, uint8_t int_flag);
-int32_t pop(calc_stack_t **stack_head);
+uint8_t op_add(calc_value_t augend, calc_value_t addend, calc_value_t *sum);
+uint8_t op_sub(calc_value_t minuend, calc_value_t subtrahend, calc_value_t *diff);
+uint8_t op_mul(calc_value_t multiplicand, calc_value_t multiplier, calc_value_t *prod);
+uint8_t op_div(calc_value_t dividend, calc_value_t divisor, calc_value_t *ratio);
+uint8_t op_pow(calc_value_t base, calc_value_t exponent, calc_value_t *power);
+uint8_t op_neg(calc_value_t operand, calc_value_t *negated);
+uint8_t op_abs(calc_value_t operand, calc_value_t *absolute);
+uint8_t op_min(calc_value_t operand_1, calc_value_t operand_2, calc_value_t *minimum);
+uint8_t op_max(calc_value_t operand_1, calc_value_t operand_2, calc_value_t *maximum);
+uint8_t op_mod(calc_value_t dividend, calc_value_t divisor, calc_value_t *remainder);
+uint8_t op_sqrt(calc_value_t operand, calc_value_t *root);
+uint8_t op_bitwise(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result);
+uint8_t op_shift(uint8_t opcode, calc_value_t operand, calc_value_t places, calc_value_t *shifted);
+uint8_t op_relation(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result);
+uint8_t op_apply(uint8_t opcode, calc_value_t lhs, calc_value_t rhs, calc_value_t *result);
+int value_cmp(calc_value_t operand_1, calc_value_t operand_2);
+
+//AST functions
+uint8_t ast_parse(const char *src_array, calc_ast_t *ast);
+void ast_fold(calc_ast_t *ast);
+uint8_t ast_eval(const calc_ast_t *ast, const calc_value_t *vars, calc_value_t *result);
+void ast_free(calc_ast_t *ast);
+
+//bignum functions
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+calc_bignum_t *bignum_alloc(uint32_t cap);
+void bignum_release(calc_integer_t *integer);
+uint8_t bignum_copy(calc_integer_t src, calc_integer_t *dest);
+calc_integer_t bignum_normalize(calc_bignum_t *big);
+void bignum_view(const calc_integer_t *value, uint32_t scratch[2], const uint32_t **limbs, uint32_t *len, uint8_t *negative);
+int bignum_cmp(const uint32_t *a_limbs, uint32_t a_len, const uint32_t *b_limbs, uint32_t b_len);
+uint8_t bignum_addsub(calc_integer_t augend, calc_integer_t addend, uint8_t negate_addend, calc_integer_t *sum);
+uint8_t bignum_mul_limbs(uint32_t *prod, const uint32_t *a_limbs, uint32_t a_len, const uint32_t *b_limbs, uint32_t b_len);
+uint8_t bignum_mul(calc_integer_t multiplicand, calc_integer_t multiplier, calc_integer_t *prod);
+uint8_t bignum_divmod(calc_integer_t dividend, calc_integer_t divisor, calc_integer_t *quotient, calc_integer_t *remainder);
+uint8_t bignum_gcd(calc_integer_t integer_1, calc_integer_t integer_2, calc_integer_t *gcd);
+uint8_t bignum_isqrt(calc_integer_t square, calc_integer_t *root);
+uint8_t bignum_parse(const char *src_array, char **end_ptr, calc_integer_t *value);
+int bignum_format(calc_integer_t value, char *dest_array, size_t size);
+# endif
+
+//rational functions
+# if defined(CALC_MODE_RATIONAL)
+void value_release(calc_value_t *value);
+uint8_t value_copy(calc_value_t src, calc_value_t *dest);
+uint64_t rational_gcd(uint64_t magnitude_1, uint64_t magnitude_2);
+uint8_t rational_make(calc_integer_t num, calc_integer_t den, calc_value_t *value);
+uint8_t rational_addsub(calc_value_t augend, calc_value_t addend, uint8_t negate_addend, calc_value_t *sum);
+uint8_t rational_muldiv(calc_value_t multiplicand, calc_value_t multiplier, uint8_t invert_multiplier, calc_value_t *prod);
+uint8_t rational_trunc(calc_value_t value, uint8_t round_down, calc_value_t *integer);
+uint8_t rational_parse(const char *src_array, char **end_ptr, calc_value_t *value);
+int rational_format(calc_value_t value, char *dest_array, size_t size);
+# endif
+
+//compiled expression functions
+uint8_t prog_compile(const calc_ast_t *ast, calc_prog_t *prog);
+uint8_t prog_eval(const calc_prog_t *prog, const calc_value_t *vars, calc_value_t *result);
+uint32_t prog_reads(const calc_prog_t *prog);
+void prog_free(calc_prog_t *prog);
+
+//jit functions
+uint8_t jit_compile(const calc_prog_t *prog, calc_jit_t *jit);
+void jit_free(calc_jit_t *jit);
+
+//cache functions
+uint8_t cache_init(calc_cache_t *cache, uint32_t capacity);
+void cache_normalize(const char *src_array, char *dest_array);
+uint64_t cache_hash(const char *key);
+void cache_touch(calc_cache_t *cache, uint32_t index);
+const cache_entry_t *cache_lookup(calc_cache_t *cache, const char *key);
+const cache_entry_t *cache_insert(calc_cache_t *cache, const char *key, calc_prog_t *prog, uint8_t status, calc_value_t *result);
+void cache_free(calc_cache_t *cache);
+
+//sheet functions
+void sheet_init(calc_sheet_t *sheet);
+uint8_t sheet_define(calc_sheet_t *sheet, uint8_t var, const char *src_array, size_t *error_offset);
+uint8_t sheet_order(calc_sheet_t *sheet);
+uint32_t sheet_recalc(calc_sheet_t *sheet);
+uint8_t sheet_eval(const calc_sheet_t *sheet, const calc_prog_t *prog, uint32_t reads, calc_value_t *result);
+void sheet_free(calc_sheet_t *sheet);
+
+//batch functions
+int batch_run(const char *src_path, uint16_t u_threads);
+char **batch_readlines(FILE *src_file, char **buffer, size_t *n_lines);
+void batch_append(batch_chunk_t *chunk, const char *text, size_t len);
+void *batch_worker(void *ctx);
+
+//column functions
+int col_run(const claytor_opts_t *opts);
+uint8_t col_readcsv(FILE *src_file, col_table_t *table);
+uint8_t col_readbin(FILE *src_file, uint8_t n_cols, col_table_t *table);
+uint8_t col_eval(const calc_prog_t *prog, const calc_jit_t *jit, col_table_t *table, calc_value_t *results);
+void col_op(uint8_t opcode, const calc_value_t *lhs, const calc_value_t *rhs, calc_value_t *out, uint8_t *status, size_t count);
+void col_write(FILE *dest_file, uint8_t binary, const col_table_t *table, const calc_value_t *results);
+void col_free(col_table_t *table);
+
+//server functions
+int serve_run(const char *socket_path);
+int serve_listen(const char *socket_path);
+void serve_accept(serve_ctx_t *server);
+void serve_respond(serve_ctx_t *server, serve_conn_t *conn, char *line);
+int serve_flush(serve_conn_t *conn);
+uint8_t serve_handle(serve_ctx_t *server, serve_conn_t *conn, uint32_t events);
+void serve_close(serve_ctx_t *server, serve_conn_t *conn);
+
+//benchmark functions
+size_t bench_gen(uint64_t *seed, uint8_t depth, uint8_t use_vars, char *dest_array, size_t size);
 
 # endif /* CLAYTOR_H_ */
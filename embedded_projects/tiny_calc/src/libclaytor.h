@@ -0,0 +1,107 @@
+# ifndef LIBCLAYTOR_H_
+# define LIBCLAYTOR_H_
+
+/* The interface of libclaytor, the calculator as a library ("make libclaytor"
+ * builds src/libclaytor.a and src/libclaytor.so.) An expression is compiled
+ * once by claytor_compile() and can then be evaluated any number of times by
+ * claytor_eval(), with its variables 'a' to 'z' bound to whatever values are
+ * passed in. The library has no global state and never exits or prints: every
+ * function reports its outcome through a CALC_ status, which claytor_strerror()
+ * describes. Every function is reentrant, and a compiled expression is only
+ * ever read by claytor_eval(), so any number of threads can evaluate the same
+ * expression at once.
+ * The library is built for one numeric mode (see NUMERIC MODE below), and a
+ * program using it has to be compiled with the same CALC_MODE_ definition.
+ */
+
+/* DEFINITIONS AND INCLUSIONS */
+# include <stddef.h>	//size_t
+# include <stdint.h>	//uints
+
+# define CALC_VARS		26	//variables 'a' to 'z'
+
+# define CALC_OK		0	//returned by math functions when a result was computed
+# define CALC_EOVERFLOW	1	//returned when a result does not fit the numeric mode
+# define CALC_EDIVZERO	2	//returned when a division by zero was requested
+# define CALC_ENOMEM	3	//returned when a bignum could not be allocated
+# define CALC_ESYNTAX	4	//returned for a malformed expression
+# define CALC_EUNBOUND	5	//returned when an expression uses a variable that has no value
+# define CALC_EUNSUPPORTED	6	//returned by jit_compile() for programs it can't translate
+# define CALC_EDOMAIN	7	//returned when an op is undefined for its operands, e.g. (-8)^0.5
+# define CALC_ECYCLE		8	//returned when a formula would depend on itself, e.g. a = b + 1 with b = a
+
+# define CLAYTOR_API	__attribute__((visibility("default")))	//what libclaytor.so exports
+
+/* NUMERIC MODE
+ * The type every operand is computed in is chosen at compile time, either by
+ * "make MODE=INT64" (the default), "make MODE=INT128", "make MODE=DOUBLE",
+ * "make MODE=BIGNUM" or "make MODE=RATIONAL". Only one of the branches below
+ * is ever compiled, so the math functions are specialised for a single type
+ * and evaluation never dispatches on types.
+ */
+# if defined(CALC_MODE_BIGNUM) || defined(CALC_MODE_RATIONAL)
+typedef struct calc_bignum
+{
+	/* The heap part of an arbitrary-precision integer: its magnitude stored
+	 * as 32 bit limbs, least significant first, without leading zero limbs.
+	 */
+	uint32_t len;
+	uint32_t cap;
+	uint8_t negative;
+	uint32_t limbs[];
+} calc_bignum_t;
+
+typedef struct calc_integer
+{
+	/* An arbitrary-precision integer. As long as it fits into 64 bits it lives
+	 * entirely in small and big is NULL, so small values are never allocated
+	 * and take the same checked fast path as INT64 mode. Only once a result
+	 * outgrows small is it promoted to a calc_bignum_t, and it is demoted back
+	 * as soon as it fits again. An integer owns its bignum: copies of it must
+	 * only be released once, through value_release() (claytor_release()
+	 * outside.)
+	 */
+	int64_t small;
+	calc_bignum_t *big;
+} calc_integer_t;
+
+#  if defined(CALC_MODE_RATIONAL)
+typedef struct calc_value
+{
+	/* A rational mode value: an exact fraction, always kept in lowest terms
+	 * with a positive denominator, so every number has exactly one
+	 * representation (integers have a denominator of 1.) Both parts are
+	 * bignum integers, so fractions whose parts fit into 64 bits never
+	 * allocate.
+	 */
+	calc_integer_t num;
+	calc_integer_t den;
+} calc_value_t;
+#  else
+typedef calc_integer_t calc_value_t;	//a bignum mode value
+#  endif
+# elif defined(CALC_MODE_INT128)
+__extension__ typedef __int128 calc_value_t;
+# elif defined(CALC_MODE_DOUBLE)
+typedef double calc_value_t;
+# else
+# ifndef CALC_MODE_INT64
+# define CALC_MODE_INT64
+# endif
+typedef int64_t calc_value_t;
+# endif
+
+/* STRUCTS */
+//a compiled expression, only ever handled through a pointer (see claytor.h)
+typedef struct claytor_expr claytor_expr_t;
+
+/* LIBRARY FUNCTION PROTOTYPES */
+CLAYTOR_API uint8_t claytor_compile(const char *src_array, claytor_expr_t **expr, size_t *error_offset);
+CLAYTOR_API uint8_t claytor_eval(const claytor_expr_t *expr, const calc_value_t *vars, calc_value_t *result);
+CLAYTOR_API void claytor_free(claytor_expr_t *expr);
+CLAYTOR_API uint8_t claytor_parse(const char *src_array, calc_value_t *value);
+CLAYTOR_API int claytor_format(calc_value_t value, char *dest_array, size_t size);
+CLAYTOR_API void claytor_release(calc_value_t *value);
+CLAYTOR_API const char *claytor_strerror(uint8_t status);
+
+# endif /* LIBCLAYTOR_H_ */